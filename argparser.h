@@ -158,17 +158,32 @@
 // [SECTION] Header mess
 //-----------------------------------------------------------------------------
 
+#include <errno.h> // for ERANGE
+#include <math.h>  // for isfinite, HUGE_VAL
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h> // for offsetof
+#include <stdint.h> // for uint32_t
 #include <stdio.h>  // for printf
 #include <stdlib.h> // for realloc
 #include <string.h> // for strdup strlen
 
 #ifdef __cplusplus
 
+#include <cstdint>
 #include <exception>
+#include <initializer_list>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+#include <coroutine> // for argparser::Matches
+#include <iterator>  // for std::default_sentinel_t
+#endif
 
 #endif //__cplusplus
 
@@ -207,6 +222,42 @@
 	#endif
 #endif
 
+/**
+ * @def ARGPARSER_MALLOC
+ * @brief Allocator used for every block the library requests from the system.
+ */
+#ifndef ARGPARSER_MALLOC
+	#define ARGPARSER_MALLOC(size) malloc(size)
+#endif
+
+/**
+ * @def ARGPARSER_FREE
+ * @brief Deallocator matching ARGPARSER_MALLOC.
+ */
+#ifndef ARGPARSER_FREE
+	#define ARGPARSER_FREE(ptr) free(ptr)
+#endif
+
+/**
+ * @def ARGPARSER_ARENA_BLOCK_SIZE
+ * @brief Size in bytes of the first block of a parser arena, later blocks double.
+ */
+#ifndef ARGPARSER_ARENA_BLOCK_SIZE
+	#define ARGPARSER_ARENA_BLOCK_SIZE 4096
+#endif
+
+/**
+ * @def ARGPARSER_DISABLE_SIMD
+ * @brief Define it to scan tokens byte by byte instead of with SSE2, AVX2 or NEON.
+ */
+
+/**
+ * @def ARGPARSER_ENABLE_STATS
+ * @brief Define it in every translation unit to count and time each parse.
+ * @details The counters land in ArgumentResult_t::stats and are passed to
+ * ArgumentParser_t::on_stats. Left undefined, the hooks compile to nothing.
+ */
+
 #define ARGPARSER_SUCCESS 1
 #define ARGPARSER_FAILURE 0
 
@@ -486,6 +537,13 @@
   #define ARGPARSER_CPP_VERSION 0
 #endif
 
+/** C++20 coroutines, for argparser::matches() */
+#if ARGPARSER_CPP_VERSION >= 202002L && defined(__cpp_impl_coroutine)
+	#define ARGPARSER_HAS_COROUTINES 1
+#else
+	#define ARGPARSER_HAS_COROUTINES 0
+#endif
+
 /** compiler builtin check */
 #ifndef ARGPARSER_HAS_BUILTIN
 	#ifdef __has_builtin
@@ -697,6 +755,18 @@ typedef enum Nargs
     ZERO_OR_MORE,
 } Nargs;
 
+/**
+ * @def ARGPARSER_NARGS
+ * @brief Encodes a @ref Nargs pattern as the @c nargs parameter of argparser_add_argument().
+ */
+#define ARGPARSER_NARGS(pattern) (-1 - (int)(pattern))
+
+/**
+ * @def ARGPARSER_NARGS_UNBOUNDED
+ * @brief Value of @c narg_max for arguments that take any number of values.
+ */
+#define ARGPARSER_NARGS_UNBOUNDED ((size_t)-1)
+
 /**
  * @enum ArgumentErrorType
  * @brief Represents the type of an argument error.
@@ -708,6 +778,7 @@ typedef enum ArgumentErrorType
      * @{
      */
 
+    NONE = -2,  /**< No error, returned by argparser_try_parse() on success */
     UKNOWN = -1,
     MAP,        /**< Errors in map lookups */
     HELP,       /**< An exception that indicates that the user has requested help */
@@ -717,6 +788,7 @@ typedef enum ArgumentErrorType
     REQUIRED,   /**< Errors that when a required flag is omitted */
     VALIDATION, /**< Errors that are detected from group validation after parsing finishes */
     COMPLETION, /**< An exception that contains autocompletion reply */
+    VERSION,    /**< An exception that indicates that the user has requested the version */
 
     /** @} */
 
@@ -737,8 +809,125 @@ typedef struct ArgumentError_t
     ArgumentErrorType type; /**< ArgumentType of error. */
     char *message;          /**< Error message string. */
     char *argument;         /**< The Argument related to error. */
+    bool is_borrowed;       /**< Whether it lives in a result arena or caller buffer, so never freed. */
 } ArgumentError_t;
 
+/**
+ * @def ARGPARSER_ERROR_BUFFER_SIZE
+ * @brief Room for the argument and message of an ArgumentErrorBuffer_t.
+ */
+#ifndef ARGPARSER_ERROR_BUFFER_SIZE
+	#define ARGPARSER_ERROR_BUFFER_SIZE 256
+#endif
+
+/**
+ * @struct ArgumentErrorBuffer_t
+ * @brief Caller-owned storage for an error, filled without allocating.
+ */
+typedef struct ArgumentErrorBuffer_t
+{
+    ArgumentError_t error;                  /**< The error, its strings point into text. */
+    char text[ARGPARSER_ERROR_BUFFER_SIZE]; /**< The argument then the message, truncated to fit. */
+} ArgumentErrorBuffer_t;
+
+/** @} */
+
+/**
+ * @enum ArgumentValueType
+ * @brief The type an argument's values are converted to while parsing.
+ */
+typedef enum ArgumentValueType
+{
+    VALUE_STRING,      /**< Kept as a string view, the default. */
+    VALUE_INT,         /**< A signed 64-bit decimal integer. */
+    VALUE_DOUBLE,      /**< A floating point number. */
+    VALUE_BOOL,        /**< One of true/false, yes/no, on/off or 1/0. */
+    VALUE_ENUM,        /**< The index of one of the argument's choices. */
+    VALUE_INT_LIST,    /**< Separated signed 64-bit integers, as "1,2,3". */
+    VALUE_DOUBLE_LIST, /**< Separated floating point numbers, as "0.5,1.5". */
+} ArgumentValueType;
+
+/**
+ * @name ArgumentView_t data type
+ * @{
+ */
+
+/**
+ * @struct ArgumentView_t
+ * @brief A non-owning, NUL-terminated slice holding one value of an argument.
+ * @details Points into the parser's values arena, or straight into argv when
+ * the parser is in zero-copy mode.
+ */
+typedef struct ArgumentView_t
+{
+    const char *data; /**< First character of the value. */
+    size_t size;      /**< Length of the value, not counting the terminator. */
+} ArgumentView_t;
+
+/** @} */
+
+/**
+ * @name ArgumentList_t data type
+ * @{
+ */
+
+/**
+ * @struct ArgumentList_t
+ * @brief The contiguous elements of a VALUE_INT_LIST or VALUE_DOUBLE_LIST.
+ * @details Allocated in the arena of the result, or of the parser for a default.
+ */
+typedef struct ArgumentList_t
+{
+    union
+    {
+        int64_t *ints;   /**< VALUE_INT_LIST elements. */
+        double *doubles; /**< VALUE_DOUBLE_LIST elements. */
+    };
+    size_t count; /**< Number of elements. */
+} ArgumentList_t;
+
+/** @} */
+
+/**
+ * @name ArgumentSlot_t data type
+ * @{
+ */
+
+/**
+ * @struct ArgumentSlot_t
+ * @brief A converted value, tagged with its type.
+ */
+typedef struct ArgumentSlot_t
+{
+    ArgumentValueType type; /**< Which member of the union is set. */
+    union
+    {
+        int64_t i;           /**< VALUE_INT value. */
+        double d;            /**< VALUE_DOUBLE value. */
+        bool b;              /**< VALUE_BOOL value. */
+        int choice;          /**< VALUE_ENUM index into the choices. */
+        ArgumentView_t str;  /**< VALUE_STRING value. */
+        ArgumentList_t list; /**< VALUE_INT_LIST and VALUE_DOUBLE_LIST elements. */
+    };
+} ArgumentSlot_t;
+
+/** @} */
+
+/**
+ * @name ArgumentCallback_t data type
+ * @{
+ */
+
+/**
+ * @typedef ArgumentCallback_t
+ * @brief Receives every value of an argument as soon as it is parsed.
+ * @details The value is only valid during the call, string values point
+ * into argv or a response file. Return ARGPARSER_FAILURE to stop parsing.
+ */
+struct Argument_t;
+
+typedef int (*ArgumentCallback_t)(const struct Argument_t *argument, const ArgumentSlot_t *value, void *user_data);
+
 /** @} */
 
 /**
@@ -766,500 +955,7180 @@ typedef struct Argument_t
     size_t narg_max;
     size_t narg_min;
 
-    union
-    {
-        void *value;   /**< The value of the argument. */
-        void **values; /**< The values of the argument if multiple. */
-    };
-
-    int occurrences; /**< Number of times the flag was provided (for count action) */
     int action_type; /**< 0=none,1=count,2=append,3=store_true,4=store_false */
 
-    int stored_count; /**< number of stored values in values[] when append used */
     bool store_count; /**< whether to store count when append used */
 
     void *implicit_value;
 
+    ArgumentValueType value_type; /**< The type every value is converted to while parsing. */
+    ArgumentSlot_t default_slot;  /**< The default value, converted. */
+    const char **choices;         /**< Allowed values of a VALUE_ENUM argument. */
+    int choice_count;             /**< The number of choices. */
+    char separator;               /**< Splits the elements of a list value, ',' when '\0'. */
+    void *store_address;          /**< Receives the value after every parse, or NULL. */
+    size_t store_offset;          /**< Offset into ArgumentResult_t::target plus one, 0 when unbound. */
+    size_t store_size;            /**< Size of the destination, which picks the width written. */
+
+    ArgumentCallback_t on_value;          /**< Streams every value, which is then not kept past the first. */
+    void *on_value_data;                  /**< User data passed to on_value. */
+    void (*on_value_release)(void *data); /**< Releases on_value_data with the parser, may be NULL. */
+
     bool is_repeatable;
     bool is_deprecated;
     bool is_optional;
     bool is_required;
     bool is_hidden;
-    bool is_used;
+    bool is_exit; /**< Ends the parse before anything is stored, see argparser_add_version(). */
+    char *env;    /**< Environment variable read when the argument is not given, see argparser_set_env(). */
+
+    ArgumentView_t config;      /**< Value from argparser_load_config(), read below argv and the environment. */
+    ArgumentSlot_t config_slot; /**< config, converted once loaded. */
+    bool is_config_converted;   /**< Whether config_slot is set. */
 
 } Argument_t;
 
 /** @} */
 
 /**
- * @name ArgumentParser_t data type
+ * @name ArgumentValue_t data type
  * @{
  */
 
 /**
- * @struct ArgumentParser_t
- * @brief Represents the Argument parser.
+ * @struct ArgumentValue_t
+ * @brief What one parse recorded for one argument.
+ * @details Kept apart from Argument_t so the arguments stay an immutable
+ * schema that any number of parses can share.
  */
-typedef struct ArgumentParser_t
+typedef struct ArgumentValue_t
 {
-    char *program;         /**< The name of the program. */
-    char *usage;           /**< The usage message. */
-    char *epilog;          /**< The epilog message. */
-    int count;             /**< The number of arguments. */
-    char *description;     /**< The description of the program. */
-    Argument_t *arguments; /**< The list of arguments. */
-    char prefix_char;      /**< The prefix character. */
-    const char *argument_default;
-    bool add_help;
-    bool allow_abbrev;
-    bool exit_on_error;
-} ArgumentParser_t;
+    union
+    {
+        ArgumentView_t value;   /**< The value of the argument. */
+        ArgumentView_t *values; /**< The values of the argument if multiple. */
+    };
 
-/** @} */
+    ArgumentSlot_t slot; /**< The first value, converted. */
+    int stored_count;    /**< Number of values stored. */
+    int occurrences;     /**< Number of times the argument was given, see ArgumentResult_t::used. */
+    bool is_pending;     /**< Whether slot is still to be converted from the views, see ArgumentParser_t::lazy_conversion. */
+    bool is_invalid;     /**< Whether that conversion failed, slot then holds the default. */
+} ArgumentValue_t;
 
 /** @} */
 
-//-----------------------------------------------------------------------------
-// [SECTION] C Only Functions
-//-----------------------------------------------------------------------------
+/**
+ * @name ArgumentIndexEntry_t data type
+ * @{
+ */
 
-#pragma region C
+/**
+ * @def ARGPARSER_INDEX_MIN_CAPACITY
+ * @brief Smallest number of slots in the name index, must be a power of two.
+ */
+#define ARGPARSER_INDEX_MIN_CAPACITY 16
 
-#ifdef __cplusplus
-extern "C"
+/**
+ * @struct ArgumentIndexEntry_t
+ * @brief A slot of the open-addressing index over argument names and dests.
+ */
+typedef struct ArgumentIndexEntry_t
 {
-#endif //__cplusplus
+    uint32_t hash; /**< Hash of the key held by this slot. */
+    int slot;      /**< Position of the argument plus one, 0 when the slot is empty. */
+    bool is_dest;  /**< Whether the key is the dest of the argument rather than its name. */
+} ArgumentIndexEntry_t;
 
-    /**
-     * Initializes an ArgumentParser instance.
-     *
-     * @param parser The ArgumentParser to initialize.
-     * @param program The name of the program.
-     * @param usage The usage message.
-     * @param description The description of the program.
-     * @param epilog The epilog message.
-     * @param add_help Whether to add a help flag automatically.
-     *
-     * Example usage:
-     * @code
-     * ArgumentParser parser;
-     * argparser_initialize(&parser, "my_program", "Usage: my_program [options]", "This is a sample program.", "Epilog message", 1);
-     * @endcode
-     */
-    ARGPARSER_API void argparser_initialize(ArgumentParser_t *, const char *, const char *, const char *, const char *);
-
-    /**
-     * Frees the memory allocated for the ArgumentParser instance.
-     *
-     * @param parser The ArgumentParser instance.
-     *
-     * Example usage:
-     * argparser_delete(parser);
-     */
-    ARGPARSER_API void argparser_delete(ArgumentParser_t *);
+/** @} */
 
-    /**
-     * Adds an argument to the argument parser.
-     *
-     * @param parser The ArgumentParser to add the argument to.
-     * @param sym The short symbol for the argument.
-     * @param name The long name for the argument.
-     * @param required Whether the argument is required.
-     * @param nargs The number of arguments expected.
-     * @param default_value The default value for the argument.
-     * @param help The help message for the argument.
-     *
-     * Example usage:
-     * argparser_add_argument(parser, 'o', "output", 1, 1, "default_output.txt", "Output file");
-     */
-    ARGPARSER_API void argparser_add_argument(ArgumentParser_t *, char, const char *, int, int, const char *, const char *);
+/**
+ * @name ArgumentPoolEntry_t data type
+ * @{
+ */
 
-    /**
-     * Parses the command-line arguments.
-     *
-     * @param parser The ArgumentParser instance.
-     * @param argc The argument count.
-     * @param argv The argument vector.
-     *
-     * Example usage:
-     * argparser_parse_args(parser, argc, argv);
-     */
-    ARGPARSER_API void argparser_parse_args(ArgumentParser_t *, int, char **);
+/**
+ * @def ARGPARSER_POOL_MIN_CAPACITY
+ * @brief Smallest number of slots in the string pool, must be a power of two.
+ */
+#define ARGPARSER_POOL_MIN_CAPACITY 32
 
-    /**
-     * Retrieves the value of an argument.
-     *
-     * @param parser The ArgumentParser instance.
-     * @param name The name of the argument.
-     * @return The value of the argument.
-     *
-     * Example usage:
-     * const char *output = argparser_get_arg(parser, "output");
-     */
-    ARGPARSER_API const char *argparser_get_arg(ArgumentParser_t *, const char *);
+/**
+ * @struct ArgumentPoolEntry_t
+ * @brief A slot of the pool interning names, dests, metavars and help texts.
+ */
+typedef struct ArgumentPoolEntry_t
+{
+    uint32_t hash;   /**< Hash of str, kept so growing the pool rehashes nothing. */
+    uint32_t length; /**< The length of str. */
+    char *str;       /**< The interned string, NULL when the slot is empty. */
+} ArgumentPoolEntry_t;
 
-    /**
-     * Prints the help message.
-     *
-     * @param parser The ArgumentParser instance.
-     * @param description Whether to print the description.
-     * @param usage Whether to print the usage.
-     * @param epilog Whether to print the epilog.
-     * @param group Whether
-     *
-     * Example usage:
-     * argparser_print_help(parser);
-     */
-    ARGPARSER_API void argparser_print_help(ArgumentParser_t *);
+/** @} */
 
-    /**
-     * @brief Constructs an exception with a specific message and error type.
-     * @param error The error.
-     * @param type The type of the error.
-     * @param message The error message.
-     * @param argument The error argument.
-     */
-    ARGPARSER_API void argparser_error_initialize(ArgumentError_t *error, ArgumentErrorType type, char *argument, char *message);
+/**
+ * @name ArgumentEnvEntry_t data type
+ * @{
+ */
 
-    /**
-     * @brief Destroy and free an ArgumentError_t.
-     * @param error The ArgumentError_t to destory.
-     */
-    ARGPARSER_API void argparser_error_delete(ArgumentError_t *error);
+/**
+ * @struct ArgumentEnvEntry_t
+ * @brief A slot of the open-addressing table over environment variable names.
+ */
+typedef struct ArgumentEnvEntry_t
+{
+    uint32_t hash;    /**< Hash of name, as in the name index. */
+    int slot;         /**< Position of the argument plus one, 0 when the slot is empty. */
+    const char *name; /**< The variable, owned by the argument or the table. */
+    size_t length;    /**< The length of name. */
+} ArgumentEnvEntry_t;
 
-    /**
-     * @brief Gets the error argument.
-     * @param[in] error The error.
-     * @return The error argument.
-     */
-    ARGPARSER_API const char *argparser_error_arg(ArgumentError_t *error);
+/** @} */
 
-    /**
-     * @brief Gets the error message.
-     * @param[in] error The error.
-     * @return The error message.
-     */
-    ARGPARSER_API const char *argparser_error_what(ArgumentError_t *error);
+/**
+ * @name ArgumentTrieNode_t data type
+ * @{
+ */
 
-    /**
-     * @brief Gets the error type.
-     * @param[in] error The error.
-     * @return The error type.
-     */
-    ARGPARSER_API ArgumentErrorType argparser_error_type(ArgumentError_t *error);
+/**
+ * @struct ArgumentTrieNode_t
+ * @brief A node of the prefix trie over long option names, stored in one array.
+ * @details Children are chained through @c sibling in character order, so a
+ * walk visits names sorted. Node 0 is the root.
+ */
+typedef struct ArgumentTrieNode_t
+{
+    int child;   /**< The first child, 0 when there is none. */
+    int sibling; /**< The next child of the same parent, 0 when there is none. */
+    int slot;    /**< Position of the argument whose name ends here, or -1. */
+    int first;   /**< Position of an argument below, the only one when count is 1. */
+    int count;   /**< Number of names ending at or below this node. */
+    char c;      /**< The character leading to this node. */
+} ArgumentTrieNode_t;
 
-#ifdef __cplusplus
-};
-#endif //__cplusplus
+/** @} */
 
-#pragma endregion // C
+/**
+ * @name ArgumentGroup_t data type
+ * @{
+ */
+
+/**
+ * @def ARGPARSER_BITSET_WORDS
+ * @brief Number of 64-bit words in a bitset with one bit per argument.
+ */
+#define ARGPARSER_BITSET_WORDS(count) (((size_t)(count) + 63) / 64)
+
+/**
+ * @enum ArgumentGroupType
+ * @brief How the arguments of a group constrain each other.
+ */
+typedef enum ArgumentGroupType
+{
+    GROUP_EXCLUSIVE, /**< At most one of the arguments may be given. */
+    GROUP_INCLUSIVE, /**< The arguments are given all together or not at all. */
+} ArgumentGroupType;
+
+/**
+ * @struct ArgumentGroup_t
+ * @brief A group compiled to a bitmask over argument positions.
+ */
+typedef struct ArgumentGroup_t
+{
+    ArgumentGroupType type; /**< The constraint. */
+    bool is_required;       /**< Exclusive: one must be given. Inclusive: all must be given. */
+    uint64_t *mask;         /**< Bit per argument position, set for members. */
+    int words;              /**< Number of words in mask. */
+} ArgumentGroup_t;
+
+/** @} */
+
+/**
+ * @name ArgumentSubcommand_t data type
+ * @{
+ */
+
+struct ArgumentParser_t;
+
+/**
+ * @typedef ArgumentBuilder_t
+ * @brief Adds the arguments of a subcommand to its freshly initialized parser.
+ * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE to reject the subcommand.
+ */
+typedef int (*ArgumentBuilder_t)(struct ArgumentParser_t *parser, void *user_data);
+
+/**
+ * @struct ArgumentSubcommand_t
+ * @brief A subcommand, whose parser is only built once its name is parsed.
+ */
+typedef struct ArgumentSubcommand_t
+{
+    char *name;                      /**< The name matched against argv. */
+    char *help;                      /**< Listed in the help of the parent. */
+    ArgumentBuilder_t build;         /**< Adds the arguments of the subcommand. */
+    void *build_data;                /**< User data passed to build. */
+    struct ArgumentParser_t *parser; /**< The built parser, NULL until needed. */
+} ArgumentSubcommand_t;
+
+/** @} */
+
+/**
+ * @name ArgumentHot_t data type
+ * @{
+ */
+
+/*
+ * The flags of the parse table are bitsets over the arguments, stored after
+ * it one after the other, each ARGPARSER_BITSET_WORDS(count) words long.
+ * These name a bitset by its position.
+ */
+
+/** @brief The argument may be given more than once. */
+#define ARGPARSER_HOT_REPEATABLE 0
+/** @brief The argument keeps every value, see argparser_get_values(). */
+#define ARGPARSER_HOT_MULTIPLE 1
+/** @brief The argument streams its values to a callback. */
+#define ARGPARSER_HOT_STREAMED 2
+/** @brief The argument must be given: a required option, or a positional taking values. */
+#define ARGPARSER_HOT_REQUIRED 3
+/** @brief The argument is a positional taking several values, checked for each of them. */
+#define ARGPARSER_HOT_SEVERAL 4
+/** @brief The argument writes its value to a destination, see argparser_bind(). */
+#define ARGPARSER_HOT_BOUND 5
+/** @brief Matching the argument ends the parse, as help and version do. */
+#define ARGPARSER_HOT_EXIT 6
+/** @brief The number of flag bitsets. */
+#define ARGPARSER_HOT_FLAGS 7
+
+/**
+ * @struct ArgumentHot_t
+ * @brief The part of an argument read while parsing, packed in 32 bytes so
+ * an entry never straddles a cache line.
+ * @details Derived from the Argument_t at the same position, which keeps
+ * the help, defaults and choices. Matching a token to an argument and
+ * storing its value only touch this entry, the flag bitsets and the value
+ * record.
+ */
+typedef struct ArgumentHot_t
+{
+    const char *name;    /**< The name of the argument, shared with it. */
+    uint32_t length;     /**< The length of name. */
+    uint32_t hash;       /**< The hash of name, taken from the name index. */
+    uint32_t narg_min;   /**< The fewest values taken. */
+    uint32_t narg_max;   /**< The most values taken, UINT32_MAX when unbounded. */
+    uint8_t type;        /**< The ArgumentType of the argument. */
+    uint8_t value_type;  /**< The ArgumentValueType of its values. */
+    char sym;            /**< The short symbol, '\0' when there is none. */
+} ArgumentHot_t;
+
+/** @} */
+
+/**
+ * @name ArgumentArena_t data type
+ * @{
+ */
+
+/**
+ * @struct ArgumentArenaBlock_t
+ * @brief A block of memory handed out by an ArgumentArena_t, followed by its data.
+ */
+typedef struct ArgumentArenaBlock_t
+{
+    struct ArgumentArenaBlock_t *next; /**< The previously allocated block. */
+    size_t size;                       /**< Number of usable bytes in the block. */
+    size_t used;                       /**< Number of bytes already handed out. */
+} ArgumentArenaBlock_t;
+
+/**
+ * @struct ArgumentArena_t
+ * @brief Bump allocator owned by a parser, released as a whole.
+ */
+typedef struct ArgumentArena_t
+{
+    ArgumentArenaBlock_t *head; /**< The current block, allocations are bumped from it. */
+    size_t block_size;          /**< Size of the current block, the next one doubles it. */
+    void *last;                 /**< The latest allocation, which can be grown in place. */
+    ArgumentArenaBlock_t *borrowed; /**< A block in caller memory, never freed. */
+#ifdef ARGPARSER_ENABLE_STATS
+    size_t allocations; /**< Number of blocks requested from ARGPARSER_MALLOC so far. */
+    size_t bytes;       /**< Number of bytes handed out so far. */
+#endif
+} ArgumentArena_t;
+
+/** @} */
+
+/**
+ * @name ArgumentMapping_t data type
+ * @{
+ */
+
+/**
+ * @struct ArgumentMapping_t
+ * @brief A response or config file mapped in memory, kept alive while values point into it.
+ */
+typedef struct ArgumentMapping_t
+{
+    void *data;                     /**< The mapped bytes. */
+    size_t size;                    /**< The size of the mapping. */
+    struct ArgumentMapping_t *next; /**< The previously mapped file. */
+} ArgumentMapping_t;
+
+/** @} */
+
+/**
+ * @name ArgumentStats_t data type
+ * @{
+ */
+
+/**
+ * @struct ArgumentStats_t
+ * @brief Counters of one parse, filled when ARGPARSER_ENABLE_STATS is defined.
+ * @details A lookup costing many probes points at a clustered index, and
+ * trie_builds at abbreviations read by a parser that was never frozen. Times
+ * are in nanoseconds; total_ns also covers the work between phases.
+ */
+typedef struct ArgumentStats_t
+{
+    size_t tokens;       /**< Tokens read, response file contents included. */
+    size_t lookups;      /**< Long option names looked up in the index. */
+    size_t probes;       /**< Index slots compared during those lookups. */
+    size_t trie_builds;  /**< Tries built in the result arena, since the parser had none. */
+    size_t allocations;  /**< Blocks requested from ARGPARSER_MALLOC by the result arena. */
+    size_t bytes;        /**< Bytes handed out by the result arena. */
+    size_t conversions;  /**< Values converted to their typed slot. */
+    uint64_t tokenize_ns; /**< Time spent reading argv and response files. */
+    uint64_t resolve_ns;  /**< Time spent matching tokens to arguments. */
+    uint64_t convert_ns;  /**< Time spent converting values. */
+    uint64_t validate_ns; /**< Time spent checking required arguments. */
+    uint64_t total_ns;    /**< Time spent in the whole parse. */
+} ArgumentStats_t;
+
+struct ArgumentParser_t;
+
+/**
+ * @brief Receives the counters at the end of every parse, successful or not.
+ * @details Runs on the parsing thread, so a parser shared by threads may call
+ * it concurrently.
+ */
+typedef void (*ArgumentStatsCallback_t)(const struct ArgumentParser_t *parser, const ArgumentStats_t *stats, void *user_data);
+
+/** @} */
+
+/**
+ * @name ArgumentResult_t data type
+ * @{
+ */
+
+/**
+ * @struct ArgumentResult_t
+ * @brief The outcome of one parse. Zero it once, then reuse it for any number
+ * of parses: its memory is rewound, not freed, until argparser_result_delete().
+ */
+typedef struct ArgumentResult_t
+{
+    ArgumentValue_t *values;     /**< One entry per argument, in the order of the parser. */
+    int count;                   /**< Number of entries in values. */
+    const ArgumentHot_t *hot;    /**< The parse table the last parse ran on, count entries. */
+    const uint64_t *flags;       /**< Its ARGPARSER_HOT_FLAGS bitsets. */
+    uint64_t *used;              /**< Bitset of the arguments given. */
+    int status;                  /**< ARGPARSER_SUCCESS or ARGPARSER_FAILURE. */
+    ArgumentError_t *error;      /**< Why a batch parse failed or a lazily converted value was rejected, or NULL. Lives in the arena until the next parse. */
+    ArgumentErrorBuffer_t *error_buffer; /**< Takes errors in place of error during argparser_try_parse(). */
+    ArgumentArena_t arena;       /**< Owns the values, rewound by every parse. */
+    ArgumentMapping_t *mappings; /**< Response files of the last parse, unmapped by the next one. */
+    void *target;                /**< Base of the destinations bound with argparser_bind(), or NULL. */
+    int subcommand;              /**< Position plus one of the subcommand the parse stopped at, 0 when none. */
+    int subcommand_index;        /**< Index in argv of its name, where its own arguments start. */
+    bool keep_unknown;           /**< Whether unknown tokens move to the front of argv, see argparser_parse_known_args(). */
+    int remaining;               /**< Entries of argv kept by such a parse, argv[0] included. */
+    struct ArgumentCursor_t *cursor; /**< State of a parse run by argparser_next(), NULL otherwise. */
+    const struct ArgumentTrieNode_t *trie; /**< Trie of a parser without one, built on the first abbreviation of a parse. */
+#ifdef ARGPARSER_ENABLE_STATS
+    ArgumentStats_t stats; /**< The counters of the last parse. */
+#endif
+} ArgumentResult_t;
+
+/** @} */
+
+/**
+ * @name ArgumentMatch_t data type
+ * @{
+ */
+
+/**
+ * @struct ArgumentMatch_t
+ * @brief An argument resolved by argparser_next(), with one of its values.
+ */
+typedef struct ArgumentMatch_t
+{
+    const Argument_t *argument; /**< The argument, owned by the parser that resolved it. */
+    ArgumentView_t value;       /**< The value as stored, data is NULL for a flag or an option given without one. */
+} ArgumentMatch_t;
+
+/**
+ * @typedef ArgumentSource_t
+ * @brief Returns the next token of a stream, or NULL once it ends, see argparser_begin_source().
+ */
+typedef const char *(*ArgumentSource_t)(void *data);
+
+/** @} */
+
+/**
+ * @name ArgumentSchema_t data type
+ * @{
+ */
+
+/**
+ * @struct ArgumentSchema_t
+ * @brief Prebuilt tables of a parser, installed with argparser_load_schema().
+ * @details The index must follow the rules of argparser_add_argument(): a
+ * power of two capacity, at most half full, and slots hashed with FNV-1a.
+ */
+typedef struct ArgumentSchema_t
+{
+    const Argument_t *arguments;       /**< The arguments, copied into the parser. */
+    int count;                         /**< The number of arguments. */
+    const ArgumentIndexEntry_t *index; /**< The name index, borrowed until the parser grows it. */
+    size_t index_capacity;             /**< Number of slots in the index. */
+    size_t index_count;                /**< Number of used slots in the index. */
+    const int *symbols;                /**< 256 short symbol slots, copied into the parser. */
+} ArgumentSchema_t;
+
+/** @} */
+
+/**
+ * @name ArgumentParser_t data type
+ * @{
+ */
+
+/**
+ * @struct ArgumentParser_t
+ * @brief Represents the Argument parser.
+ */
+typedef struct ArgumentParser_t
+{
+    char *program;         /**< The name of the program. */
+    char *usage;           /**< The usage message. */
+    char *epilog;          /**< The epilog message. */
+    int count;             /**< The number of arguments. */
+    int capacity;          /**< The number of arguments that fit before the list grows. */
+    char *description;     /**< The description of the program. */
+    char *version;         /**< Printed by the version option, see argparser_add_version(). */
+    Argument_t *arguments; /**< The list of arguments. */
+    char prefix_char;      /**< The prefix character. */
+    const char *argument_default;
+    bool add_help;
+    bool allow_abbrev;
+    bool exit_on_error;
+    bool zero_copy; /**< Store values as views into argv instead of copies, argv must outlive them. */
+    bool lazy_conversion; /**< Convert typed values on first read instead of while parsing, a rejected value then reads as the default and leaves its error, see ArgumentValue_t::is_invalid. */
+    bool is_frozen; /**< Whether the arguments are read-only, see argparser_freeze(). */
+    char fromfile_prefix_char; /**< Prefix of response file tokens such as @args.txt, '\0' to disable. */
+
+    ArgumentIndexEntry_t *index; /**< Hash index over names and dests, sized to a power of two. */
+    size_t index_capacity;       /**< Number of slots in the index. */
+    size_t index_count;          /**< Number of used slots in the index. */
+    bool index_is_static;        /**< Whether the index is borrowed read-only data, copied before any insert. */
+    int symbols[256];            /**< Position plus one of the argument for each short symbol, 0 when unused. */
+
+    ArgumentPoolEntry_t *pool; /**< Interned strings, so equal names, dests and help texts share one pointer. */
+    size_t pool_capacity;      /**< Number of slots in pool. */
+    size_t pool_count;         /**< Number of used slots in pool. */
+
+    ArgumentTrieNode_t *trie; /**< Prefix trie over long names, built on first use and dropped when arguments change. */
+    int trie_count;           /**< Number of nodes in the trie. */
+    ArgumentHot_t *hot;       /**< Parse table built by the first parse or argparser_freeze(), dropped when arguments change. */
+    uint64_t *flags;          /**< The ARGPARSER_HOT_FLAGS bitsets of hot, stored after it. */
+
+    ArgumentGroup_t *groups; /**< Exclusive and inclusive groups, see argparser_add_group(). */
+    int group_count;         /**< Number of groups. */
+
+    ArgumentSubcommand_t *subcommands; /**< See argparser_add_subcommand(). */
+    int subcommand_count;              /**< Number of subcommands. */
+
+    char *env_prefix;         /**< Options without a variable of their own read this plus their dest, see argparser_set_env_prefix(). */
+    int env_count;            /**< Number of arguments with a variable of their own. */
+    char **envp;              /**< The environment read, environ when NULL. */
+    ArgumentEnvEntry_t *env;  /**< Variable table built by argparser_freeze(), unfrozen parses build theirs per run. */
+    size_t env_capacity;      /**< Number of slots in env, 0 when no argument reads a variable. */
+
+    ArgumentMapping_t *config_files; /**< Files mapped by argparser_load_config(), unmapped with the parser. */
+
+    ArgumentError_t *error; /**< The last error, kept when exit_on_error is false. */
+
+    ArgumentArena_t arena;        /**< Owns the arguments, their strings and the index. */
+    ArgumentResult_t result; /**< The result of argparser_parse_args(). */
+
+    char *help;       /**< The rendered help, built on first use and dropped when arguments change. */
+    size_t help_size; /**< The length of help. */
+    bool tables_are_static; /**< Whether help and trie are borrowed from a blob, so kept by argparser_freeze(). */
+
+#ifdef ARGPARSER_ENABLE_STATS
+    ArgumentStatsCallback_t on_stats; /**< Called with the counters of every parse, or NULL. */
+    void *on_stats_data;              /**< Passed back to on_stats. */
+#endif
+} ArgumentParser_t;
+
+/** @} */
+
+/** @} */
+
+//-----------------------------------------------------------------------------
+// [SECTION] C Only Functions
+//-----------------------------------------------------------------------------
+
+#pragma region C
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+    /**
+     * Initializes an ArgumentParser instance.
+     *
+     * @param parser The ArgumentParser to initialize.
+     * @param program The name of the program.
+     * @param usage The usage message.
+     * @param description The description of the program.
+     * @param epilog The epilog message.
+     * @param add_help Whether to add a help flag automatically.
+     *
+     * Example usage:
+     * @code
+     * ArgumentParser parser;
+     * argparser_initialize(&parser, "my_program", "Usage: my_program [options]", "This is a sample program.", "Epilog message", 1);
+     * @endcode
+     */
+    ARGPARSER_API void argparser_initialize(ArgumentParser_t *, const char *, const char *, const char *, const char *);
+
+    /**
+     * Frees the memory allocated for the ArgumentParser instance.
+     *
+     * @param parser The ArgumentParser instance.
+     *
+     * Example usage:
+     * argparser_delete(parser);
+     */
+    ARGPARSER_API void argparser_delete(ArgumentParser_t *);
+
+    /**
+     * Adds an argument to the argument parser.
+     *
+     * An argument without a short symbol whose name does not start with the
+     * prefix character is positional, an argument with @c nargs of 0 is a flag
+     * and every other argument is a keyword argument. Negative @c nargs values
+     * are built with ARGPARSER_NARGS().
+     *
+     * @param parser The ArgumentParser to add the argument to.
+     * @param sym The short symbol for the argument.
+     * @param name The long name for the argument.
+     * @param required Whether the argument is required.
+     * @param nargs The number of arguments expected.
+     * @param default_value The default value for the argument.
+     * @param help The help message for the argument.
+     *
+     * Example usage:
+     * argparser_add_argument(parser, 'o', "output", 1, 1, "default_output.txt", "Output file");
+     * argparser_add_argument(parser, '\0', "files", 0, ARGPARSER_NARGS(ONE_OR_MORE), NULL, "Input files");
+     */
+    ARGPARSER_API void argparser_add_argument(ArgumentParser_t *, char, const char *, int, int, const char *, const char *);
+
+    /**
+     * Reserves room for a number of arguments, so registering them neither
+     * grows the argument list nor rehashes the name index.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param count The total number of arguments to make room for.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE when out of memory.
+     *
+     * Example usage:
+     * argparser_reserve(parser, 300);
+     */
+    ARGPARSER_API int argparser_reserve(ArgumentParser_t *, int);
+
+    /**
+     * Replaces the arguments of a freshly initialized parser with prebuilt
+     * tables, without hashing or registering anything.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param schema The tables, which must outlive the parser.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE when out of memory.
+     */
+    ARGPARSER_API int argparser_load_schema(ArgumentParser_t *, const ArgumentSchema_t *);
+
+    /**
+     * Writes the arguments, groups, name index, prefix trie and rendered help
+     * of a parser into one blob that argparser_load_blob() installs without
+     * rebuilding any of them, see cmake/ArgparserEmbed.cmake.
+     *
+     * Callbacks, subcommands and variables bound with argparser_store_into()
+     * are not written. The layout is that of the machine writing the blob.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param buffer Receives the blob, 8-aligned, may be NULL when size is 0.
+     * @param size The size of buffer.
+     * @return The size of the blob, which was only written when it fits, or 0 when out of memory.
+     *
+     * Example usage:
+     * size_t size = argparser_serialize(parser, NULL, 0);
+     */
+    ARGPARSER_API size_t argparser_serialize(ArgumentParser_t *, void *, size_t);
+
+    /**
+     * Replaces the arguments of a freshly initialized parser with a blob
+     * from argparser_serialize(). The tables and strings are borrowed, only
+     * the argument list is allocated.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param blob The blob, 8-aligned, which must outlive the parser.
+     * @param size The size of the blob.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE when the blob was written
+     * for another layout or is corrupted. Every section, table and string is
+     * checked before anything is borrowed.
+     *
+     * Example usage:
+     * argparser_load_blob(parser, cli_schema, cli_schema_size);
+     */
+    ARGPARSER_API int argparser_load_blob(ArgumentParser_t *, const void *, size_t);
+
+    /**
+     * Parses the command-line arguments.
+     *
+     * When @c parser->fromfile_prefix_char is set, a token such as @c @args.txt
+     * is replaced by the whitespace separated, optionally quoted tokens of that
+     * file. The file is memory mapped and tokenized in place, so with
+     * zero_copy its values point into the mapping, which lives until the next
+     * parse or argparser_delete().
+     *
+     * The first parse derives a parse table from the arguments and keeps it
+     * until they change through the API, so fields set directly afterwards
+     * need such a change or argparser_freeze() to be picked up.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param argc The argument count.
+     * @param argv The argument vector.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE with the error kept in
+     * @c parser->error when exit_on_error is false.
+     *
+     * Example usage:
+     * argparser_parse_args(parser, argc, argv);
+     */
+    ARGPARSER_API int argparser_parse_args(ArgumentParser_t *, int, char **);
+
+    /**
+     * Parses the command-line arguments like argparser_parse_args(), but
+     * keeps the options it does not know and the positionals it has no room
+     * for instead of failing on them.
+     *
+     * They are moved down in argv, in their order, right after argv[0], and
+     * argv[count] is set to NULL when count < argc. Nothing is copied or
+     * allocated, so argv can go straight to execvp(). A "--" before a kept
+     * token is kept with it. Unknown tokens read from a response file still
+     * fail, since the file is released by the next parse.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param argc The argument count.
+     * @param argv The argument vector, compacted in place.
+     * @return The number of entries left in argv, argv[0] included, or -1
+     * when parsing fails, which may leave argv partly compacted.
+     *
+     * Example usage:
+     * int count = argparser_parse_known_args(parser, argc, argv);
+     * execvp(argv[1], argv + 1);
+     */
+    ARGPARSER_API int argparser_parse_known_args(ArgumentParser_t *, int, char **);
+
+    /**
+     * Starts parsing argv one value at a time, see argparser_next().
+     *
+     * @param parser The ArgumentParser instance.
+     * @param argc The argument count.
+     * @param argv The argument vector.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE when out of memory.
+     */
+    ARGPARSER_API int argparser_begin(ArgumentParser_t *, int, char **);
+
+    /**
+     * Starts parsing the tokens @p source returns, one at a time, so a
+     * stream such as a pipe is parsed as it is read without being buffered.
+     *
+     * Values are copied unless zero_copy is set, then the tokens must stay
+     * valid as long as the result. There is no argv[0], and a subcommand
+     * reads the rest of the stream.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param source Returns the next token, or NULL at the end.
+     * @param data User data passed to source.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE when out of memory.
+     */
+    ARGPARSER_API int argparser_begin_source(ArgumentParser_t *, ArgumentSource_t, void *);
+
+    /**
+     * Resolves tokens up to the next value or flag, storing it as
+     * argparser_parse_args() would. An option taking several values is
+     * matched once per value, one given without a value once with none.
+     *
+     * The caller may stop at any match, leaving the rest of the tokens
+     * unread and the required arguments unchecked. Once the tokens end, the
+     * environment is read and the result checked as by argparser_parse_args(),
+     * after which the getters see the values of the whole parse. The values
+     * of a subcommand follow those of its parent, with match->argument
+     * pointing into the subparser.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param match Receives the argument and its value.
+     * @return 1 for a match, 0 once the parse succeeded, -1 when it failed.
+     *
+     * Example usage:
+     * ArgumentMatch_t match;
+     * argparser_begin(parser, argc, argv);
+     * while (argparser_next(parser, &match) > 0)
+     *     if (strcmp(match.argument->name, "mode") == 0)
+     *         break;
+     */
+    ARGPARSER_API int argparser_next(ArgumentParser_t *, ArgumentMatch_t *);
+
+    /**
+     * Forgets the result of the last argparser_parse_args() and its error,
+     * keeping the arguments and all memory for the next parse.
+     *
+     * @param parser The ArgumentParser instance.
+     */
+    ARGPARSER_API void argparser_reset(ArgumentParser_t *);
+
+    /**
+     * Parses many argument vectors with the same parser, one result each.
+     *
+     * Every result is rewound and refilled, so a batch that reuses its results
+     * allocates nothing once they have grown. A failed parse keeps its error
+     * in @c results[i].error; set exit_on_error to false to parse on past it.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param n The number of argument vectors.
+     * @param argcs The argument count of each vector.
+     * @param argvs The argument vectors.
+     * @param results n results, zeroed before their first use.
+     * @return ARGPARSER_SUCCESS when every parse succeeded, otherwise
+     * ARGPARSER_FAILURE and @c results[i].status tells which failed.
+     *
+     * Example usage:
+     * argparser_parse_batch(parser, n, argcs, argvs, results);
+     */
+    ARGPARSER_API int argparser_parse_batch(const ArgumentParser_t *, int, const int *, char **const *, ArgumentResult_t *);
+
+    /**
+     * Makes the parser read-only. Adding or changing arguments afterwards
+     * fails with a USAGE error, so any number of threads may then call
+     * argparser_parse_into() on it at once without locking.
+     *
+     * Subcommands are built and frozen too, since a shared parser cannot
+     * build them on first use. One whose builder fails stays unbuilt and
+     * leaves its error in @c parser->error, as does a config value left
+     * unconverted by fields written directly, see argparser_load_config().
+     *
+     * @param parser The ArgumentParser instance.
+     */
+    ARGPARSER_API void argparser_freeze(ArgumentParser_t *);
+
+    /**
+     * Parses into a caller-owned result without writing to the parser.
+     *
+     * The parser is only read, so once frozen it can be shared between
+     * threads, each parsing into its own result. Errors go to
+     * @c result->error.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param result The result, from argparser_result_initialize() or zeroed.
+     * @param argc The argument count.
+     * @param argv The argument vector.
+     * @return ARGPARSER_SUCCESS or ARGPARSER_FAILURE, also kept in @c result->status.
+     *
+     * Example usage:
+     * char buffer[2048];
+     * ArgumentResult_t result;
+     * argparser_result_initialize(&result, buffer, sizeof(buffer));
+     * argparser_parse_into(parser, &result, argc, argv);
+     */
+    ARGPARSER_API int argparser_parse_into(const ArgumentParser_t *, ArgumentResult_t *, int, char **);
+
+    /**
+     * Parses like argparser_parse_into(), reporting errors by value only.
+     *
+     * Nothing is printed and exit_on_error is ignored: the error is copied
+     * into @p error, truncated to fit, so a rejected command line costs no
+     * allocation. Help requests come back as HELP for the caller to handle.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param result The result, from argparser_result_initialize() or zeroed.
+     * @param argc The argument count.
+     * @param argv The argument vector.
+     * @param error Receives the error, may be NULL.
+     * @return NONE on success, otherwise the type of the error.
+     *
+     * Example usage:
+     * ArgumentErrorBuffer_t error;
+     * if (argparser_try_parse(parser, &result, argc, argv, &error) != NONE)
+     *     reply(error.error.message);
+     */
+    ARGPARSER_API ArgumentErrorType argparser_try_parse(const ArgumentParser_t *, ArgumentResult_t *, int, char **, ArgumentErrorBuffer_t *);
+
+    /**
+     * Prepares a result, optionally backed by caller memory such as a stack
+     * buffer. Values are carved from @p buffer first and only spill to
+     * ARGPARSER_MALLOC once it is full.
+     *
+     * @param result The result.
+     * @param buffer The memory to use first, or NULL.
+     * @param size The size of @p buffer.
+     */
+    ARGPARSER_API void argparser_result_initialize(ArgumentResult_t *, void *, size_t);
+
+    /**
+     * Frees the memory of a result filled by argparser_parse_batch() or
+     * argparser_parse_into(). A borrowed buffer is left alone.
+     *
+     * @param result The result.
+     */
+    ARGPARSER_API void argparser_result_delete(ArgumentResult_t *);
+
+    /**
+     * Retrieves the value of an argument.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name or dest of the argument.
+     * @return The value of the argument, its default when it was not given, or
+     * NULL when no argument has that name.
+     *
+     * Example usage:
+     * const char *output = argparser_get_arg(parser, "output");
+     */
+    ARGPARSER_API const char *argparser_get_arg(ArgumentParser_t *, const char *);
+
+    /**
+     * Retrieves the value of the argument at a position, skipping the lookup.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param slot The position of the argument, in registration order.
+     * @return As argparser_get_arg().
+     */
+    ARGPARSER_API const char *argparser_get_arg_at(ArgumentParser_t *, int);
+
+    /**
+     * Retrieves the values stored for an argument.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name or dest of the argument.
+     * @param count Receives the number of values.
+     * @return The values of the argument, or NULL when it has none.
+     *
+     * Example usage:
+     * int count;
+     * const ArgumentView_t *files = argparser_get_values(parser, "files", &count);
+     */
+    ARGPARSER_API const ArgumentView_t *argparser_get_values(ArgumentParser_t *, const char *, int *);
+
+    /**
+     * Sets the type values of an argument are converted to while parsing,
+     * the default value is converted right away.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name or dest of the argument.
+     * @param type The value type.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE for an unknown argument
+     * or a default that does not convert.
+     *
+     * Example usage:
+     * argparser_set_type(parser, "count", VALUE_INT);
+     */
+    ARGPARSER_API int argparser_set_type(ArgumentParser_t *, const char *, ArgumentValueType);
+
+    /**
+     * Restricts an argument to a set of choices and makes it a VALUE_ENUM.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name or dest of the argument.
+     * @param choices The allowed values, which must outlive the parser.
+     * @param count The number of choices.
+     * @return As argparser_set_type().
+     *
+     * Example usage:
+     * static const char *colors[] = {"red", "blue", "green"};
+     * argparser_set_choices(parser, "color", colors, 3);
+     */
+    ARGPARSER_API int argparser_set_choices(ArgumentParser_t *, const char *, const char **, int);
+
+    /**
+     * Sets the character splitting the elements of a VALUE_INT_LIST or
+     * VALUE_DOUBLE_LIST value, a comma until set.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name or dest of the argument.
+     * @param separator The separator, which cannot be a digit, a letter, a
+     * sign or a decimal point.
+     * @return As argparser_set_type().
+     *
+     * Example usage:
+     * argparser_set_type(parser, "sizes", VALUE_INT_LIST);
+     * argparser_set_separator(parser, "sizes", ':');
+     */
+    ARGPARSER_API int argparser_set_separator(ArgumentParser_t *, const char *, char);
+
+    /**
+     * Binds an argument to a member of a caller struct, so reading it after
+     * a parse needs no lookup. Every successful parse writes the value to
+     * that member of its ArgumentResult_t::target, which for
+     * argparser_parse_args() is set with argparser_set_target(). Arguments
+     * neither given nor defaulted leave their member untouched.
+     *
+     * The member follows the value type, which should be set first: const
+     * char * for strings, bool for flags and VALUE_BOOL, a 1 to 8 byte
+     * integer for VALUE_INT and VALUE_ENUM, float or double for
+     * VALUE_DOUBLE and ArgumentList_t for lists. A VALUE_INT flag receives
+     * its number of occurrences.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name or dest of the argument.
+     * @param offset The offset of the member, from offsetof().
+     * @param size The size of the member.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE for an unknown argument
+     * or a member that cannot hold its values.
+     *
+     * Example usage:
+     * typedef struct Config { int port; bool verbose; } Config;
+     * ARGPARSER_BIND(parser, "port", Config, port);
+     */
+    ARGPARSER_API int argparser_bind(ArgumentParser_t *, const char *, size_t, size_t);
+
+    /**
+     * @def ARGPARSER_BIND
+     * @brief Binds an argument to @p member of struct @p type, see argparser_bind().
+     */
+    #define ARGPARSER_BIND(parser, name, type, member) argparser_bind((parser), (name), offsetof(type, member), sizeof(((type *)0)->member))
+
+    /**
+     * Binds an argument to a variable, as argparser_bind() but written by
+     * every parse whatever its target.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name or dest of the argument.
+     * @param destination The variable, which must outlive the parser.
+     * @param size The size of the variable.
+     * @return As argparser_bind().
+     *
+     * Example usage:
+     * static int64_t jobs;
+     * argparser_store_into(parser, "jobs", &jobs, sizeof(jobs));
+     */
+    ARGPARSER_API int argparser_store_into(ArgumentParser_t *, const char *, void *, size_t);
+
+    /**
+     * Sets the struct argparser_parse_args() writes bound arguments to.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param target The struct, or NULL to stop writing.
+     */
+    ARGPARSER_API void argparser_set_target(ArgumentParser_t *, void *);
+
+    /**
+     * Streams the values of an argument to a callback while parsing, instead
+     * of collecting them. Each value is converted first, only the first one
+     * is kept for argparser_get_arg(), so a ONE_OR_MORE list of any length
+     * is parsed in constant memory.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name or dest of the argument.
+     * @param callback The callback, or NULL to collect values again.
+     * @param user_data Passed to every call of @p callback.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE for an unknown argument.
+     *
+     * Example usage:
+     * argparser_set_callback(parser, "files", process_file, &queue);
+     */
+    ARGPARSER_API int argparser_set_callback(ArgumentParser_t *, const char *, ArgumentCallback_t, void *);
+
+    /**
+     * Groups arguments that constrain each other, checked once parsing ends.
+     *
+     * An exclusive group allows at most one of its arguments, exactly one
+     * when required. An inclusive group wants all of its arguments or none,
+     * all of them when required. A broken group fails with VALIDATION.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param type GROUP_EXCLUSIVE or GROUP_INCLUSIVE.
+     * @param required Whether the group must be given.
+     * @param names The names or dests of the arguments.
+     * @param count The number of names.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE for an unknown argument.
+     *
+     * Example usage:
+     * static const char *formats[] = {"json", "yaml"};
+     * argparser_add_group(parser, GROUP_EXCLUSIVE, 0, formats, 2);
+     */
+    ARGPARSER_API int argparser_add_group(ArgumentParser_t *, ArgumentGroupType, int, const char **, int);
+
+    /**
+     * Adds a --version flag which, like the help flag, ends the parse
+     * wherever it is on the command line: argv is scanned for it before
+     * anything is stored, so conversions, callbacks and required arguments
+     * are skipped and the version is printed to stdout.
+     *
+     * The parse then fails with VERSION, or HELP for the help flag, and exits
+     * with 0 when exit_on_error is set. argparser_try_parse() only returns
+     * the type and prints nothing.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param sym The short symbol, or '\0' for none.
+     * @param version The text printed, a newline is added.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE when the option is taken.
+     *
+     * Example usage:
+     * argparser_add_version(parser, 'V', "tool 1.4.2");
+     */
+    ARGPARSER_API int argparser_add_version(ArgumentParser_t *, char, const char *);
+
+    /**
+     * Reads an argument from an environment variable when it is not given
+     * on the command line. A flag is set when the variable holds a true
+     * bool, other arguments take the value as if it followed them.
+     *
+     * The environment, @c parser->envp or environ, is scanned once per parse
+     * whatever the number of variables, and values are kept as views into
+     * it, so it must not change while the result is read.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name or dest of the argument.
+     * @param variable The variable, or NULL to only follow the prefix.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE for an unknown argument.
+     *
+     * Example usage:
+     * argparser_set_env(parser, "token", "GITHUB_TOKEN");
+     */
+    ARGPARSER_API int argparser_set_env(ArgumentParser_t *, const char *, const char *);
+
+    /**
+     * Makes every option without a variable of its own read the prefix
+     * followed by its dest upper-cased, such as APP_DRY_RUN for --dry-run
+     * and the prefix "APP_". Positionals, help and version are left out.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param prefix The prefix, or NULL to stop.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE when frozen.
+     *
+     * Example usage:
+     * argparser_set_env_prefix(parser, "APP_");
+     */
+    ARGPARSER_API int argparser_set_env_prefix(ArgumentParser_t *, const char *);
+
+    /**
+     * Reads defaults from a config file, used for the arguments neither argv
+     * nor the environment give, above their default_value.
+     *
+     * The file is mapped and split in place, so nothing is copied and the
+     * values stay views into it until the parser is deleted. Each line is
+     * @c key = value, @c key: value, a @c [section] or a comment starting
+     * with '#' or ';'. A key is a name or dest, "level" in section "[log]"
+     * stands for --log-level. Values may be quoted and TOML arrays such as
+     * @c [1, 2, 3] read as lists. Unknown keys are skipped.
+     *
+     * The values are converted once the file is read. One that does not
+     * convert is dropped, so the argument reads as its default, and is
+     * reported in parser->error once the rest are loaded. Changing the type
+     * or choices of an argument converts its value again, and drops and
+     * reports it the same way.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param path The path of the file.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE when it cannot be read
+     *         or a value does not convert.
+     *
+     * Example usage:
+     * argparser_load_config(parser, "/etc/tool.conf");
+     */
+    ARGPARSER_API int argparser_load_config(ArgumentParser_t *, const char *);
+
+    /**
+     * Registers a subcommand without building it. Parsing stops at the first
+     * positional token left over once the positionals of @p parser are full,
+     * which must name a subcommand. argparser_parse_args() then builds that
+     * one subcommand with @p build and parses the rest of argv with it, so
+     * the cost of a large command tree follows the path actually taken.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name of the subcommand.
+     * @param help Its line in the help of @p parser, may be NULL.
+     * @param build Adds the arguments of the subcommand.
+     * @param user_data Passed to @p build.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE for a duplicate name.
+     *
+     * Example usage:
+     * argparser_add_subcommand(parser, "build", "Compile the project", build_command, &common);
+     */
+    ARGPARSER_API int argparser_add_subcommand(ArgumentParser_t *, const char *, const char *, ArgumentBuilder_t, void *);
+
+    /**
+     * Retrieves the parser of a subcommand, building it on first use. A
+     * frozen parser built and froze its subcommands in argparser_freeze(),
+     * so this only reads it.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name of the subcommand.
+     * @return The subparser, owned by @p parser, or NULL for an unknown name
+     * or a rejected build.
+     */
+    ARGPARSER_API ArgumentParser_t *argparser_get_subparser(ArgumentParser_t *, const char *);
+
+    /**
+     * Retrieves the name of the subcommand chosen by the last parse.
+     *
+     * @param parser The ArgumentParser instance.
+     * @return The name, or NULL when no subcommand was given.
+     */
+    ARGPARSER_API const char *argparser_get_subcommand(ArgumentParser_t *);
+
+    /**
+     * Adds the arguments of @p parent to @p parser, such as options every
+     * subcommand accepts. Their names, help and defaults are referenced,
+     * not copied, so @p parent must outlive @p parser. The help option of
+     * @p parent is skipped.
+     *
+     * Each descriptor is copied as it is now: later changes to @p parent
+     * do not reach @p parser, and values @p parent read with
+     * argparser_load_config() are left behind, to be loaded again here.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param parent The parser holding the shared arguments.
+     * @return ARGPARSER_SUCCESS, or ARGPARSER_FAILURE when a name or symbol
+     * is already taken.
+     *
+     * Example usage:
+     * static int build_command(ArgumentParser_t *parser, void *common)
+     * {
+     *     argparser_add_parent(parser, (const ArgumentParser_t *)common);
+     *     argparser_add_argument(parser, 'j', "--jobs", 0, 1, "1", "Parallel jobs");
+     *     return ARGPARSER_SUCCESS;
+     * }
+     */
+    ARGPARSER_API int argparser_add_parent(ArgumentParser_t *, const ArgumentParser_t *);
+
+    /**
+     * Retrieves the converted value of an argument as an integer.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name or dest of the argument.
+     * @return The value, the number of occurrences of a flag, the index of an
+     * enum, or 0 for unknown and string arguments.
+     */
+    ARGPARSER_API int64_t argparser_get_int(ArgumentParser_t *, const char *);
+
+    /**
+     * Retrieves the converted value of an argument as a double.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name or dest of the argument.
+     * @return The value, or 0 for unknown and string arguments.
+     */
+    ARGPARSER_API double argparser_get_double(ArgumentParser_t *, const char *);
+
+    /**
+     * Retrieves the converted value of an argument as a boolean.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name or dest of the argument.
+     * @return Whether a flag was given, or the converted value.
+     */
+    ARGPARSER_API bool argparser_get_bool(ArgumentParser_t *, const char *);
+
+    /**
+     * Retrieves the index of the chosen value of an enum argument.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name or dest of the argument.
+     * @return The index into the choices, or -1 when none was chosen.
+     */
+    ARGPARSER_API int argparser_get_enum(ArgumentParser_t *, const char *);
+
+    /**
+     * Retrieves the elements of a VALUE_INT_LIST argument. Every occurrence
+     * of the argument appends its elements.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name or dest of the argument.
+     * @param count Receives the number of elements.
+     * @return The elements, owned by the parser, or NULL when there are none.
+     */
+    ARGPARSER_API const int64_t *argparser_get_int_list(ArgumentParser_t *, const char *, size_t *);
+
+    /**
+     * Retrieves the elements of a VALUE_DOUBLE_LIST argument.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param name The name or dest of the argument.
+     * @param count Receives the number of elements.
+     * @return As argparser_get_int_list().
+     */
+    ARGPARSER_API const double *argparser_get_double_list(ArgumentParser_t *, const char *, size_t *);
+
+    /**
+     * @name Result accessors
+     * As the getters above, reading @p result instead of the last parse.
+     * A value lazy_conversion rejects on first read leaves its error in
+     * @c result->error, where the getters above leave it in @c parser->error.
+     * @{
+     */
+    ARGPARSER_API const char *argparser_result_get_arg(const ArgumentParser_t *, const ArgumentResult_t *, const char *);
+    ARGPARSER_API const ArgumentView_t *argparser_result_get_values(const ArgumentParser_t *, const ArgumentResult_t *, const char *, int *);
+    ARGPARSER_API int64_t argparser_result_get_int(const ArgumentParser_t *, const ArgumentResult_t *, const char *);
+    ARGPARSER_API double argparser_result_get_double(const ArgumentParser_t *, const ArgumentResult_t *, const char *);
+    ARGPARSER_API bool argparser_result_get_bool(const ArgumentParser_t *, const ArgumentResult_t *, const char *);
+    ARGPARSER_API int argparser_result_get_enum(const ArgumentParser_t *, const ArgumentResult_t *, const char *);
+    ARGPARSER_API const int64_t *argparser_result_get_int_list(const ArgumentParser_t *, const ArgumentResult_t *, const char *, size_t *);
+    ARGPARSER_API const double *argparser_result_get_double_list(const ArgumentParser_t *, const ArgumentResult_t *, const char *, size_t *);
+    ARGPARSER_API const char *argparser_result_get_subcommand(const ArgumentParser_t *, const ArgumentResult_t *);
+    /** @} */
+
+    /**
+     * Prints the help message.
+     *
+     * The help is rendered once into a buffer cached on the parser and written
+     * with a single fwrite(). Changing arguments through the API drops the
+     * cache, so fields set directly need argparser_freeze() or a new argument
+     * to be picked up.
+     *
+     * @param parser The ArgumentParser instance.
+     *
+     * Example usage:
+     * argparser_print_help(parser);
+     */
+    ARGPARSER_API void argparser_print_help(ArgumentParser_t *);
+
+    /**
+     * Renders the help message into a caller buffer, as printed by
+     * argparser_print_help().
+     *
+     * @param parser The ArgumentParser instance.
+     * @param buf The buffer, NUL-terminated unless @p len is 0.
+     * @param len The size of @p buf.
+     * @return The length of the help, which was truncated if it is not less
+     * than @p len, like snprintf().
+     *
+     * Example usage:
+     * size_t size = argparser_format_help(parser, NULL, 0) + 1;
+     */
+    ARGPARSER_API size_t argparser_format_help(ArgumentParser_t *, char *, size_t);
+
+    /**
+     * Lists the long options that start with a prefix, for shell completion.
+     *
+     * Runs on the prefix trie, so the cost depends on the prefix and the
+     * number of candidates, not on the number of arguments. Hidden arguments
+     * are left out. A prefix not starting with a prefix character also
+     * matches the subcommands, listed after the options in the order added.
+     *
+     * @param parser The ArgumentParser instance.
+     * @param prefix The word being completed, leading prefix characters are ignored.
+     * @param names Receives up to @p max names, sorted, without the leading "--".
+     * @param max The size of @p names.
+     * @return The number of candidates, which may exceed @p max.
+     *
+     * Example usage:
+     * const char *names[16];
+     * int count = argparser_complete(parser, "--ver", names, 16);
+     */
+    ARGPARSER_API int argparser_complete(ArgumentParser_t *, const char *, const char **, int);
+
+    /**
+     * Completes the last word of a command line, as argparser_complete()
+     * does, in the subcommand it reaches.
+     *
+     * Each earlier word naming a subcommand of the parser reached so far
+     * moves completion into that subcommand, building it when needed, so
+     * "tool remote ad" lists the names under "tool remote".
+     *
+     * @param parser The ArgumentParser instance.
+     * @param argc The number of words, the program name included.
+     * @param argv The words, the last one being completed.
+     * @param names Receives up to @p max names.
+     * @param max The size of @p names.
+     * @return The number of candidates, which may exceed @p max.
+     *
+     * Example usage:
+     * int count = argparser_complete_args(parser, COMP_CWORD + 1, words, names, 16);
+     */
+    ARGPARSER_API int argparser_complete_args(ArgumentParser_t *, int, char **, const char **, int);
+
+    /**
+     * @brief Constructs an exception with a specific message and error type.
+     * @param error The error.
+     * @param type The type of the error.
+     * @param message The error message.
+     * @param argument The error argument.
+     */
+    ARGPARSER_API void argparser_error_initialize(ArgumentError_t *error, ArgumentErrorType type, char *argument, char *message);
+
+    /**
+     * @brief Destroy and free an ArgumentError_t. An error raised by a parse
+     * lives in its result arena and is left for the next parse to rewind.
+     * @param error The ArgumentError_t to destory.
+     */
+    ARGPARSER_API void argparser_error_delete(ArgumentError_t *error);
+
+    /**
+     * @brief Gets the error argument.
+     * @param[in] error The error.
+     * @return The error argument.
+     */
+    ARGPARSER_API const char *argparser_error_arg(ArgumentError_t *error);
+
+    /**
+     * @brief Gets the error message.
+     * @param[in] error The error.
+     * @return The error message.
+     */
+    ARGPARSER_API const char *argparser_error_what(ArgumentError_t *error);
+
+    /**
+     * @brief Gets the error type.
+     * @param[in] error The error.
+     * @return The error type.
+     */
+    ARGPARSER_API ArgumentErrorType argparser_error_type(ArgumentError_t *error);
+
+#ifdef __cplusplus
+};
+#endif //__cplusplus
+
+#pragma endregion // C
+
+#pragma region Cpp
+
+#ifdef __cplusplus
+
+//-----------------------------------------------------------------------------
+// [SECTION] C++ Only Classes
+//-----------------------------------------------------------------------------
+
+namespace argparser
+{
+
+    /**
+     * @class ArgumentError
+     * @brief ArgumentError class for Argument-related errors.
+     */
+    class ArgumentError : public std::exception
+    {
+    public:
+        /**
+         * @brief Constructs an exception with a specific error type.
+         * @param type The type of the error.
+         */
+        ArgumentError(ArgumentError_t *error);
+
+        /**
+         * @brief Copies an ArgumentError, duplicating the wrapped error.
+         * @param other The error to copy.
+         */
+        ArgumentError(const ArgumentError &other);
+
+        ArgumentError &operator=(const ArgumentError &) = delete;
+
+        /**
+         * @brief Destroy an ArgumentError.
+         */
+        ~ArgumentError();
+
+        /**
+         * @brief Gets the error argument.
+         * @return The error argument.
+         */
+        const char *argument() const noexcept;
+
+        /**
+         * @brief Gets the error message.
+         * @return The error message.
+         */
+        const char *what() const noexcept override;
+
+        /**
+         * @brief Gets the error type.
+         * @return The error type.
+         */
+        ArgumentErrorType type() const noexcept;
+
+    private:
+        ArgumentError_t *m_Error; /**< The error type. */
+    };
+
+    /** Errors that occur during usage
+     */
+    class UsageError : public ArgumentError
+    {
+    public:
+        UsageError(ArgumentError_t *error)
+            : ArgumentError(error) {};
+    };
+
+    /** Errors that occur during regular parsing
+     */
+    class ParseError : public ArgumentError
+    {
+    public:
+        ParseError(ArgumentError_t *error)
+            : ArgumentError(error) {};
+    };
+
+    /** Errors that when a required flag is omitted
+     */
+    class RequiredError : public ArgumentError
+    {
+    public:
+        RequiredError(ArgumentError_t *error)
+            : ArgumentError(error) {};
+    };
+
+    /**
+     * @class Argument
+     * @brief Builder for an argument, configured in place inside its parser.
+     * @details The builder only holds the parser and the position of the
+     * argument, so every call writes straight into @c parser->arguments.
+     * Once the parser is frozen every setter throws UsageError instead.
+     */
+    class Argument
+    {
+    public:
+        /**
+         * @brief Registers an argument and returns a builder for it.
+         * @param parser The parser that owns the argument.
+         * @param sym The short symbol, or '\0'.
+         * @param name The long name, or the name of a positional argument.
+         * @throws UsageError when the name or symbol is already taken.
+         */
+        Argument(ArgumentParser_t *parser, char sym, const char *name);
+
+        Argument &flag();
+
+        Argument &nargs(Nargs pattern);
+        Argument &nargs(std::size_t num_args);
+        Argument &nargs(std::size_t nargs_min, std::size_t nargs_max);
+
+        Argument &help(std::string_view help_text);
+        Argument &dest(std::string_view dest);
+        Argument &metavar(std::string_view metavar);
+
+        Argument &hidden();
+        Argument &repeat();
+        Argument &required();
+        Argument &stored_count();
+
+        Argument &type(ArgumentValueType type);
+        Argument &choices(std::initializer_list<const char *> choices);
+        Argument &separator(char separator);
+        Argument &env(const char *variable);
+
+        template <typename T>
+        Argument &implicit_value(const T &value)
+        {
+            return set_implicit(to_string(value).c_str());
+        };
+
+        template <typename T>
+        Argument &default_value(const T &value)
+        {
+            return set_default(to_string(value).c_str());
+        };
+
+        /**
+         * @brief Streams every value to @p callback while parsing, see
+         * argparser_set_callback().
+         * @param callback Called with a const ArgumentSlot_t &, returning
+         * void or false to stop parsing. The parser owns a copy of it.
+         */
+        template <typename F>
+        Argument &on_value(F callback)
+        {
+            return set_callback(&Argument::invoke<F>, new F(std::move(callback)), &Argument::release<F>);
+        };
+
+        /**
+         * @brief Writes the value to @p variable after every parse, see
+         * argparser_store_into(). Integers, floating point numbers and bool
+         * also set the value type.
+         * @param variable The destination, which must outlive the parser.
+         */
+        template <typename T>
+        Argument &store_into(T &variable)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                if (get()->type != FLAG)
+                    type(VALUE_BOOL);
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                if (get()->value_type != VALUE_ENUM)
+                    type(VALUE_INT);
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+                type(VALUE_DOUBLE);
+            else
+                static_assert(std::is_same_v<T, const char *> || std::is_same_v<T, ArgumentList_t>,
+                              "store_into() takes an integer, a floating point number, bool, const char * or ArgumentList_t");
+            return bind(&variable, sizeof(T));
+        };
+
+    private:
+        void check() const;
+        Argument_t *get() const;
+        char *copy(const char *str) const;
+        char *intern(std::string_view str, uint32_t *hash) const;
+        Argument &bind(void *destination, std::size_t size);
+
+        Argument &set_default(const char *value);
+        Argument &set_implicit(const char *value);
+        Argument &set_callback(ArgumentCallback_t callback, void *data, void (*release)(void *));
+
+        template <typename F>
+        static int invoke(const Argument_t *, const ArgumentSlot_t *value, void *data)
+        {
+            F &callback = *static_cast<F *>(data);
+
+            if constexpr (std::is_void_v<decltype(callback(*value))>)
+            {
+                callback(*value);
+                return ARGPARSER_SUCCESS;
+            }
+            else
+                return callback(*value) ? ARGPARSER_SUCCESS : ARGPARSER_FAILURE;
+        };
+
+        template <typename F>
+        static void release(void *data)
+        {
+            delete static_cast<F *>(data);
+        };
+
+        template <typename T>
+        static std::string to_string(const T &value)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+                return value ? "true" : "false";
+            else if constexpr (std::is_arithmetic_v<T>)
+                return std::to_string(value);
+            else
+                return std::string(value);
+        };
+
+    private:
+        ArgumentParser_t *m_Parser; /**< The parser owning the argument. */
+        int m_Slot;                 /**< Position of the argument in the parser. */
+    };
+
+    /**
+     * @brief Retrieves the converted value of an argument as @p T.
+     * @details Integers, enums, floating point numbers and bool read the
+     * typed slot filled while parsing, strings read the stored value.
+     */
+    template <typename T>
+    T get(ArgumentParser_t *parser, const char *name)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            return argparser_get_bool(parser, name);
+        else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+            return static_cast<T>(argparser_get_int(parser, name));
+        else if constexpr (std::is_floating_point_v<T>)
+            return static_cast<T>(argparser_get_double(parser, name));
+        else
+        {
+            const char *value = argparser_get_arg(parser, name);
+            return value ? T(value) : T();
+        }
+    };
+
+    /**
+     * @class ParseResult
+     * @brief The values of a parse or its error, in the manner of std::expected.
+     * @details Filled by try_parse() through argparser_try_parse(), so a
+     * rejected command line neither allocates nor throws.
+     */
+    class ParseResult
+    {
+    public:
+        /**
+         * @brief Creates an empty result for a parser.
+         * @param parser The parser, which must outlive the result.
+         */
+        explicit ParseResult(const ArgumentParser_t *parser) noexcept;
+        ParseResult(ParseResult &&other) noexcept;
+        ParseResult(const ParseResult &) = delete;
+        ParseResult &operator=(const ParseResult &) = delete;
+        ~ParseResult();
+
+        /** @brief Whether the parse succeeded. */
+        bool has_value() const noexcept;
+        explicit operator bool() const noexcept;
+
+        /** @brief The type of the error, NONE on success. */
+        ArgumentErrorType error() const noexcept;
+        /** @brief The error message, empty on success. */
+        const char *what() const noexcept;
+        /** @brief The argument the error is about, empty on success. */
+        const char *argument() const noexcept;
+
+        /** @brief The underlying C result. */
+        const ArgumentResult_t *result() const noexcept;
+
+        /**
+         * @brief Retrieves the converted value of an argument, see get().
+         */
+        template <typename T>
+        T get(const char *name) const
+        {
+            if constexpr (std::is_same_v<T, bool>)
+                return argparser_result_get_bool(m_Parser, &m_Result, name);
+            else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+                return static_cast<T>(argparser_result_get_int(m_Parser, &m_Result, name));
+            else if constexpr (std::is_floating_point_v<T>)
+                return static_cast<T>(argparser_result_get_double(m_Parser, &m_Result, name));
+            else
+            {
+                const char *value = argparser_result_get_arg(m_Parser, &m_Result, name);
+                return value ? T(value) : T();
+            }
+        };
+
+    private:
+        friend ParseResult try_parse(const ArgumentParser_t *parser, int argc, char **argv) noexcept;
+
+        const ArgumentParser_t *m_Parser; /**< The parser the values belong to. */
+        ArgumentResult_t m_Result;        /**< The values. */
+        ArgumentErrorBuffer_t m_Error;    /**< The error, if any. */
+        ArgumentErrorType m_Type;         /**< NONE, or the type of the error. */
+    };
+
+    /**
+     * @brief Parses without throwing or allocating on error, see
+     * argparser_try_parse(). Safe to call from many threads on a frozen parser.
+     */
+    ParseResult try_parse(const ArgumentParser_t *parser, int argc, char **argv) noexcept;
+
+    /**
+     * @struct Option
+     * @brief Compile-time descriptor of an argument, see Schema.
+     * @details Follows the rules of argparser_add_argument(). Unlike it, no
+     * underscore dest is derived from the name, set @c dest instead.
+     */
+    struct Option
+    {
+        char sym;                            /**< The short symbol, or '\0'. */
+        const char *name;                    /**< The long name, or the name of a positional argument. */
+        int nargs = 1;                       /**< As the @c nargs parameter of argparser_add_argument(). */
+        bool required = false;               /**< Whether the argument is required. */
+        const char *default_value = nullptr; /**< The default value, or nullptr. */
+        const char *help = nullptr;          /**< The help message, or nullptr. */
+        const char *dest = nullptr;          /**< A dest registered besides the name, or nullptr. */
+    };
+
+    namespace detail
+    {
+        /** Same FNV-1a hash as the name index of the C parser. */
+        constexpr std::uint32_t hash(const char *key, std::size_t length)
+        {
+            std::uint32_t hash = 2166136261u;
+            for (std::size_t i = 0; i < length; i++)
+            {
+                hash ^= (unsigned char)key[i];
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        constexpr std::size_t length(const char *str)
+        {
+            std::size_t size = 0;
+            while (str[size] != '\0')
+                size++;
+            return size;
+        }
+
+        constexpr bool equals(const char *lhs, const char *rhs)
+        {
+            std::size_t i = 0;
+            while (lhs[i] != '\0' && lhs[i] == rhs[i])
+                i++;
+            return lhs[i] == rhs[i];
+        }
+
+        constexpr std::size_t index_capacity(std::size_t keys)
+        {
+            std::size_t capacity = ARGPARSER_INDEX_MIN_CAPACITY;
+            while (keys * 2 > capacity)
+                capacity *= 2;
+            return capacity;
+        }
+
+        template <std::size_t Count, std::size_t Capacity>
+        struct SchemaTables
+        {
+            Argument_t arguments[Count];
+            ArgumentIndexEntry_t index[Capacity];
+            int symbols[256];
+            std::uint64_t required[(Count + 63) / 64];
+            std::size_t keys;
+        };
+
+        template <std::size_t Count, std::size_t Capacity>
+        constexpr void insert(SchemaTables<Count, Capacity> &tables, const char *key, int slot, bool is_dest)
+        {
+            std::uint32_t hash = detail::hash(key, length(key));
+            std::size_t pos = hash & (Capacity - 1);
+
+            while (tables.index[pos].slot != 0)
+            {
+                const Argument_t &other = tables.arguments[tables.index[pos].slot - 1];
+                if (equals(tables.index[pos].is_dest ? other.dest : other.name, key))
+                    throw "conflicting option string";
+                pos = (pos + 1) & (Capacity - 1);
+            }
+
+            tables.index[pos].hash = hash;
+            tables.index[pos].slot = slot + 1;
+            tables.index[pos].is_dest = is_dest;
+            tables.keys++;
+        }
+
+        constexpr Argument_t make_argument(const Option &option)
+        {
+            Argument_t argument{};
+            const char *name = option.name;
+            bool is_option = option.sym != '\0';
+
+            while (*name == '-')
+            {
+                name++;
+                is_option = true;
+            }
+
+            argument.type = option.nargs == 0 ? FLAG : (is_option ? KWARG : ARG);
+            argument.value_type = option.nargs == 0 ? VALUE_BOOL : VALUE_STRING;
+            argument.default_slot.type = argument.value_type;
+            argument.sym = option.sym;
+            argument.name = const_cast<char *>(name);
+            argument.dest = const_cast<char *>(option.dest ? option.dest : name);
+            argument.help = const_cast<char *>(option.help);
+            argument.default_value = const_cast<char *>(option.default_value);
+            argument.required = option.required;
+            argument.is_required = option.required;
+            argument.count = option.nargs;
+
+            if (option.nargs >= 0)
+            {
+                argument.narg_min = (std::size_t)option.nargs;
+                argument.narg_max = (std::size_t)option.nargs;
+            }
+            else
+            {
+                argument.narg_min = option.nargs == ARGPARSER_NARGS(ONE_OR_MORE) ? 1 : 0;
+                argument.narg_max = option.nargs == ARGPARSER_NARGS(OPTIONAL) ? 1 : ARGPARSER_NARGS_UNBOUNDED;
+            }
+            return argument;
+        }
+
+        /** Builds the tables the C parser would build, with the help flag at slot 0 as argparser_initialize() does. */
+        template <std::size_t Count, std::size_t Capacity, std::size_t N>
+        constexpr SchemaTables<Count, Capacity> build(const Option (&options)[N])
+        {
+            SchemaTables<Count, Capacity> tables{};
+
+            tables.arguments[0] = make_argument(Option{'h', "help", 0, false, nullptr, "show this help message and exit"});
+            tables.arguments[0].is_exit = true;
+            for (std::size_t i = 0; i < N; i++)
+                tables.arguments[i + 1] = make_argument(options[i]);
+
+            for (std::size_t i = 0; i < Count; i++)
+            {
+                const Argument_t &argument = tables.arguments[i];
+                unsigned char sym = (unsigned char)argument.sym;
+
+                if (sym != '\0')
+                {
+                    if (tables.symbols[sym] != 0 || sym == '-')
+                        throw "conflicting option string";
+                    tables.symbols[sym] = (int)i + 1;
+                }
+
+                insert(tables, argument.name, (int)i, false);
+                if (!equals(argument.dest, argument.name))
+                    insert(tables, argument.dest, (int)i, true);
+
+                if (argument.is_required)
+                    tables.required[i / 64] |= std::uint64_t(1) << (i % 64);
+            }
+            return tables;
+        }
+
+        constexpr std::size_t count_keys(const Option *options, std::size_t n)
+        {
+            std::size_t keys = 1;
+            for (std::size_t i = 0; i < n; i++)
+                keys += options[i].dest ? 2 : 1;
+            return keys;
+        }
+    }; // namespace detail
+
+#if ARGPARSER_CPP_VERSION >= 202002L
+    /**
+     * @struct FixedString
+     * @brief A string literal usable as a template argument, as in Schema::get<"output">().
+     */
+    template <std::size_t N>
+    struct FixedString
+    {
+        char data[N]{};
+
+        constexpr FixedString(const char (&str)[N])
+        {
+            for (std::size_t i = 0; i < N; i++)
+                data[i] = str[i];
+        }
+    };
+#endif
+
+    /**
+     * @class Schema
+     * @brief A parser schema computed entirely at compile time.
+     * @details The argument table, name index, short symbol table and required
+     * bitmask are static data, so installing the schema copies the arguments
+     * and nothing is hashed or registered at startup.
+     *
+     * Example usage:
+     * @code
+     * static constexpr argparser::Option options[] = {
+     *     {'o', "--output", 1, false, "a.out", "Output file"},
+     *     {'v', "--verbose", 0, false, nullptr, "Verbose output"},
+     * };
+     * using Cli = argparser::Schema<options>;
+     *
+     * Cli::install(&parser);
+     * argparser_parse_args(&parser, argc, argv);
+     * const char *output = Cli::get<"output">(&parser); // C++20
+     * const char *verbose = Cli::get(&parser, Cli::index_of("verbose"));
+     * @endcode
+     */
+    template <const auto &Options>
+    class Schema
+    {
+        static constexpr std::size_t N = std::extent_v<std::remove_reference_t<decltype(Options)>>;
+
+    public:
+        /** Number of arguments, the help flag included. */
+        static constexpr int count = (int)N + 1;
+
+        /** Number of slots of the name index. */
+        static constexpr std::size_t capacity = detail::index_capacity(detail::count_keys(Options, N));
+
+        /** The prebuilt tables. */
+        static constexpr detail::SchemaTables<N + 1, capacity> tables = detail::build<N + 1, capacity>(Options);
+
+        /**
+         * @brief Position of the argument with a name or dest, resolved at compile time when constant.
+         * @return The position, or -1 for unknown names.
+         */
+        static constexpr int index_of(const char *name)
+        {
+            std::size_t size = detail::length(name);
+            std::uint32_t hash = detail::hash(name, size);
+
+            for (std::size_t pos = hash & (capacity - 1); tables.index[pos].slot != 0; pos = (pos + 1) & (capacity - 1))
+            {
+                const ArgumentIndexEntry_t &entry = tables.index[pos];
+                const Argument_t &argument = tables.arguments[entry.slot - 1];
+
+                if (entry.hash == hash && detail::equals(entry.is_dest ? argument.dest : argument.name, name))
+                    return entry.slot - 1;
+            }
+            return -1;
+        }
+
+        /**
+         * @brief Whether the argument at a position is required, from the static bitmask.
+         */
+        static constexpr bool is_required(int slot)
+        {
+            return (tables.required[slot / 64] >> (slot % 64)) & 1;
+        }
+
+        /**
+         * @brief Installs the tables into a freshly initialized parser.
+         * @throws UsageError when out of memory.
+         */
+        static void install(ArgumentParser_t *parser)
+        {
+            ArgumentSchema_t schema{tables.arguments, count, tables.index, capacity, tables.keys, tables.symbols};
+
+            if (argparser_load_schema(parser, &schema) != ARGPARSER_SUCCESS)
+            {
+                ArgumentError_t *error = parser->error;
+                parser->error = NULL;
+                throw UsageError(error);
+            }
+        }
+
+        /**
+         * @brief Value of the argument at a position, see argparser_get_arg().
+         */
+        static const char *get(ArgumentParser_t *parser, int slot)
+        {
+            return argparser_get_arg_at(parser, slot);
+        }
+
+#if ARGPARSER_CPP_VERSION >= 202002L
+        /**
+         * @brief Value of a named argument, with the name resolved at compile time.
+         */
+        template <FixedString Name>
+        static const char *get(ArgumentParser_t *parser)
+        {
+            constexpr int slot = index_of(Name.data);
+            static_assert(slot >= 0, "unknown argument name");
+            return argparser_get_arg_at(parser, slot);
+        }
+#endif
+    };
+
+#if ARGPARSER_HAS_COROUTINES
+    /**
+     * @class Matches
+     * @brief The values of a parse, resolved as they are iterated, see matches().
+     * @details A coroutine over argparser_next(), so leaving the loop early
+     * leaves the rest of the tokens unread. A failed parse throws from the
+     * iterator, as a ParseError, RequiredError or UsageError.
+     */
+    class Matches
+    {
+    public:
+        struct promise_type
+        {
+            const ArgumentMatch_t *current = nullptr; /**< The match yielded last. */
+            std::exception_ptr error;                 /**< What the parse threw, rethrown by the iterator. */
+
+            Matches get_return_object() noexcept;
+            std::suspend_always initial_suspend() noexcept;
+            std::suspend_always final_suspend() noexcept;
+            std::suspend_always yield_value(const ArgumentMatch_t &match) noexcept;
+            void return_void() noexcept;
+            void unhandled_exception() noexcept;
+        };
+
+        class iterator
+        {
+        public:
+            using value_type = ArgumentMatch_t;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() noexcept = default;
+            explicit iterator(std::coroutine_handle<promise_type> handle);
+
+            const ArgumentMatch_t &operator*() const noexcept;
+            const ArgumentMatch_t *operator->() const noexcept;
+            iterator &operator++();
+            void operator++(int);
+            bool operator==(std::default_sentinel_t) const noexcept;
+
+        private:
+            void resume();
+
+            std::coroutine_handle<promise_type> m_Handle; /**< The running parse. */
+        };
+
+        Matches(Matches &&other) noexcept;
+        Matches(const Matches &) = delete;
+        Matches &operator=(const Matches &) = delete;
+        ~Matches();
+
+        /** @brief Resolves the first match, the parse starts here rather than in matches(). */
+        iterator begin();
+        std::default_sentinel_t end() const noexcept;
+
+    private:
+        explicit Matches(std::coroutine_handle<promise_type> handle) noexcept;
+
+        std::coroutine_handle<promise_type> m_Handle; /**< The parse, destroyed with the range. */
+    };
+
+    /**
+     * @brief Parses argv lazily, yielding each resolved argument and value,
+     * see argparser_begin() and argparser_next().
+     *
+     * @code
+     * for (const ArgumentMatch_t &match : argparser::matches(parser, argc, argv))
+     *     if (std::strcmp(match.argument->name, "mode") == 0)
+     *         break;
+     * @endcode
+     */
+    Matches matches(ArgumentParser_t *parser, int argc, char **argv);
+#endif
+
+}; // namespace argparser
+
+#endif //__cplusplus
+
+#pragma endregion // Cpp
+
+#endif // ARGPARSER_H
+
+#pragma region Implementation
+
+#ifdef ARGPARSER_IMPLEMENTATION
+
+#if ARGPARSER_PLATFORM_IS(LINUX) || ARGPARSER_PLATFORM_IS(APPLE)
+	#include <fcntl.h>    // for open
+	#include <sys/mman.h> // for mmap
+	#include <sys/stat.h> // for fstat
+	#include <unistd.h>   // for close
+	#define ARGPARSER_HAS_MMAP 1
+#else
+	#define ARGPARSER_HAS_MMAP 0
+#endif
+
+#ifdef ARGPARSER_ENABLE_STATS
+	#include <time.h> // for clock_gettime
+#endif
+
+/* The environment read by argparser_set_env(), unless parser->envp is set. */
+#if ARGPARSER_PLATFORM_IS(WINDOWS)
+	#define ARGPARSER_ENVIRON _environ
+#else
+	#ifdef __cplusplus
+	extern "C" char **environ;
+	#else
+	extern char **environ;
+	#endif
+	#define ARGPARSER_ENVIRON environ
+#endif
+
+#if ARGPARSER_COMPILER_IS(MSVC)
+	#include <intrin.h> // for _BitScanForward64
+#endif
+
+/* The token scanner uses the widest vectors the target is built for. */
+#define ARGPARSER_SIMD_NONE 0
+#define ARGPARSER_SIMD_SSE2 1
+#define ARGPARSER_SIMD_AVX2 2
+#define ARGPARSER_SIMD_NEON 3
+
+#if defined(ARGPARSER_DISABLE_SIMD)
+	#define ARGPARSER_SIMD ARGPARSER_SIMD_NONE
+#elif defined(__AVX2__)
+	#include <immintrin.h> // for _mm256_cmpeq_epi8
+	#define ARGPARSER_SIMD ARGPARSER_SIMD_AVX2
+#elif defined(__SSE2__) || (ARGPARSER_COMPILER_IS(MSVC) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+	#include <emmintrin.h> // for _mm_cmpeq_epi8
+	#define ARGPARSER_SIMD ARGPARSER_SIMD_SSE2
+#elif defined(__ARM_NEON) || (ARGPARSER_COMPILER_IS(MSVC) && defined(_M_ARM64))
+	#include <arm_neon.h> // for vceqq_u8
+	#define ARGPARSER_SIMD ARGPARSER_SIMD_NEON
+#else
+	#define ARGPARSER_SIMD ARGPARSER_SIMD_NONE
+#endif
+
+/* Vector loads may read the bytes around a token, which the address sanitizer would report. */
+#if ARGPARSER_COMPILER_IS(MSVC) && defined(__SANITIZE_ADDRESS__)
+	#define ARGPARSER_NO_SANITIZE_ADDRESS __declspec(no_sanitize_address)
+#elif defined(__SANITIZE_ADDRESS__) || ARGPARSER_HAS_FEATURE(address_sanitizer)
+	#define ARGPARSER_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+	#define ARGPARSER_NO_SANITIZE_ADDRESS
+#endif
+
+#pragma region Internal
+
+//-----------------------------------------------------------------------------
+// [SECTION] Defines
+//-----------------------------------------------------------------------------
+
+/** Size of the buffer used to format an error message or an option spec. */
+#define ARGPARSER_MESSAGE_SIZE 256
+
+/** Longest section plus key of a config file line, longer ones are skipped. */
+#define ARGPARSER_CONFIG_KEY_SIZE 256
+
+/** Alignment of every arena allocation. */
+#define ARGPARSER_ARENA_ALIGN 16
+
+/** Rounds a size up to the arena alignment. */
+#define ARGPARSER_ARENA_ROUND(size) (((size) + (ARGPARSER_ARENA_ALIGN - 1)) & ~(size_t)(ARGPARSER_ARENA_ALIGN - 1))
+
+/** Offset of the data of an arena block from its start. */
+#define ARGPARSER_ARENA_HEADER ARGPARSER_ARENA_ROUND(sizeof(ArgumentArenaBlock_t))
+
+/** A value or positional argument. */
+#define ARGPARSER_TOKEN_POSITIONAL 0
+/** A long option such as --name or --name=value. */
+#define ARGPARSER_TOKEN_LONG 1
+/** A short option or a bundle such as -v or -abc. */
+#define ARGPARSER_TOKEN_SHORT 2
+/** The "--" that ends options. */
+#define ARGPARSER_TOKEN_SEPARATOR 3
+
+/** "ARGP" read as a little-endian word, the first field of a blob. */
+#define ARGPARSER_BLOB_MAGIC 0x50475241u
+/** Changes whenever the layout of a blob does. */
+#define ARGPARSER_BLOB_VERSION 1u
+/** Stands for a NULL string in a blob. */
+#define ARGPARSER_BLOB_NULL UINT32_MAX
+/** Rounds a blob offset up to 8 bytes. */
+#define ARGPARSER_BLOB_ROUND(size) (((size) + 7) & ~(size_t)7)
+
+#ifdef ARGPARSER_ENABLE_STATS
+	/** Adds to a counter of the parse owning a result. */
+	#define ARGPARSER_STAT(result, field, n) ((result)->stats.field += (n))
+	/** Starts a phase timer. */
+	#define ARGPARSER_STAT_START(timer) uint64_t timer = argparser_stats_clock()
+	/** Adds the time since a phase timer started to a counter. */
+	#define ARGPARSER_STAT_STOP(result, field, timer) ((result)->stats.field += argparser_stats_clock() - (timer))
+#else
+	#define ARGPARSER_STAT(result, field, n) ((void)0)
+	#define ARGPARSER_STAT_START(timer) ((void)0)
+	#define ARGPARSER_STAT_STOP(result, field, timer) ((void)0)
+#endif
+
+//-----------------------------------------------------------------------------
+// [SECTION] Data Structures
+//-----------------------------------------------------------------------------
+
+/**
+ * @struct ArgumentToken_t
+ * @brief A token classified once, so the resolver never rescans it.
+ */
+typedef struct ArgumentToken_t
+{
+    const char *text; /**< The token, NUL-terminated. */
+    size_t length;    /**< The length of text. */
+    size_t equals;    /**< Offset of the first '=', length when there is none. */
+    int kind;         /**< One of the ARGPARSER_TOKEN_* kinds. */
+    bool is_option;   /**< Whether the token stops the values of an option. */
+} ArgumentToken_t;
+
+/**
+ * @struct ArgumentTokens_t
+ * @brief Cursor over argv that expands response files as it goes.
+ */
+typedef struct ArgumentTokens_t
+{
+    const ArgumentParser_t *parser; /**< The parser being run. */
+    ArgumentResult_t *result; /**< The result that owns expanded files. */
+    int argc;                 /**< The argument count. */
+    char **argv;              /**< The argument vector. */
+    int index;                /**< The next argv entry to read. */
+    char *file;               /**< Unread part of the current response file, or NULL. */
+    char *file_end;           /**< End of the current response file. */
+    bool file_slack;          /**< Whether the byte at file_end may be overwritten. */
+    const char *pending;      /**< A token read ahead by argparser_tokens_peek(). */
+    ArgumentToken_t token;    /**< The pending token, classified. */
+    bool failed;              /**< Whether a response file could not be read. */
+    ArgumentSource_t source;  /**< Read in place of argv when not NULL. */
+    void *source_data;        /**< User data passed to source. */
+    const char *sourced;      /**< The last token source returned. */
+} ArgumentTokens_t;
+
+/**
+ * @struct ArgumentCursor_t
+ * @brief Where a parse stands between two resolved values, see argparser_step().
+ */
+typedef struct ArgumentCursor_t
+{
+    ArgumentTokens_t tokens;     /**< The tokens left. */
+    int positional;              /**< The first positional that may still take values. */
+    bool only_positionals;       /**< Whether "--" was read. */
+    char *separator;             /**< A "--" not kept yet, see argparser_keep_unknown(). */
+    const char *cluster;         /**< The next symbol of a short cluster, or NULL. */
+    const char *cluster_token;   /**< The cluster. */
+    size_t cluster_length;       /**< The length of cluster_token. */
+    int slot;                    /**< The option taking values from the following tokens, -1 when none. */
+    uint32_t taken;              /**< The values it took so far. */
+    bool is_done;                /**< Whether argparser_next() finished the parse. */
+    ArgumentParser_t *subparser; /**< The subcommand argparser_next() went on to, or NULL. */
+} ArgumentCursor_t;
+
+/**
+ * @struct ArgumentWriter_t
+ * @brief Appends text to a fixed buffer, counting what does not fit.
+ */
+typedef struct ArgumentWriter_t
+{
+    char *data;      /**< The buffer, may be NULL to only measure. */
+    size_t capacity; /**< The size of the buffer. */
+    size_t length;   /**< The length of the text, including what did not fit. */
+} ArgumentWriter_t;
+
+typedef void (*ArgumentRender_t)(const ArgumentParser_t *parser, ArgumentWriter_t *writer);
+
+/**
+ * @struct ArgumentBlobHeader_t
+ * @brief Starts a blob from argparser_serialize(). Offsets are from the
+ * start of the blob, strings are NUL-terminated and ARGPARSER_BLOB_NULL
+ * stands for NULL.
+ */
+typedef struct ArgumentBlobHeader_t
+{
+    uint32_t magic;          /**< ARGPARSER_BLOB_MAGIC, which also tells the byte order. */
+    uint32_t version;        /**< ARGPARSER_BLOB_VERSION. */
+    uint32_t size;           /**< Size of the whole blob. */
+    uint16_t entry_size;     /**< sizeof(ArgumentIndexEntry_t) of the writer. */
+    uint16_t node_size;      /**< sizeof(ArgumentTrieNode_t) of the writer. */
+    uint32_t count;          /**< Number of arguments. */
+    uint32_t choice_count;   /**< Number of choices of all arguments. */
+    uint32_t group_count;    /**< Number of groups. */
+    uint32_t mask_words;     /**< Number of words in all group masks. */
+    uint32_t index_capacity; /**< Number of slots in the index. */
+    uint32_t index_count;    /**< Number of used slots in the index. */
+    uint32_t trie_count;     /**< Number of trie nodes, 0 without abbreviations. */
+    uint32_t help_size;      /**< Length of the rendered help. */
+    uint32_t arguments;      /**< Offset of count ArgumentBlobArgument_t. */
+    uint32_t choices;        /**< Offset of the string offsets of the choices. */
+    uint32_t groups;         /**< Offset of group_count ArgumentBlobGroup_t. */
+    uint32_t masks;          /**< Offset of the group masks, 8-aligned. */
+    uint32_t index;          /**< Offset of the index, borrowed as it is. */
+    uint32_t trie;           /**< Offset of the trie, borrowed as it is. */
+    uint32_t symbols;        /**< Offset of the 256 short symbol slots. */
+    uint32_t help;           /**< Offset of the rendered help. */
+    uint32_t program;        /**< The name of the program. */
+    uint32_t usage;          /**< The usage message. */
+    uint32_t description;    /**< The description. */
+    uint32_t epilog;         /**< The epilog. */
+    uint32_t program_version; /**< The text of the version option. */
+    uint32_t env_prefix;     /**< The environment variable prefix. */
+    char prefix_char;        /**< The prefix character. */
+    char fromfile_prefix_char; /**< The response file prefix. */
+    uint8_t allow_abbrev;    /**< Whether abbreviations are allowed. */
+    uint8_t add_help;        /**< Whether the help option was added. */
+} ArgumentBlobHeader_t;
+
+/**
+ * @struct ArgumentBlobArgument_t
+ * @brief The serialized part of an Argument_t, callbacks and variables
+ * bound with argparser_store_into() are left out.
+ */
+typedef struct ArgumentBlobArgument_t
+{
+    uint64_t narg_min;      /**< Fewest values. */
+    uint64_t narg_max;      /**< Most values. */
+    uint32_t name;          /**< The name. */
+    uint32_t dest;          /**< The dest. */
+    uint32_t metavar;       /**< The metavar. */
+    uint32_t help;          /**< The help message. */
+    uint32_t default_value; /**< The default value. */
+    uint32_t implicit_value; /**< The implicit value. */
+    uint32_t first_choice;  /**< Index of the first choice in the choices. */
+    int32_t choice_count;   /**< The number of choices. */
+    int32_t count;          /**< The nargs pattern. */
+    int32_t required;       /**< The required field. */
+    int32_t action_type;    /**< The action type. */
+    uint32_t store_offset;  /**< The member bound with argparser_bind(), plus one. */
+    uint32_t store_size;    /**< The size of that member. */
+    uint8_t type;           /**< The ArgumentType. */
+    uint8_t value_type;     /**< The ArgumentValueType. */
+    char sym;               /**< The short symbol. */
+    char separator;         /**< The list separator. */
+    uint8_t store_count;    /**< The store_count flag. */
+    uint8_t is_repeatable;  /**< The is_repeatable flag. */
+    uint8_t is_deprecated;  /**< The is_deprecated flag. */
+    uint8_t is_optional;    /**< The is_optional flag. */
+    uint8_t is_required;    /**< The is_required flag. */
+    uint8_t is_hidden;      /**< The is_hidden flag. */
+    uint8_t is_exit;        /**< The is_exit flag. */
+    uint32_t env;           /**< The environment variable. */
+} ArgumentBlobArgument_t;
+
+/**
+ * @struct ArgumentBlobGroup_t
+ * @brief A serialized ArgumentGroup_t.
+ */
+typedef struct ArgumentBlobGroup_t
+{
+    uint32_t type;        /**< The ArgumentGroupType. */
+    uint32_t is_required; /**< Whether the group must be given. */
+    uint32_t words;       /**< Number of words in the mask. */
+    uint32_t mask;        /**< Index of the first word in the masks. */
+} ArgumentBlobGroup_t;
+
+//-----------------------------------------------------------------------------
+// [SECTION] C Only Functions
+//-----------------------------------------------------------------------------
+
+#pragma region C
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+    //-----------------------------------------------------------------------------
+    // [SECTION] Declarations
+    //-----------------------------------------------------------------------------
+
+    static void *argparser_arena_alloc(ArgumentArena_t *arena, size_t size);
+    static void *argparser_arena_realloc(ArgumentArena_t *arena, void *ptr, size_t old_size, size_t new_size);
+    static char *argparser_arena_strdup(ArgumentArena_t *arena, const char *str);
+    static void argparser_arena_reset(ArgumentArena_t *arena);
+    static void argparser_arena_release(ArgumentArena_t *arena);
+    static void argparser_arena_borrow(ArgumentArena_t *arena, void *buffer, size_t size);
+
+    static uint32_t argparser_hash(const char *key, size_t length);
+
+    static bool argparser_index_reserve(ArgumentParser_t *parser, size_t keys);
+    static void argparser_index_insert(ArgumentParser_t *parser, int slot, bool is_dest, uint32_t hash);
+    static Argument_t *argparser_index_find(const ArgumentParser_t *parser, const char *key, size_t length, bool names_only);
+    static Argument_t *argparser_index_lookup(const ArgumentParser_t *parser, ArgumentResult_t *result, const char *key, size_t length, bool names_only);
+    static Argument_t *argparser_index_probe(const ArgumentParser_t *parser, ArgumentResult_t *result, const char *key, size_t length, uint32_t hash, bool names_only);
+    static char *argparser_intern(ArgumentParser_t *parser, const char *str, size_t length, bool borrow, uint32_t *hash);
+
+    static bool argparser_grow_arguments(ArgumentParser_t *parser, size_t capacity);
+    static Argument_t *argparser_emplace_argument(ArgumentParser_t *parser, char sym, const char *name, int nargs);
+    static void argparser_register_argument(ArgumentParser_t *parser, uint32_t name_hash, uint32_t dest_hash);
+    static void argparser_set_nargs(Argument_t *argument, int nargs);
+    static Argument_t *argparser_find_sym(const ArgumentParser_t *parser, char sym);
+    static Argument_t *argparser_find_mutable(ArgumentParser_t *parser, const char *name);
+    static bool argparser_is_option(const ArgumentParser_t *parser, const char *token);
+    static size_t argparser_count_char(const char *text, size_t size, char c);
+    static void argparser_scan_token(const char *text, size_t *length, size_t *equals);
+    static void argparser_classify(const ArgumentParser_t *parser, const char *text, ArgumentToken_t *token);
+    static bool argparser_is_multiple(const Argument_t *argument);
+    static size_t argparser_hot_size(const ArgumentParser_t *parser);
+    static void argparser_build_hot(const ArgumentParser_t *parser, ArgumentHot_t *hot);
+    static bool argparser_cache_hot(ArgumentParser_t *parser);
+    static bool argparser_hot_flag(const ArgumentResult_t *result, int slot, int flag);
+    static int argparser_ctz64(uint64_t bits);
+    static int argparser_popcount64(uint64_t bits);
+
+    static int argparser_raise(ArgumentParser_t *parser, ArgumentErrorType type, const char *argument, const char *message);
+    static int argparser_report(const ArgumentParser_t *parser, ArgumentArena_t *arena, ArgumentError_t **error, ArgumentErrorType type, const char *argument, const char *message);
+    static int argparser_fail(const ArgumentParser_t *parser, ArgumentResult_t *result, ArgumentErrorType type, const char *argument, const char *message);
+    static ArgumentError_t *argparser_arena_error(ArgumentArena_t *arena, ArgumentErrorType type, const char *argument, const char *message);
+    static void argparser_error_fill(ArgumentErrorBuffer_t *buffer, ArgumentErrorType type, const char *argument, const char *message);
+    static int argparser_mark_used(const ArgumentParser_t *parser, ArgumentResult_t *result, int slot, const char *token);
+    static int argparser_store(const ArgumentParser_t *parser, ArgumentResult_t *result, int slot, const char *value, size_t size);
+    static int argparser_store_view(const ArgumentParser_t *parser, ArgumentResult_t *result, int slot, const char *value, size_t size, bool copy);
+
+    static bool argparser_map(ArgumentArena_t *arena, const char *path, ArgumentMapping_t *mapping, size_t *size, bool *slack);
+    static void argparser_unmap(ArgumentMapping_t *mapping);
+    static bool argparser_map_file(ArgumentTokens_t *tokens, const char *path);
+    static void argparser_unmap_files(ArgumentResult_t *result);
+    static int argparser_begin_run(ArgumentParser_t *parser, int argc, char **argv, ArgumentSource_t source, void *data);
+    static void argparser_adopt_error(ArgumentParser_t *parser, ArgumentError_t **error);
+    static void argparser_config_line(ArgumentParser_t *parser, char *line, char *line_end, bool terminable, char *section, size_t *section_length);
+    static const ArgumentSlot_t *argparser_config_slot(const ArgumentParser_t *parser, const Argument_t *argument);
+    static int argparser_convert_config(ArgumentParser_t *parser, Argument_t *argument);
+    static const char *argparser_tokens_scan(ArgumentTokens_t *tokens);
+    static const ArgumentToken_t *argparser_tokens_peek(ArgumentTokens_t *tokens);
+    static const ArgumentToken_t *argparser_tokens_next(ArgumentTokens_t *tokens);
+    static int argparser_validate(const ArgumentParser_t *parser, ArgumentResult_t *result);
+    static int argparser_validate_group(const ArgumentParser_t *parser, ArgumentResult_t *result, const ArgumentGroup_t *group);
+    static int argparser_find_subcommand(const ArgumentParser_t *parser, const char *name, size_t length);
+    static ArgumentParser_t *argparser_build_subcommand(ArgumentParser_t *parser, int index);
+
+    static bool argparser_parse_int(const char *str, size_t size, int64_t *out);
+    static bool argparser_parse_double(const char *str, size_t size, double *out);
+    static bool argparser_parse_bool(const char *str, size_t size, bool *out);
+    static bool argparser_is_separator(char c);
+    static int argparser_swar_digits(const char *str, uint32_t *value);
+    static bool argparser_parse_element_int(const char *str, size_t size, const char *limit, int64_t *out);
+    static bool argparser_parse_element_double(const char *str, size_t size, const char *limit, double *out);
+    static bool argparser_convert_list(const Argument_t *argument, ArgumentView_t view, ArgumentSlot_t *slot, ArgumentArena_t *arena, char *message, size_t size);
+    static bool argparser_append_list(ArgumentArena_t *arena, ArgumentList_t *list, const ArgumentList_t *tail);
+    static bool argparser_convert(const Argument_t *argument, ArgumentView_t view, ArgumentSlot_t *slot, ArgumentArena_t *arena, char *message, size_t size);
+    static int argparser_apply_default(ArgumentParser_t *parser, Argument_t *argument);
+    static const ArgumentSlot_t *argparser_slot_of(const ArgumentParser_t *parser, const Argument_t *argument, const ArgumentValue_t *record);
+    static int64_t argparser_slot_int(const ArgumentParser_t *parser, const Argument_t *argument, const ArgumentValue_t *record);
+    static double argparser_slot_double(const ArgumentParser_t *parser, const Argument_t *argument, const ArgumentValue_t *record);
+    static const ArgumentList_t *argparser_list_of(const ArgumentParser_t *parser, const ArgumentResult_t *result, const char *name, ArgumentValueType type);
+
+    static const ArgumentValue_t *argparser_record_of(const ArgumentParser_t *parser, const ArgumentResult_t *result, const Argument_t *argument);
+    static const ArgumentValue_t *argparser_converted_of(const ArgumentParser_t *parser, const ArgumentResult_t *result, const Argument_t *argument);
+    static const char *argparser_value_of(const Argument_t *argument, const ArgumentValue_t *record);
+    static bool argparser_store_fits(const Argument_t *argument, size_t size);
+    static void argparser_store_value(const ArgumentParser_t *parser, const Argument_t *argument, const ArgumentValue_t *record, void *destination);
+    static int argparser_store_bound(const ArgumentParser_t *parser, ArgumentResult_t *result);
+    static int argparser_run(const ArgumentParser_t *parser, ArgumentResult_t *result, int argc, char **argv);
+    static int argparser_run_args(const ArgumentParser_t *parser, ArgumentResult_t *result, int argc, char **argv);
+    static int argparser_run_start(const ArgumentParser_t *parser, ArgumentResult_t *result, ArgumentCursor_t *cursor, int argc, char **argv, ArgumentSource_t source, void *data);
+    static int argparser_run_finish(const ArgumentParser_t *parser, ArgumentResult_t *result);
+    static int argparser_step_store(const ArgumentParser_t *parser, ArgumentResult_t *result, int slot, const char *value, size_t size, ArgumentMatch_t *match);
+    static int argparser_step_option(const ArgumentParser_t *parser, ArgumentResult_t *result, ArgumentCursor_t *cursor, int slot, const char *inline_value, size_t inline_size, ArgumentMatch_t *match);
+    static int argparser_step_short(const ArgumentParser_t *parser, ArgumentResult_t *result, ArgumentCursor_t *cursor, ArgumentMatch_t *match);
+    static int argparser_step(const ArgumentParser_t *parser, ArgumentResult_t *result, ArgumentCursor_t *cursor, ArgumentMatch_t *match);
+    static int argparser_keep_unknown(ArgumentResult_t *result, ArgumentTokens_t *tokens, const char *token, char **separator);
+    static int argparser_exit(const ArgumentParser_t *parser, ArgumentResult_t *result, int slot);
+    static int argparser_find_exit(const ArgumentParser_t *parser, ArgumentResult_t *result, int argc, char **argv);
+    static bool argparser_env_derived(const ArgumentParser_t *parser, const Argument_t *argument);
+    static size_t argparser_env_size(const ArgumentParser_t *parser, size_t *capacity);
+    static void argparser_build_env(const ArgumentParser_t *parser, ArgumentEnvEntry_t *table, size_t capacity, char *names);
+    static int argparser_env_store(const ArgumentParser_t *parser, ArgumentResult_t *result, int slot, const char *variable, const char *value);
+    static int argparser_read_env(const ArgumentParser_t *parser, ArgumentResult_t *result);
+#ifdef ARGPARSER_ENABLE_STATS
+    static uint64_t argparser_stats_clock(void);
+#endif
+    static void argparser_format_spec(const Argument_t *argument, char *buf, size_t len);
+    static void argparser_write(ArgumentWriter_t *writer, const char *format, ...);
+    static void argparser_render_usage(const ArgumentParser_t *parser, ArgumentWriter_t *writer);
+    static void argparser_render_help(const ArgumentParser_t *parser, ArgumentWriter_t *writer);
+    static void argparser_emit(const ArgumentParser_t *parser, FILE *stream, ArgumentRender_t render);
+    static bool argparser_cache_help(ArgumentParser_t *parser);
+    static void argparser_invalidate(ArgumentParser_t *parser);
+    static size_t argparser_trie_capacity(const ArgumentParser_t *parser);
+    static int argparser_fill_trie(const ArgumentParser_t *parser, ArgumentTrieNode_t *trie);
+    static bool argparser_build_trie(ArgumentParser_t *parser);
+    static uint32_t argparser_blob_string(ArgumentWriter_t *writer, const char *str);
+    static void argparser_blob_put(ArgumentWriter_t *writer, size_t offset, const void *data, size_t size);
+    static char *argparser_blob_string_at(const unsigned char *blob, uint32_t offset);
+    static bool argparser_blob_fits(size_t size, uint32_t offset, size_t count, size_t item);
+    static bool argparser_blob_has_string(const unsigned char *blob, size_t size, uint32_t offset);
+    static bool argparser_blob_check_trie(const ArgumentTrieNode_t *trie, uint32_t trie_count, uint32_t count);
+    static bool argparser_blob_check(const unsigned char *blob, size_t size);
+    static int argparser_trie_walk(const ArgumentTrieNode_t *trie, const char *key, size_t length);
+    static void argparser_trie_collect(const ArgumentParser_t *parser, int node, const char **names, int max, int *count);
+    static Argument_t *argparser_find_abbrev(const ArgumentParser_t *parser, const ArgumentTrieNode_t *trie, const char *key, size_t length, bool *ambiguous);
+    static const ArgumentTrieNode_t *argparser_result_trie(const ArgumentParser_t *parser, ArgumentResult_t *result);
+
+    //-----------------------------------------------------------------------------
+    // [SECTION] Definations
+    //-----------------------------------------------------------------------------
+
+    static void *argparser_arena_alloc(ArgumentArena_t *arena, size_t size)
+    {
+        ArgumentArenaBlock_t *block = arena->head;
+        void *ptr;
+
+        size = ARGPARSER_ARENA_ROUND(size);
+
+        if (block == NULL || block->size - block->used < size)
+        {
+            size_t block_size = arena->block_size ? arena->block_size * 2 : ARGPARSER_ARENA_BLOCK_SIZE;
+
+            while (block_size < size)
+                block_size *= 2;
+
+            block = (ArgumentArenaBlock_t *)ARGPARSER_MALLOC(ARGPARSER_ARENA_HEADER + block_size);
+            if (block == NULL)
+                return NULL;
+
+            block->next = arena->head;
+            block->size = block_size;
+            block->used = 0;
+            arena->head = block;
+            arena->block_size = block_size;
+#ifdef ARGPARSER_ENABLE_STATS
+            arena->allocations++;
+#endif
+        }
+
+        ptr = (char *)block + ARGPARSER_ARENA_HEADER + block->used;
+        block->used += size;
+        arena->last = ptr;
+#ifdef ARGPARSER_ENABLE_STATS
+        arena->bytes += size;
+#endif
+        return ptr;
+    };
+
+    /* Grows the latest allocation in place when its block has room, copies otherwise. */
+    static void *argparser_arena_realloc(ArgumentArena_t *arena, void *ptr, size_t old_size, size_t new_size)
+    {
+        ArgumentArenaBlock_t *block = arena->head;
+        void *copy;
+
+        if (ptr == NULL)
+            return argparser_arena_alloc(arena, new_size);
+
+        old_size = ARGPARSER_ARENA_ROUND(old_size);
+        new_size = ARGPARSER_ARENA_ROUND(new_size);
+
+        if (ptr == arena->last && block->size - (block->used - old_size) >= new_size)
+        {
+            block->used = block->used - old_size + new_size;
+#ifdef ARGPARSER_ENABLE_STATS
+            arena->bytes += new_size - old_size;
+#endif
+            return ptr;
+        }
+
+        copy = argparser_arena_alloc(arena, new_size);
+        if (copy != NULL)
+            memcpy(copy, ptr, old_size < new_size ? old_size : new_size);
+        return copy;
+    };
+
+    static char *argparser_arena_strdup(ArgumentArena_t *arena, const char *str)
+    {
+        char *copy;
+        size_t size;
+
+        if (str == NULL)
+            return NULL;
+
+        size = strlen(str) + 1;
+        copy = (char *)argparser_arena_alloc(arena, size);
+        if (copy != NULL)
+            memcpy(copy, str, size);
+        return copy;
+    };
+
+    /* Keeps only the newest, largest block so the next parse allocates nothing. */
+    static void argparser_arena_reset(ArgumentArena_t *arena)
+    {
+        ArgumentArenaBlock_t *block = arena->head;
+
+        if (block == NULL)
+            return;
+
+        while (block->next != NULL)
+        {
+            ArgumentArenaBlock_t *next = block->next->next;
+            if (block->next != arena->borrowed)
+                ARGPARSER_FREE(block->next);
+            block->next = next;
+        }
+
+        block->used = 0;
+        arena->last = NULL;
+    };
+
+    static void argparser_arena_release(ArgumentArena_t *arena)
+    {
+        ArgumentArenaBlock_t *block = arena->head;
+
+        while (block != NULL)
+        {
+            ArgumentArenaBlock_t *next = block->next;
+            if (block != arena->borrowed)
+                ARGPARSER_FREE(block);
+            block = next;
+        }
+
+        memset(arena, 0, sizeof(ArgumentArena_t));
+    };
+
+    /* Starts the arena on caller memory, aligned so its data starts on a boundary. */
+    static void argparser_arena_borrow(ArgumentArena_t *arena, void *buffer, size_t size)
+    {
+        size_t skip = (size_t)(-(uintptr_t)buffer & (ARGPARSER_ARENA_ALIGN - 1));
+        ArgumentArenaBlock_t *block;
+
+        if (buffer == NULL || size < skip + ARGPARSER_ARENA_HEADER + ARGPARSER_ARENA_ALIGN)
+            return;
+
+        block = (ArgumentArenaBlock_t *)((char *)buffer + skip);
+        block->next = NULL;
+        block->size = (size - skip - ARGPARSER_ARENA_HEADER) & ~(size_t)(ARGPARSER_ARENA_ALIGN - 1);
+        block->used = 0;
+
+        arena->head = block;
+        arena->block_size = block->size;
+        arena->borrowed = block;
+    };
+
+    /* FNV-1a, keyed on a length so "--name=value" can be hashed without a copy. */
+    static uint32_t argparser_hash(const char *key, size_t length)
+    {
+        uint32_t hash = 2166136261u;
+
+        for (size_t i = 0; i < length; i++)
+        {
+            hash ^= (unsigned char)key[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    };
+
+    /* Keeps the index at most half full once @p keys more keys are inserted. */
+    static bool argparser_index_reserve(ArgumentParser_t *parser, size_t keys)
+    {
+        ArgumentIndexEntry_t *old_index = parser->index;
+        size_t old_capacity = parser->index_capacity;
+        size_t capacity = old_capacity ? old_capacity : ARGPARSER_INDEX_MIN_CAPACITY;
+
+        while ((parser->index_count + keys) * 2 > capacity)
+            capacity *= 2;
+
+        if (capacity == old_capacity && !parser->index_is_static)
+            return true;
+
+        parser->index = (ArgumentIndexEntry_t *)argparser_arena_alloc(&parser->arena, capacity * sizeof(ArgumentIndexEntry_t));
+        if (parser->index == NULL)
+        {
+            parser->index = old_index;
+            return false;
+        }
+        memset(parser->index, 0, capacity * sizeof(ArgumentIndexEntry_t));
+
+        parser->index_capacity = capacity;
+        parser->index_count = 0;
+        parser->index_is_static = false;
+
+        for (size_t i = 0; i < old_capacity; i++)
+        {
+            if (old_index[i].slot != 0)
+                argparser_index_insert(parser, old_index[i].slot - 1, old_index[i].is_dest, old_index[i].hash);
+        }
+        return true;
+    };
+
+    /* hash is that of the name, or of the dest with is_dest. */
+    static void argparser_index_insert(ArgumentParser_t *parser, int slot, bool is_dest, uint32_t hash)
+    {
+        size_t mask = parser->index_capacity - 1;
+        size_t pos = hash & mask;
+
+        while (parser->index[pos].slot != 0)
+            pos = (pos + 1) & mask;
+
+        parser->index[pos].hash = hash;
+        parser->index[pos].slot = slot + 1;
+        parser->index[pos].is_dest = is_dest;
+        parser->index_count++;
+    };
+
+    static Argument_t *argparser_index_find(const ArgumentParser_t *parser, const char *key, size_t length, bool names_only)
+    {
+        return argparser_index_lookup(parser, NULL, key, length, names_only);
+    };
+
+    /* As argparser_index_find(), counting the lookup against the parse owning result when it is not NULL. */
+    static Argument_t *argparser_index_lookup(const ArgumentParser_t *parser, ArgumentResult_t *result, const char *key, size_t length, bool names_only)
+    {
+        return argparser_index_probe(parser, result, key, length, argparser_hash(key, length), names_only);
+    };
+
+    /* As argparser_index_lookup() with the hash of key already known, as for interned keys. */
+    static Argument_t *argparser_index_probe(const ArgumentParser_t *parser, ArgumentResult_t *result, const char *key, size_t length, uint32_t hash, bool names_only)
+    {
+        size_t mask;
+
+        if (result != NULL)
+            ARGPARSER_STAT(result, lookups, 1);
+        if (parser->index == NULL)
+            return NULL;
+
+        mask = parser->index_capacity - 1;
+
+        for (size_t pos = hash & mask; parser->index[pos].slot != 0; pos = (pos + 1) & mask)
+        {
+            const ArgumentIndexEntry_t *entry = &parser->index[pos];
+            Argument_t *argument = &parser->arguments[entry->slot - 1];
+            const char *candidate;
+
+            if (result != NULL)
+                ARGPARSER_STAT(result, probes, 1);
+            if (names_only && entry->is_dest)
+                continue;
+
+            /* A parse compares against its table, leaving the argument itself cold. */
+            if (result != NULL && !entry->is_dest)
+            {
+                const ArgumentHot_t *hot = &result->hot[entry->slot - 1];
+
+                if (hot->hash == hash && hot->length == length && memcmp(hot->name, key, length) == 0)
+                    return argument;
+                continue;
+            }
+
+            if (entry->hash != hash)
+                continue;
+
+            /* An interned key is found by its pointer. */
+            candidate = entry->is_dest ? argument->dest : argument->name;
+            if (candidate == key || (strncmp(candidate, key, length) == 0 && candidate[length] == '\0'))
+                return argument;
+        }
+        return NULL;
+    };
+
+    /*
+     * Returns the pooled copy of str, adding one when there is none yet. borrow
+     * adds str itself, which must then be NUL-terminated and outlive the parser.
+     * NULL stays NULL, as does a copy that is out of memory.
+     */
+    static char *argparser_intern(ArgumentParser_t *parser, const char *str, size_t length, bool borrow, uint32_t *hash)
+    {
+        uint32_t key_hash;
+        ArgumentPoolEntry_t *entry;
+        size_t mask;
+        size_t pos;
+        char *copy;
+
+        if (str == NULL || length > UINT32_MAX)
+            return NULL;
+
+        key_hash = argparser_hash(str, length);
+        if (hash != NULL)
+            *hash = key_hash;
+
+        /* Grows to stay at most half full, moving the entries by their kept hash. */
+        if ((parser->pool_count + 1) * 2 > parser->pool_capacity)
+        {
+            size_t capacity = parser->pool_capacity ? parser->pool_capacity * 2 : ARGPARSER_POOL_MIN_CAPACITY;
+            ArgumentPoolEntry_t *pool = (ArgumentPoolEntry_t *)argparser_arena_alloc(&parser->arena, capacity * sizeof(ArgumentPoolEntry_t));
+
+            if (pool == NULL)
+                return NULL;
+            memset(pool, 0, capacity * sizeof(ArgumentPoolEntry_t));
+
+            for (size_t i = 0; i < parser->pool_capacity; i++)
+            {
+                if (parser->pool[i].str == NULL)
+                    continue;
+                for (pos = parser->pool[i].hash & (capacity - 1); pool[pos].str != NULL; pos = (pos + 1) & (capacity - 1))
+                    ;
+                pool[pos] = parser->pool[i];
+            }
+            parser->pool = pool;
+            parser->pool_capacity = capacity;
+        }
+
+        mask = parser->pool_capacity - 1;
+        for (pos = key_hash & mask; parser->pool[pos].str != NULL; pos = (pos + 1) & mask)
+        {
+            entry = &parser->pool[pos];
+            if (entry->hash == key_hash && entry->length == length && memcmp(entry->str, str, length) == 0)
+                return entry->str;
+        }
+
+        if (borrow)
+            copy = (char *)str;
+        else
+        {
+            copy = (char *)argparser_arena_alloc(&parser->arena, length + 1);
+            if (copy == NULL)
+                return NULL;
+            memcpy(copy, str, length);
+            copy[length] = '\0';
+        }
+
+        entry = &parser->pool[pos];
+        entry->hash = key_hash;
+        entry->length = (uint32_t)length;
+        entry->str = copy;
+        parser->pool_count++;
+        return copy;
+    };
+
+    static bool argparser_grow_arguments(ArgumentParser_t *parser, size_t capacity)
+    {
+        Argument_t *arguments = (Argument_t *)argparser_arena_realloc(&parser->arena, parser->arguments,
+                                                                      (size_t)parser->capacity * sizeof(Argument_t),
+                                                                      capacity * sizeof(Argument_t));
+        if (arguments == NULL)
+            return false;
+
+        parser->arguments = arguments;
+        parser->capacity = (int)capacity;
+        return true;
+    };
+
+    /* Appends a zeroed argument in place and indexes it, any later field is set by the caller. */
+    static Argument_t *argparser_emplace_argument(ArgumentParser_t *parser, char sym, const char *name, int nargs)
+    {
+        Argument_t *argument;
+        bool is_option = sym != '\0';
+        char *key;
+        size_t length;
+        uint32_t name_hash;
+        uint32_t dest_hash;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(name);
+
+        if (parser->is_frozen)
+        {
+            argparser_raise(parser, USAGE, name, "parser is frozen");
+            return NULL;
+        }
+        argparser_invalidate(parser);
+
+        while (*name == parser->prefix_char)
+        {
+            name++;
+            is_option = true;
+        }
+
+        /* Interned first, so a name taken before is found by pointer. */
+        length = strlen(name);
+        key = argparser_intern(parser, name, length, false, &name_hash);
+        if (key == NULL)
+        {
+            argparser_raise(parser, USAGE, name, "out of memory");
+            return NULL;
+        }
+        if (argparser_index_probe(parser, NULL, key, length, name_hash, false) != NULL)
+        {
+            argparser_raise(parser, USAGE, name, "conflicting option string");
+            return NULL;
+        }
+
+        if (sym != '\0' && (sym == parser->prefix_char || argparser_find_sym(parser, sym) != NULL))
+        {
+            char option[3] = {parser->prefix_char, sym, '\0'};
+            argparser_raise(parser, USAGE, option, "conflicting option string");
+            return NULL;
+        }
+
+        if (!argparser_index_reserve(parser, 2) ||
+            (parser->count == parser->capacity && !argparser_grow_arguments(parser, parser->capacity ? 2 * (size_t)parser->capacity : 8)))
+        {
+            argparser_raise(parser, USAGE, name, "out of memory");
+            return NULL;
+        }
+
+        argument = &parser->arguments[parser->count];
+        memset(argument, 0, sizeof(Argument_t));
+
+        argument->type = nargs == 0 ? FLAG : (is_option ? KWARG : ARG);
+        argument->value_type = nargs == 0 ? VALUE_BOOL : VALUE_STRING;
+        argument->default_slot.type = argument->value_type;
+        argument->sym = sym;
+        argument->name = key;
+        argument->dest = key;
+        dest_hash = name_hash;
+        argparser_set_nargs(argument, nargs);
+
+        /* Like Python, "dry-run" is also reachable through the dest "dry_run". */
+        if (memchr(name, '-', length) != NULL)
+        {
+            char *dest = argparser_arena_strdup(&parser->arena, name);
+
+            for (char *c = dest; c != NULL && *c != '\0'; c++)
+            {
+                if (*c == '-')
+                    *c = '_';
+            }
+            argument->dest = argparser_intern(parser, dest, length, true, &dest_hash);
+        }
+
+        if (argument->dest == NULL)
+        {
+            argparser_raise(parser, USAGE, name, "out of memory");
+            return NULL;
+        }
+
+        argparser_register_argument(parser, name_hash, dest_hash);
+        return argument;
+    };
+
+    /* Makes the argument just filled in at position count reachable by symbol, name and dest, their hashes known from interning. */
+    static void argparser_register_argument(ArgumentParser_t *parser, uint32_t name_hash, uint32_t dest_hash)
+    {
+        Argument_t *argument = &parser->arguments[parser->count];
+
+        if (argument->sym != '\0')
+            parser->symbols[(unsigned char)argument->sym] = parser->count + 1;
+
+        argparser_index_insert(parser, parser->count, false, name_hash);
+
+        /* A dest equal to the name is the same interned string. */
+        if (argument->dest != NULL && argument->dest != argument->name &&
+            argparser_index_probe(parser, NULL, argument->dest, strlen(argument->dest), dest_hash, false) == NULL)
+            argparser_index_insert(parser, parser->count, true, dest_hash);
+        parser->count++;
+    };
+
+    static void argparser_set_nargs(Argument_t *argument, int nargs)
+    {
+        argument->count = nargs;
+
+        if (nargs >= 0)
+        {
+            argument->narg_min = (size_t)nargs;
+            argument->narg_max = (size_t)nargs;
+            return;
+        }
+
+        switch ((Nargs)(-1 - nargs))
+        {
+        case OPTIONAL:
+            argument->narg_min = 0;
+            argument->narg_max = 1;
+            break;
+        case ONE_OR_MORE:
+            argument->narg_min = 1;
+            argument->narg_max = ARGPARSER_NARGS_UNBOUNDED;
+            break;
+        case ZERO_OR_MORE:
+            argument->narg_min = 0;
+            argument->narg_max = ARGPARSER_NARGS_UNBOUNDED;
+            break;
+        }
+    };
+
+    static Argument_t *argparser_find_sym(const ArgumentParser_t *parser, char sym)
+    {
+        int slot = parser->symbols[(unsigned char)sym];
+        return slot ? &parser->arguments[slot - 1] : NULL;
+    };
+
+    /* Looks up an argument that is about to be changed. */
+    static Argument_t *argparser_find_mutable(ArgumentParser_t *parser, const char *name)
+    {
+        Argument_t *argument;
+
+        if (parser->is_frozen)
+        {
+            argparser_raise(parser, USAGE, name, "parser is frozen");
+            return NULL;
+        }
+
+        argument = argparser_index_find(parser, name, strlen(name), false);
+        if (argument == NULL)
+            argparser_raise(parser, MAP, name, "unknown argument");
+        else
+            argparser_invalidate(parser);
+        return argument;
+    };
+
+    /* Negative numbers such as "-1" or "-.5" are values, not options. */
+    static bool argparser_is_option(const ArgumentParser_t *parser, const char *token)
+    {
+        if (token[0] != parser->prefix_char || token[1] == '\0')
+            return false;
+        if (token[1] >= '0' && token[1] <= '9')
+            return false;
+        if (token[1] == '.' && token[2] >= '0' && token[2] <= '9')
+            return false;
+        return true;
+    };
+
+#if ARGPARSER_SIMD != ARGPARSER_SIMD_NONE
+#if ARGPARSER_SIMD == ARGPARSER_SIMD_AVX2
+    #define ARGPARSER_SIMD_WIDTH 32
+    #define ARGPARSER_SIMD_BITS 1
+#elif ARGPARSER_SIMD == ARGPARSER_SIMD_SSE2
+    #define ARGPARSER_SIMD_WIDTH 16
+    #define ARGPARSER_SIMD_BITS 1
+#else
+    #define ARGPARSER_SIMD_WIDTH 16
+    #define ARGPARSER_SIMD_BITS 4
+#endif
+
+    /* Masks of the NUL and c bytes of an aligned block, ARGPARSER_SIMD_BITS bits per byte. */
+    ARGPARSER_NO_SANITIZE_ADDRESS static void argparser_scan_block(const char *block, char c, uint64_t *nul, uint64_t *match)
+    {
+#if ARGPARSER_SIMD == ARGPARSER_SIMD_AVX2
+        __m256i bytes = _mm256_load_si256((const __m256i *)block);
+
+        *nul = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_setzero_si256()));
+        *match = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(c)));
+#elif ARGPARSER_SIMD == ARGPARSER_SIMD_SSE2
+        __m128i bytes = _mm_load_si128((const __m128i *)block);
+
+        *nul = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_setzero_si128()));
+        *match = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(c)));
+#else
+        /* NEON has no movemask, narrowing each 16-bit lane by 4 leaves a nibble per byte. */
+        uint8x16_t bytes = vld1q_u8((const uint8_t *)block);
+        uint8x16_t zeros = vceqq_u8(bytes, vdupq_n_u8(0));
+        uint8x16_t seps = vceqq_u8(bytes, vdupq_n_u8((uint8_t)c));
+
+        *nul = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(zeros), 4)), 0);
+        *match = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(seps), 4)), 0);
+#endif
+    };
+#endif
+
+    /* Counts c in the first size bytes of text, a block at a time like argparser_scan_token(). */
+    static size_t argparser_count_char(const char *text, size_t size, char c)
+    {
+        size_t count = 0;
+#if ARGPARSER_SIMD != ARGPARSER_SIMD_NONE
+        const char *end = text + size;
+        const char *block = (const char *)((uintptr_t)text & ~(uintptr_t)(ARGPARSER_SIMD_WIDTH - 1));
+        unsigned skip = (unsigned)(text - block) * ARGPARSER_SIMD_BITS;
+
+        for (; block < end; block += ARGPARSER_SIMD_WIDTH, skip = 0)
+        {
+            size_t tail = (size_t)(end - block) * ARGPARSER_SIMD_BITS;
+            uint64_t nul;
+            uint64_t match;
+
+            argparser_scan_block(block, c, &nul, &match);
+            match = match >> skip << skip;
+            if (tail < 64)
+                match &= ((uint64_t)1 << tail) - 1;
+            count += (size_t)argparser_popcount64(match);
+        }
+        return count / ARGPARSER_SIMD_BITS;
+#else
+        for (size_t i = 0; i < size; i++)
+            count += text[i] == c;
+        return count;
+#endif
+    };
+
+    /* Finds the length and the first '=' in one pass. Blocks are aligned, so a
+       load never crosses into a page the token does not touch. */
+    static void argparser_scan_token(const char *text, size_t *length, size_t *equals)
+    {
+#if ARGPARSER_SIMD != ARGPARSER_SIMD_NONE
+        const char *block = (const char *)((uintptr_t)text & ~(uintptr_t)(ARGPARSER_SIMD_WIDTH - 1));
+        unsigned skip = (unsigned)(text - block) * ARGPARSER_SIMD_BITS;
+        size_t found = (size_t)-1;
+
+        for (;; block += ARGPARSER_SIMD_WIDTH, skip = 0)
+        {
+            uint64_t nul;
+            uint64_t sep;
+
+            argparser_scan_block(block, '=', &nul, &sep);
+            nul = nul >> skip << skip;
+            sep = sep >> skip << skip;
+
+            if (sep != 0 && found == (size_t)-1)
+                found = (size_t)(block - text) + (size_t)(argparser_ctz64(sep) / ARGPARSER_SIMD_BITS);
+            if (nul != 0)
+            {
+                *length = (size_t)(block - text) + (size_t)(argparser_ctz64(nul) / ARGPARSER_SIMD_BITS);
+                *equals = found < *length ? found : *length;
+                return;
+            }
+        }
+#else
+        const char *c = text;
+
+        *equals = (size_t)-1;
+        for (; *c != '\0'; c++)
+        {
+            if (*c == '=' && *equals == (size_t)-1)
+                *equals = (size_t)(c - text);
+        }
+        *length = (size_t)(c - text);
+        if (*equals > *length)
+            *equals = *length;
+#endif
+    };
+
+    static void argparser_classify(const ArgumentParser_t *parser, const char *text, ArgumentToken_t *token)
+    {
+        token->text = text;
+        argparser_scan_token(text, &token->length, &token->equals);
+        token->is_option = argparser_is_option(parser, text);
+
+        if (token->length == 2 && text[0] == '-' && text[1] == '-')
+            token->kind = ARGPARSER_TOKEN_SEPARATOR;
+        else if (!token->is_option)
+            token->kind = ARGPARSER_TOKEN_POSITIONAL;
+        else if (text[1] == parser->prefix_char)
+            token->kind = ARGPARSER_TOKEN_LONG;
+        else
+            token->kind = ARGPARSER_TOKEN_SHORT;
+    };
+
+    static bool argparser_is_multiple(const Argument_t *argument)
+    {
+        if (argument->on_value != NULL)
+            return false;
+        return argument->narg_max > 1 || (argument->is_repeatable && argument->type != FLAG);
+    };
+
+    /* One block: the table, then its flag bitsets, 8-aligned since an entry is 32 bytes. */
+    static size_t argparser_hot_size(const ArgumentParser_t *parser)
+    {
+        return (size_t)parser->count * sizeof(ArgumentHot_t) + ARGPARSER_HOT_FLAGS * ARGPARSER_BITSET_WORDS(parser->count) * sizeof(uint64_t);
+    };
+
+    /* Fills a block of argparser_hot_size() bytes, the hashes copied from the name index. */
+    static void argparser_build_hot(const ArgumentParser_t *parser, ArgumentHot_t *hot)
+    {
+        size_t words = ARGPARSER_BITSET_WORDS(parser->count);
+        uint64_t *flags = (uint64_t *)(hot + parser->count);
+
+        memset(flags, 0, ARGPARSER_HOT_FLAGS * words * sizeof(uint64_t));
+
+        for (int i = 0; i < parser->count; i++)
+        {
+            const Argument_t *argument = &parser->arguments[i];
+            size_t length = strlen(argument->name);
+            uint64_t bit = (uint64_t)1 << (i % 64);
+            uint64_t *word = &flags[i / 64];
+
+            hot[i].name = argument->name;
+            hot[i].length = length > UINT32_MAX ? UINT32_MAX : (uint32_t)length;
+            hot[i].hash = 0;
+            hot[i].narg_min = argument->narg_min > UINT32_MAX ? UINT32_MAX : (uint32_t)argument->narg_min;
+            hot[i].narg_max = argument->narg_max > UINT32_MAX ? UINT32_MAX : (uint32_t)argument->narg_max;
+            hot[i].type = (uint8_t)argument->type;
+            hot[i].value_type = (uint8_t)argument->value_type;
+            hot[i].sym = argument->sym;
+
+            if (argument->is_repeatable)
+                word[ARGPARSER_HOT_REPEATABLE * words] |= bit;
+            if (argparser_is_multiple(argument))
+                word[ARGPARSER_HOT_MULTIPLE * words] |= bit;
+            if (argument->on_value != NULL)
+                word[ARGPARSER_HOT_STREAMED * words] |= bit;
+            if (argument->is_required || (argument->type == ARG && argument->narg_min > 0))
+                word[ARGPARSER_HOT_REQUIRED * words] |= bit;
+            if (argument->type == ARG && argument->narg_min > 1)
+                word[ARGPARSER_HOT_SEVERAL * words] |= bit;
+            if (argument->store_address != NULL || argument->store_offset != 0)
+                word[ARGPARSER_HOT_BOUND * words] |= bit;
+            if (argument->is_exit && (parser->add_help || strcmp(argument->name, "help") != 0))
+                word[ARGPARSER_HOT_EXIT * words] |= bit;
+        }
+
+        for (size_t pos = 0; pos < parser->index_capacity; pos++)
+        {
+            if (parser->index[pos].slot != 0 && !parser->index[pos].is_dest)
+                hot[parser->index[pos].slot - 1].hash = parser->index[pos].hash;
+        }
+    };
+
+    /* Kept on the parser from its first parse, so only a change to the arguments rebuilds it. */
+    static bool argparser_cache_hot(ArgumentParser_t *parser)
+    {
+        if (parser->hot != NULL || parser->count == 0)
+            return true;
+
+        parser->hot = (ArgumentHot_t *)argparser_arena_alloc(&parser->arena, argparser_hot_size(parser));
+        if (parser->hot == NULL)
+            return false;
+
+        argparser_build_hot(parser, parser->hot);
+        parser->flags = (uint64_t *)(parser->hot + parser->count);
+        return true;
+    };
+
+    static bool argparser_hot_flag(const ArgumentResult_t *result, int slot, int flag)
+    {
+        return (result->flags[(size_t)flag * ARGPARSER_BITSET_WORDS(result->count) + (size_t)slot / 64] >> (slot % 64)) & 1;
+    };
+
+    static int argparser_ctz64(uint64_t bits)
+    {
+#if defined(__GNUC__) || ARGPARSER_HAS_BUILTIN(__builtin_ctzll)
+        return __builtin_ctzll(bits);
+#elif ARGPARSER_COMPILER_IS(MSVC) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return (int)index;
+#else
+        int count = 0;
+        while (!(bits & 1))
+        {
+            bits >>= 1;
+            count++;
+        }
+        return count;
+#endif
+    };
+
+    static int argparser_popcount64(uint64_t bits)
+    {
+#if defined(__GNUC__) || ARGPARSER_HAS_BUILTIN(__builtin_popcountll)
+        return __builtin_popcountll(bits);
+#else
+        int count = 0;
+        for (; bits != 0; bits &= bits - 1)
+            count++;
+        return count;
+#endif
+    };
+
+    static int argparser_raise(ArgumentParser_t *parser, ArgumentErrorType type, const char *argument, const char *message)
+    {
+        return argparser_report(parser, NULL, &parser->error, type, argument, message);
+    };
+
+    /* Parsing only reads the parser, so its errors go to the result being filled, in its arena when there is one. */
+    static int argparser_report(const ArgumentParser_t *parser, ArgumentArena_t *arena, ArgumentError_t **error, ArgumentErrorType type, const char *argument, const char *message)
+    {
+        if (type == HELP || type == VERSION)
+        {
+            if (type == VERSION)
+                printf("%s\n", parser->version ? parser->version : "");
+            else if (parser->help != NULL)
+                fwrite(parser->help, 1, parser->help_size, stdout);
+            else
+                argparser_emit(parser, stdout, argparser_render_help);
+            if (parser->exit_on_error)
+                exit(0);
+        }
+        else if (parser->exit_on_error)
+        {
+            argparser_emit(parser, stderr, argparser_render_usage);
+            fprintf(stderr, "%s: error: %s: %s\n", parser->program ? parser->program : "", argument ? argument : "", message);
+            exit(2);
+        }
+
+        if (*error != NULL)
+            argparser_error_delete(*error);
+
+        if (arena != NULL)
+        {
+            *error = argparser_arena_error(arena, type, argument, message);
+            return ARGPARSER_FAILURE;
+        }
+
+        *error = (ArgumentError_t *)ARGPARSER_MALLOC(sizeof(ArgumentError_t));
+        if (*error != NULL)
+            argparser_error_initialize(*error, type, (char *)(argument ? argument : ""), (char *)message);
+
+        return ARGPARSER_FAILURE;
+    };
+
+    /* One allocation: the error, then both strings. Rewound with the next parse. */
+    static ArgumentError_t *argparser_arena_error(ArgumentArena_t *arena, ArgumentErrorType type, const char *argument, const char *message)
+    {
+        size_t argument_size = strlen(argument ? argument : "") + 1;
+        size_t message_size = strlen(message ? message : "") + 1;
+        ArgumentError_t *error = (ArgumentError_t *)argparser_arena_alloc(arena, sizeof(ArgumentError_t) + argument_size + message_size);
+
+        if (error != NULL)
+        {
+            error->type = type;
+            error->argument = (char *)(error + 1);
+            error->message = error->argument + argument_size;
+            error->is_borrowed = true;
+            memcpy(error->argument, argument ? argument : "", argument_size);
+            memcpy(error->message, message ? message : "", message_size);
+        }
+        return error;
+    };
+
+    /* A caller buffer takes the error as is: nothing is printed, allocated or exited. */
+    static int argparser_fail(const ArgumentParser_t *parser, ArgumentResult_t *result, ArgumentErrorType type, const char *argument, const char *message)
+    {
+        if (result->error_buffer == NULL)
+            return argparser_report(parser, &result->arena, &result->error, type, argument, message);
+
+        argparser_error_fill(result->error_buffer, type, argument, message);
+        return ARGPARSER_FAILURE;
+    };
+
+    /* Both strings are truncated so that the message always keeps some room. */
+    static void argparser_error_fill(ArgumentErrorBuffer_t *buffer, ArgumentErrorType type, const char *argument, const char *message)
+    {
+        size_t argument_size = strlen(argument ? argument : "");
+        size_t message_size = strlen(message ? message : "");
+
+        if (argument_size > sizeof(buffer->text) / 4)
+            argument_size = sizeof(buffer->text) / 4;
+        if (message_size > sizeof(buffer->text) - argument_size - 2)
+            message_size = sizeof(buffer->text) - argument_size - 2;
+
+        memcpy(buffer->text, argument ? argument : "", argument_size);
+        buffer->text[argument_size] = '\0';
+        memcpy(buffer->text + argument_size + 1, message ? message : "", message_size);
+        buffer->text[argument_size + 1 + message_size] = '\0';
+
+        buffer->error.type = type;
+        buffer->error.argument = buffer->text;
+        buffer->error.message = buffer->text + argument_size + 1;
+        buffer->error.is_borrowed = true;
+    };
+
+    static int argparser_mark_used(const ArgumentParser_t *parser, ArgumentResult_t *result, int slot, const char *token)
+    {
+        const ArgumentHot_t *hot = &result->hot[slot];
+        ArgumentValue_t *record = &result->values[slot];
+
+        uint64_t bit = (uint64_t)1 << (slot % 64);
+
+        if ((result->used[slot / 64] & bit) && !argparser_hot_flag(result, slot, ARGPARSER_HOT_REPEATABLE))
+            return argparser_fail(parser, result, EXTRA, token, "argument given more than once");
+
+        result->used[slot / 64] |= bit;
+        record->occurrences++;
+
+        if (hot->type == FLAG)
+        {
+            record->slot.type = VALUE_BOOL;
+            record->slot.b = true;
+        }
+        return ARGPARSER_SUCCESS;
+    };
+
+    /* A value always runs to the end of its argv token, so a view is NUL-terminated either way. */
+    static int argparser_store(const ArgumentParser_t *parser, ArgumentResult_t *result, int slot, const char *value, size_t size)
+    {
+        return argparser_store_view(parser, result, slot, value, size, !parser->zero_copy);
+    };
+
+    static int argparser_store_view(const ArgumentParser_t *parser, ArgumentResult_t *result, int slot, const char *value, size_t size, bool copy)
+    {
+        const ArgumentHot_t *hot = &result->hot[slot];
+        ArgumentValue_t *record = &result->values[slot];
+        bool streamed = argparser_hot_flag(result, slot, ARGPARSER_HOT_STREAMED);
+        ArgumentView_t view;
+
+        view.data = value;
+        view.size = size;
+
+        /* Streamed values are only read by the callback, so only the first is copied. */
+        if (copy && (!streamed || record->stored_count == 0))
+        {
+            char *copy = (char *)argparser_arena_alloc(&result->arena, size + 1);
+            if (copy == NULL)
+                return argparser_fail(parser, result, PARSE, hot->name, "out of memory");
+            memcpy(copy, value, size);
+            copy[size] = '\0';
+            view.data = copy;
+        }
+
+        /* Strings need no conversion, so only typed and streamed arguments are read in full. */
+        if (hot->value_type == VALUE_STRING && !streamed)
+        {
+            if (record->stored_count == 0)
+            {
+                record->slot.type = VALUE_STRING;
+                record->slot.str = view;
+            }
+        }
+        else if (parser->lazy_conversion && !streamed)
+            record->is_pending = true;
+        else
+        {
+            const Argument_t *argument = &parser->arguments[slot];
+            ArgumentSlot_t converted_slot;
+            char message[ARGPARSER_MESSAGE_SIZE];
+
+            ARGPARSER_STAT_START(convert);
+            bool converted = argparser_convert(argument, view, &converted_slot, &result->arena, message, sizeof(message));
+
+            ARGPARSER_STAT_STOP(result, convert_ns, convert);
+            ARGPARSER_STAT(result, conversions, 1);
+            if (!converted)
+                return argparser_fail(parser, result, PARSE, hot->name, message);
+            if (streamed && argument->on_value(argument, &converted_slot, argument->on_value_data) != ARGPARSER_SUCCESS)
+                return argparser_fail(parser, result, PARSE, hot->name, "value rejected by callback");
+            if (record->stored_count == 0)
+                record->slot = converted_slot;
+            else if (!streamed && converted_slot.type >= VALUE_INT_LIST && !argparser_append_list(&result->arena, &record->slot.list, &converted_slot.list))
+                return argparser_fail(parser, result, PARSE, hot->name, "out of memory");
+        }
+
+        if (streamed)
+        {
+            if (record->stored_count++ == 0)
+                record->value = view;
+        }
+        else if (argparser_hot_flag(result, slot, ARGPARSER_HOT_MULTIPLE))
+        {
+            size_t count = (size_t)record->stored_count;
+
+            /* values[] holds 4 slots, then doubles whenever it is full. */
+            if (count == 0 || (count >= 4 && (count & (count - 1)) == 0))
+            {
+                size_t capacity = count ? count * 2 : 4;
+                ArgumentView_t *values = (ArgumentView_t *)argparser_arena_realloc(&result->arena, record->values, count * sizeof(ArgumentView_t), capacity * sizeof(ArgumentView_t));
+                if (values == NULL)
+                    return argparser_fail(parser, result, PARSE, hot->name, "out of memory");
+                record->values = values;
+            }
+            record->values[record->stored_count++] = view;
+        }
+        else
+        {
+            record->value = view;
+            record->stored_count = 1;
+        }
+        return ARGPARSER_SUCCESS;
+    };
+
+    /* Maps a file copy-on-write, or reads it into the arena where there is no mmap. */
+    static bool argparser_map(ArgumentArena_t *arena, const char *path, ArgumentMapping_t *mapping, size_t *size, bool *slack)
+    {
+        char *data = NULL;
+
+        *size = 0;
+
+#if ARGPARSER_HAS_MMAP
+        {
+            struct stat info;
+            int fd = open(path, O_RDONLY);
+
+            (void)arena;
+            if (fd < 0)
+                return false;
+            if (fstat(fd, &info) != 0)
+            {
+                close(fd);
+                return false;
+            }
+
+            *size = (size_t)info.st_size;
+            if (*size > 0)
+            {
+                void *map = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                if (map == MAP_FAILED)
+                {
+                    close(fd);
+                    return false;
+                }
+#ifdef POSIX_MADV_SEQUENTIAL
+                posix_madvise(map, *size, POSIX_MADV_SEQUENTIAL);
+#endif
+                data = (char *)map;
+            }
+            close(fd);
+
+            /* The rest of the last page reads as zeros and may be written. */
+            *slack = *size % (size_t)sysconf(_SC_PAGESIZE) != 0;
+        }
+#else
+        {
+            FILE *file = fopen(path, "rb");
+            long length;
+
+            if (file == NULL)
+                return false;
+            if (fseek(file, 0, SEEK_END) != 0 || (length = ftell(file)) < 0 || fseek(file, 0, SEEK_SET) != 0)
+            {
+                fclose(file);
+                return false;
+            }
+
+            *size = (size_t)length;
+            data = (char *)argparser_arena_alloc(arena, *size + 1);
+            if (data == NULL || fread(data, 1, *size, file) != *size)
+            {
+                fclose(file);
+                return false;
+            }
+            fclose(file);
+
+            *slack = true;
+        }
+#endif
+
+        mapping->data = data;
+        mapping->size = ARGPARSER_HAS_MMAP ? *size : 0; /* The arena owns read files. */
+        mapping->next = NULL;
+        return true;
+    };
+
+    static void argparser_unmap(ArgumentMapping_t *mapping)
+    {
+#if ARGPARSER_HAS_MMAP
+        for (; mapping != NULL; mapping = mapping->next)
+        {
+            if (mapping->size > 0)
+                munmap(mapping->data, mapping->size);
+        }
+#else
+        (void)mapping;
+#endif
+    };
+
+    static bool argparser_map_file(ArgumentTokens_t *tokens, const char *path)
+    {
+        ArgumentResult_t *result = tokens->result;
+        ArgumentMapping_t *mapping = (ArgumentMapping_t *)argparser_arena_alloc(&result->arena, sizeof(ArgumentMapping_t));
+        size_t size;
+
+        if (mapping == NULL || !argparser_map(&result->arena, path, mapping, &size, &tokens->file_slack))
+            return false;
+
+        mapping->next = result->mappings;
+        result->mappings = mapping;
+
+        tokens->file = (char *)mapping->data;
+        tokens->file_end = mapping->data ? (char *)mapping->data + size : NULL;
+        return true;
+    };
+
+    static void argparser_unmap_files(ArgumentResult_t *result)
+    {
+        argparser_unmap(result->mappings);
+        result->mappings = NULL;
+    };
+
+    /* Splits the next token off the response file, unquoting and terminating it in place. */
+    static const char *argparser_tokens_scan(ArgumentTokens_t *tokens)
+    {
+        char *c = tokens->file;
+        char *end = tokens->file_end;
+        char *start;
+        char *out;
+        char quote = '\0';
+
+        while (c < end && (*c == ' ' || (*c >= '\t' && *c <= '\r')))
+            c++;
+
+        if (c == end)
+        {
+            tokens->file = NULL;
+            return NULL;
+        }
+
+        start = out = c;
+        for (; c < end; c++)
+        {
+            if (quote != '\0')
+            {
+                if (*c == quote)
+                    quote = '\0';
+                else if (quote == '"' && *c == '\\' && c + 1 < end)
+                    *out++ = *++c;
+                else
+                    *out++ = *c;
+            }
+            else if (*c == '"' || *c == '\'')
+                quote = *c;
+            else if (*c == ' ' || (*c >= '\t' && *c <= '\r'))
+                break;
+            else
+                *out++ = *c;
+        }
+
+        tokens->file = c < end ? c + 1 : end;
+
+        if (out < end || tokens->file_slack)
+        {
+            *out = '\0';
+            return start;
+        }
+
+        /* The last token fills the last page exactly, only it needs a copy. */
+        {
+            size_t size = (size_t)(out - start);
+            char *copy = (char *)argparser_arena_alloc(&tokens->result->arena, size + 1);
+
+            if (copy == NULL)
+            {
+                tokens->failed = true;
+                return NULL;
+            }
+            memcpy(copy, start, size);
+            copy[size] = '\0';
+            return copy;
+        }
+    };
+
+    static const ArgumentToken_t *argparser_tokens_peek(ArgumentTokens_t *tokens)
+    {
+        const ArgumentParser_t *parser = tokens->parser;
+
+        if (tokens->pending != NULL)
+            return &tokens->token;
+
+        ARGPARSER_STAT_START(tokenize);
+
+        while (tokens->pending == NULL && !tokens->failed)
+        {
+            const char *token;
+
+            if (tokens->file != NULL)
+            {
+                tokens->pending = argparser_tokens_scan(tokens);
+                continue;
+            }
+
+            if (tokens->source != NULL)
+            {
+                if ((token = tokens->source(tokens->source_data)) == NULL)
+                    break;
+                tokens->sourced = token;
+            }
+            else if (tokens->index >= tokens->argc)
+                break;
+            else
+                token = tokens->argv[tokens->index++];
+
+            if (parser->fromfile_prefix_char != '\0' && token[0] == parser->fromfile_prefix_char && token[1] != '\0')
+            {
+                if (!argparser_map_file(tokens, token + 1))
+                {
+                    tokens->failed = true;
+                    argparser_fail(parser, tokens->result, PARSE, token, "cannot read response file");
+                }
+                continue;
+            }
+
+            tokens->pending = token;
+        }
+
+        if (tokens->pending != NULL)
+            argparser_classify(parser, tokens->pending, &tokens->token);
+
+        ARGPARSER_STAT_STOP(tokens->result, tokenize_ns, tokenize);
+        ARGPARSER_STAT(tokens->result, tokens, tokens->pending != NULL);
+        return tokens->pending != NULL ? &tokens->token : NULL;
+    };
+
+    /* The token stays valid until the next peek. */
+    static const ArgumentToken_t *argparser_tokens_next(ArgumentTokens_t *tokens)
+    {
+        const ArgumentToken_t *token = argparser_tokens_peek(tokens);
+        tokens->pending = NULL;
+        return token;
+    };
+
+    static int argparser_validate(const ArgumentParser_t *parser, ArgumentResult_t *result)
+    {
+        size_t words = ARGPARSER_BITSET_WORDS(parser->count);
+
+        /* Missing arguments are the required bits not used, plus positionals short of values. */
+        for (size_t w = 0; w < words; w++)
+        {
+            uint64_t missing = result->flags[ARGPARSER_HOT_REQUIRED * words + w] & ~result->used[w];
+
+            /* A value from a config file stands in for an argument not given. */
+            for (uint64_t bits = missing; bits != 0; bits &= bits - 1)
+            {
+                if (parser->arguments[w * 64 + (size_t)argparser_ctz64(bits)].config.data != NULL)
+                    missing &= ~(bits & (~bits + 1));
+            }
+
+            for (uint64_t partial = result->flags[ARGPARSER_HOT_SEVERAL * words + w] & result->used[w]; partial != 0; partial &= partial - 1)
+            {
+                int slot = (int)(w * 64) + argparser_ctz64(partial);
+
+                if ((uint32_t)result->values[slot].stored_count < result->hot[slot].narg_min)
+                    missing |= partial & (~partial + 1);
+            }
+
+            if (missing != 0)
+                return argparser_fail(parser, result, REQUIRED, result->hot[w * 64 + (size_t)argparser_ctz64(missing)].name, "the following argument is required");
+        }
+
+        for (int i = 0; i < parser->group_count; i++)
+        {
+            if (argparser_validate_group(parser, result, &parser->groups[i]) != ARGPARSER_SUCCESS)
+                return ARGPARSER_FAILURE;
+        }
+        return ARGPARSER_SUCCESS;
+    };
+
+    static int argparser_validate_group(const ArgumentParser_t *parser, ArgumentResult_t *result, const ArgumentGroup_t *group)
+    {
+        char message[ARGPARSER_MESSAGE_SIZE];
+        int given = 0;
+        int members = 0;
+        int first_given = -1;
+        int second_given = -1;
+        int first_missing = -1;
+        size_t length = 0;
+
+        for (int w = 0; w < group->words; w++)
+        {
+            uint64_t present = group->mask[w] & result->used[w];
+            uint64_t absent = group->mask[w] & ~result->used[w];
+
+            given += argparser_popcount64(present);
+            members += argparser_popcount64(group->mask[w]);
+
+            if (present != 0 && first_given < 0)
+            {
+                first_given = w * 64 + argparser_ctz64(present);
+                present &= present - 1;
+            }
+            if (present != 0 && second_given < 0)
+                second_given = w * 64 + argparser_ctz64(present);
+            if (absent != 0 && first_missing < 0)
+                first_missing = w * 64 + argparser_ctz64(absent);
+        }
+
+        if (group->type == GROUP_EXCLUSIVE && given > 1)
+        {
+            snprintf(message, sizeof(message), "not allowed with argument %s", result->hot[first_given].name);
+            return argparser_fail(parser, result, VALIDATION, result->hot[second_given].name, message);
+        }
+        if (group->type == GROUP_INCLUSIVE && given > 0 && given < members)
+        {
+            snprintf(message, sizeof(message), "required together with argument %s", result->hot[first_given].name);
+            return argparser_fail(parser, result, VALIDATION, result->hot[first_missing].name, message);
+        }
+        if (!group->is_required || given > 0)
+            return ARGPARSER_SUCCESS;
+
+        if (group->type == GROUP_INCLUSIVE)
+            return argparser_fail(parser, result, VALIDATION, result->hot[first_missing].name, "the following argument is required");
+
+        length = (size_t)snprintf(message, sizeof(message), "one of the arguments is required:");
+        for (int w = 0; w < group->words; w++)
+        {
+            for (uint64_t bits = group->mask[w]; bits != 0 && length < sizeof(message); bits &= bits - 1)
+                length += (size_t)snprintf(message + length, sizeof(message) - length, " %s", result->hot[w * 64 + argparser_ctz64(bits)].name);
+        }
+        return argparser_fail(parser, result, VALIDATION, result->hot[first_missing].name, message);
+    };
+
+    /* Decimal only, like std::from_chars: no whitespace, no base prefix, overflow rejected. */
+    static bool argparser_parse_int(const char *str, size_t size, int64_t *out)
+    {
+        bool negative = size > 0 && str[0] == '-';
+        size_t i = (negative || (size > 0 && str[0] == '+')) ? 1 : 0;
+        uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+        uint64_t value = 0;
+
+        if (i == size)
+            return false;
+
+        for (; i < size; i++)
+        {
+            unsigned digit = (unsigned)(str[i] - '0');
+
+            if (digit > 9 || value > (limit - digit) / 10)
+                return false;
+            value = value * 10 + digit;
+        }
+
+        *out = negative ? (int64_t)(0 - value) : (int64_t)value;
+        return true;
+    };
+
+    /*
+     * Exact fast path for up to 19 significant digits and a small exponent:
+     * the mantissa and the power of ten are both exact doubles, so one
+     * multiplication or division rounds correctly. Anything else goes to strtod.
+     */
+    static bool argparser_parse_double(const char *str, size_t size, double *out)
+    {
+        static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        const char *end = str + size;
+        const char *c = str;
+        bool negative = false;
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int exponent = 0;
+        double value;
+        char *parsed;
+
+        if (c < end && (*c == '-' || *c == '+'))
+            negative = *c++ == '-';
+
+        for (; c < end && *c >= '0' && *c <= '9'; c++, digits++)
+            mantissa = mantissa * 10 + (uint64_t)(*c - '0');
+
+        if (c < end && *c == '.')
+        {
+            for (c++; c < end && *c >= '0' && *c <= '9'; c++, digits++, exponent--)
+                mantissa = mantissa * 10 + (uint64_t)(*c - '0');
+        }
+
+        if (c < end && (*c == 'e' || *c == 'E'))
+        {
+            int64_t power;
+
+            if (c + 1 == end || !argparser_parse_int(c + 1, (size_t)(end - c - 1), &power) || power > 1000 || power < -1000)
+                digits = 0;
+            else
+                exponent += (int)power;
+            c = end;
+        }
+
+        if (c == end && digits > 0 && digits <= 19 && mantissa <= ((uint64_t)1 << 53) && exponent >= -22 && exponent <= 22)
+        {
+            value = (double)mantissa;
+            value = exponent < 0 ? value / powers[-exponent] : value * powers[exponent];
+            *out = negative ? -value : value;
+            return true;
+        }
+
+        /*
+         * Views always end at a NUL, so strtod stops at size at the latest. As
+         * for ints, leading spaces, inf, nan, hex and overflowing values are
+         * refused. Underflow only loses precision, so subnormals are kept.
+         */
+        c = str + (size > 0 && (*str == '-' || *str == '+'));
+        if (c == end || !(*c == '.' || (*c >= '0' && *c <= '9')) || (c[0] == '0' && c + 1 < end && (c[1] == 'x' || c[1] == 'X')))
+            return false;
+        errno = 0;
+        value = strtod(str, &parsed);
+        if (parsed != end || (errno == ERANGE && (value == HUGE_VAL || value == -HUGE_VAL)) || !isfinite(value))
+            return false;
+        *out = value;
+        return true;
+    };
+
+    static bool argparser_parse_bool(const char *str, size_t size, bool *out)
+    {
+        static const char *const names[] = {"false", "true", "no", "yes", "off", "on", "0", "1"};
+
+        for (int i = 0; i < 8; i++)
+        {
+            if (strlen(names[i]) == size && strncmp(names[i], str, size) == 0)
+            {
+                *out = (i & 1) != 0;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    /* Anything strtod() could read as part of a number would split elements apart. */
+    static bool argparser_is_separator(char c)
+    {
+        bool is_alnum = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        return c != '\0' && !is_alnum && c != '+' && c != '-' && c != '.';
+    };
+
+    /*
+     * Reads the leading digits of the 8 bytes at str in a few multiplications:
+     * the digits are shifted to the top of the word, then pairs, quads and
+     * octets of them are folded together. Returns how many digits there were.
+     */
+    static int argparser_swar_digits(const char *str, uint32_t *value)
+    {
+        const unsigned char *bytes = (const unsigned char *)str;
+        uint64_t chunk = 0;
+        uint64_t invalid;
+        int digits;
+
+        /* Compilers fold these into one little-endian load. */
+        for (int i = 0; i < 8; i++)
+            chunk |= (uint64_t)bytes[i] << (8 * i);
+
+        /* A byte is a digit when both it and itself plus 6 have 0x3 as their high nibble. */
+        invalid = ((chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ^ 0x3333333333333333;
+        digits = invalid ? argparser_ctz64(invalid) / 8 : 8;
+        if (digits == 0)
+            return 0;
+
+        chunk <<= 8 * (8 - digits);
+        chunk = ((chunk & 0x0F0F0F0F0F0F0F0F) * 2561) >> 8;
+        chunk = ((chunk & 0x00FF00FF00FF00FF) * 6553601) >> 16;
+        *value = (uint32_t)(((chunk & 0x0000FFFF0000FFFF) * 42949672960001) >> 32);
+        return digits;
+    };
+
+    /* One list element, whose bytes up to limit are readable. Up to 8 digits take the SWAR path. */
+    static bool argparser_parse_element_int(const char *str, size_t size, const char *limit, int64_t *out)
+    {
+        size_t sign = size > 0 && (str[0] == '-' || str[0] == '+');
+        uint32_t value;
+
+        if (size > sign && size - sign <= 8 && limit - (str + sign) >= 8)
+        {
+            if (argparser_swar_digits(str + sign, &value) != (int)(size - sign))
+                return false;
+            *out = str[0] == '-' ? -(int64_t)value : (int64_t)value;
+            return true;
+        }
+        return argparser_parse_int(str, size, out);
+    };
+
+    /* As argparser_parse_element_int(), for "digits.digits" with at most 8 of each. */
+    static bool argparser_parse_element_double(const char *str, size_t size, const char *limit, double *out)
+    {
+        static const uint32_t scales[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+        const char *end = str + size;
+        const char *c = str + (size > 0 && (str[0] == '-' || str[0] == '+'));
+        uint32_t whole = 0;
+        uint32_t fraction = 0;
+        int whole_digits;
+        int fraction_digits = 0;
+
+        if (end - c > 17 || limit - c < 8)
+            return argparser_parse_double(str, size, out);
+
+        whole_digits = argparser_swar_digits(c, &whole);
+        c += whole_digits;
+        if (c < end && *c == '.' && limit - (c + 1) >= 8)
+        {
+            fraction_digits = argparser_swar_digits(c + 1, &fraction);
+            c += 1 + fraction_digits;
+        }
+
+        if (c == end && whole_digits + fraction_digits > 0)
+        {
+            /* Below 2^53 the mantissa is exact, so one division rounds correctly. */
+            uint64_t mantissa = (uint64_t)whole * scales[fraction_digits] + fraction;
+
+            if (mantissa <= ((uint64_t)1 << 53))
+            {
+                double value = (double)mantissa / (double)scales[fraction_digits];
+                *out = str[0] == '-' ? -value : value;
+                return true;
+            }
+        }
+        return argparser_parse_double(str, size, out);
+    };
+
+    /* Elements are counted first, so a list takes one exact allocation. */
+    static bool argparser_convert_list(const Argument_t *argument, ArgumentView_t view, ArgumentSlot_t *slot, ArgumentArena_t *arena, char *message, size_t size)
+    {
+        char separator = argument->separator ? argument->separator : ',';
+        bool is_int = argument->value_type == VALUE_INT_LIST;
+        size_t count = argparser_count_char(view.data, view.size, separator) + 1;
+        const char *end = view.data + view.size;
+        const char *element = view.data;
+
+        slot->list.count = 0;
+        slot->list.ints = (int64_t *)argparser_arena_alloc(arena, count * (is_int ? sizeof(int64_t) : sizeof(double)));
+        if (slot->list.ints == NULL)
+        {
+            snprintf(message, size, "out of memory");
+            return false;
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const char *next = (const char *)memchr(element, separator, (size_t)(end - element));
+            size_t length = next ? (size_t)(next - element) : (size_t)(end - element);
+            bool converted = is_int ? argparser_parse_element_int(element, length, end + 1, &slot->list.ints[i])
+                                    : argparser_parse_element_double(element, length, end + 1, &slot->list.doubles[i]);
+
+            if (!converted)
+            {
+                snprintf(message, size, "invalid %s value '%.*s'", is_int ? "int" : "double", (int)length, element);
+                return false;
+            }
+            element += length + 1;
+        }
+
+        slot->list.count = count;
+        return true;
+    };
+
+    /* Both element types are 8 bytes, so the copy does not depend on which one. */
+    static bool argparser_append_list(ArgumentArena_t *arena, ArgumentList_t *list, const ArgumentList_t *tail)
+    {
+        int64_t *ints = (int64_t *)argparser_arena_realloc(arena, list->ints, list->count * sizeof(int64_t), (list->count + tail->count) * sizeof(int64_t));
+
+        if (ints == NULL)
+            return false;
+        memcpy(ints + list->count, tail->ints, tail->count * sizeof(int64_t));
+        list->ints = ints;
+        list->count += tail->count;
+        return true;
+    };
+
+    /* On failure, describes the rejected value in message. Lists are allocated in arena. */
+    static bool argparser_convert(const Argument_t *argument, ArgumentView_t view, ArgumentSlot_t *slot, ArgumentArena_t *arena, char *message, size_t size)
+    {
+        static const char *const names[] = {"string", "int", "double", "bool", "choice"};
+        bool converted = true;
+
+        slot->type = argument->value_type;
+
+        switch (argument->value_type)
+        {
+        case VALUE_STRING:
+            slot->str = view;
+            break;
+        case VALUE_INT:
+            converted = argparser_parse_int(view.data, view.size, &slot->i);
+            break;
+        case VALUE_DOUBLE:
+            converted = argparser_parse_double(view.data, view.size, &slot->d);
+            break;
+        case VALUE_BOOL:
+            converted = argparser_parse_bool(view.data, view.size, &slot->b);
+            break;
+        case VALUE_ENUM:
+            converted = false;
+            for (int i = 0; i < argument->choice_count && !converted; i++)
+            {
+                if (strlen(argument->choices[i]) == view.size && strncmp(argument->choices[i], view.data, view.size) == 0)
+                {
+                    slot->choice = i;
+                    converted = true;
+                }
+            }
+            break;
+        case VALUE_INT_LIST:
+        case VALUE_DOUBLE_LIST:
+            return argparser_convert_list(argument, view, slot, arena, message, size);
+        }
+
+        if (!converted)
+            snprintf(message, size, "invalid %s value '%.*s'", names[argument->value_type], (int)view.size, view.data);
+        return converted;
+    };
+
+    static int argparser_apply_default(ArgumentParser_t *parser, Argument_t *argument)
+    {
+        char message[ARGPARSER_MESSAGE_SIZE];
+        ArgumentView_t view;
+        int status;
+
+        /* The config value was converted as the argument was before. */
+        argument->is_config_converted = false;
+        status = argparser_convert_config(parser, argument);
+
+        memset(&argument->default_slot, 0, sizeof(ArgumentSlot_t));
+        argument->default_slot.type = argument->value_type;
+        if (argument->value_type == VALUE_ENUM)
+            argument->default_slot.choice = -1;
+
+        if (argument->default_value == NULL)
+            return status;
+
+        view.data = (const char *)argument->default_value;
+        view.size = strlen(view.data);
+        if (!argparser_convert(argument, view, &argument->default_slot, &parser->arena, message, sizeof(message)))
+            return argparser_raise(parser, PARSE, argument->name, message);
+        return status;
+    };
+
+    /* A flag has its slot set when seen, other arguments once a value was stored. */
+    static const ArgumentSlot_t *argparser_slot_of(const ArgumentParser_t *parser, const Argument_t *argument, const ArgumentValue_t *record)
+    {
+        if (record->occurrences > 0 && (record->stored_count > 0 || argument->type == FLAG))
+            return &record->slot;
+        if (argument->config.data != NULL)
+            return argparser_config_slot(parser, argument);
+        return &argument->default_slot;
+    };
+
+    /* Loading and every change of type convert the value, this only covers fields written directly. */
+    static const ArgumentSlot_t *argparser_config_slot(const ArgumentParser_t *parser, const Argument_t *argument)
+    {
+        char message[ARGPARSER_MESSAGE_SIZE];
+        Argument_t *cache = (Argument_t *)argument;
+
+        if (!argument->is_config_converted)
+        {
+            if (!argparser_convert(argument, argument->config, &cache->config_slot, &((ArgumentParser_t *)parser)->arena, message, sizeof(message)))
+                cache->config_slot = argument->default_slot;
+            cache->is_config_converted = true;
+        }
+        return &argument->config_slot;
+    };
+
+    /* Drops a value that does not convert, so the argument reads as its default. */
+    static int argparser_convert_config(ArgumentParser_t *parser, Argument_t *argument)
+    {
+        char message[ARGPARSER_MESSAGE_SIZE];
+
+        if (argument->config.data == NULL || argument->is_config_converted)
+            return ARGPARSER_SUCCESS;
+
+        if (!argparser_convert(argument, argument->config, &argument->config_slot, &parser->arena, message, sizeof(message)))
+        {
+            argument->config.data = NULL;
+            argument->config.size = 0;
+            memset(&argument->config_slot, 0, sizeof(ArgumentSlot_t));
+            return argparser_raise(parser, PARSE, argument->name, message);
+        }
+        argument->is_config_converted = true;
+        return ARGPARSER_SUCCESS;
+    };
+
+    static int64_t argparser_slot_int(const ArgumentParser_t *parser, const Argument_t *argument, const ArgumentValue_t *record)
+    {
+        const ArgumentSlot_t *slot = argparser_slot_of(parser, argument, record);
+
+        if (argument->type == FLAG && record->occurrences > 0)
+            return record->occurrences;
+
+        switch (slot->type)
+        {
+        case VALUE_INT:
+            return slot->i;
+        case VALUE_DOUBLE:
+            return (int64_t)slot->d;
+        case VALUE_BOOL:
+            return slot->b;
+        case VALUE_ENUM:
+            return slot->choice;
+        default:
+            return 0;
+        }
+    };
+
+    static double argparser_slot_double(const ArgumentParser_t *parser, const Argument_t *argument, const ArgumentValue_t *record)
+    {
+        const ArgumentSlot_t *slot = argparser_slot_of(parser, argument, record);
+        return slot->type == VALUE_DOUBLE ? slot->d : (double)argparser_slot_int(parser, argument, record);
+    };
+
+    /* NULL for unknown arguments, other types and empty lists. */
+    static const ArgumentList_t *argparser_list_of(const ArgumentParser_t *parser, const ArgumentResult_t *result, const char *name, ArgumentValueType type)
+    {
+        Argument_t *argument = argparser_index_find(parser, name, strlen(name), false);
+        const ArgumentSlot_t *slot = argument ? argparser_slot_of(parser, argument, argparser_converted_of(parser, result, argument)) : NULL;
+        return slot && slot->type == type && slot->list.count > 0 ? &slot->list : NULL;
+    };
+
+    /* Arguments added after the result was filled read as not given. */
+    static const ArgumentValue_t *argparser_record_of(const ArgumentParser_t *parser, const ArgumentResult_t *result, const Argument_t *argument)
+    {
+        static ArgumentValue_t unused;
+        int slot = (int)(argument - parser->arguments);
+
+        return slot < result->count ? &result->values[slot] : &unused;
+    };
+
+    /* The record with its slot converted, which lazy_conversion leaves to the first typed read. */
+    static const ArgumentValue_t *argparser_converted_of(const ArgumentParser_t *parser, const ArgumentResult_t *result, const Argument_t *argument)
+    {
+        ArgumentValue_t *record = (ArgumentValue_t *)argparser_record_of(parser, result, argument);
+        ArgumentResult_t *cache = (ArgumentResult_t *)result;
+        const ArgumentView_t *views;
+        ArgumentSlot_t tail;
+        char message[ARGPARSER_MESSAGE_SIZE];
+        bool converted;
+
+        if (!record->is_pending)
+            return record;
+
+        ARGPARSER_STAT_START(convert);
+        views = argparser_is_multiple(argument) ? record->values : &record->value;
+        converted = argparser_convert(argument, views[0], &record->slot, &cache->arena, message, sizeof(message));
+
+        /* As when parsing, later values only extend a list. */
+        for (int i = 1; converted && record->slot.type >= VALUE_INT_LIST && i < record->stored_count; i++)
+            converted = argparser_convert(argument, views[i], &tail, &cache->arena, message, sizeof(message)) && argparser_append_list(&cache->arena, &record->slot.list, &tail.list);
+
+        ARGPARSER_STAT_STOP(cache, convert_ns, convert);
+        ARGPARSER_STAT(cache, conversions, record->stored_count);
+        /* Reported like a parse error, after the parse succeeded. */
+        if (!converted)
+        {
+            record->slot = argument->default_slot;
+            record->is_invalid = true;
+            if (cache->error != NULL)
+                argparser_error_delete(cache->error);
+            cache->error = argparser_arena_error(&cache->arena, PARSE, argument->name, message);
+        }
+        record->is_pending = false;
+        return record;
+    };
+
+    static const char *argparser_value_of(const Argument_t *argument, const ArgumentValue_t *record)
+    {
+        if (record->occurrences == 0)
+            return argument->config.data != NULL ? argument->config.data : (const char *)argument->default_value;
+        if (record->stored_count == 0)
+            return argument->implicit_value ? (const char *)argument->implicit_value : "true";
+        if (argparser_is_multiple(argument))
+            return record->values[0].data;
+        return record->value.data;
+    };
+
+    /* A flag of the default type is a bool, integers and doubles may be narrower than 64 bits. */
+    static bool argparser_store_fits(const Argument_t *argument, size_t size)
+    {
+        if (argument->type == FLAG && argument->value_type == VALUE_STRING)
+            return size == sizeof(bool);
+
+        switch (argument->value_type)
+        {
+        case VALUE_STRING:
+            return size == sizeof(const char *);
+        case VALUE_INT:
+        case VALUE_ENUM:
+            return size == 1 || size == 2 || size == 4 || size == 8;
+        case VALUE_DOUBLE:
+            return size == sizeof(float) || size == sizeof(double);
+        case VALUE_BOOL:
+            return size == sizeof(bool);
+        default:
+            return size == sizeof(ArgumentList_t);
+        }
+    };
+
+    static void argparser_store_value(const ArgumentParser_t *parser, const Argument_t *argument, const ArgumentValue_t *record, void *destination)
+    {
+        size_t size = argument->store_size;
+
+        if (!argparser_store_fits(argument, size))
+            return;
+
+        if ((argument->type == FLAG && argument->value_type == VALUE_STRING) || argument->value_type == VALUE_BOOL)
+        {
+            bool value = argparser_slot_int(parser, argument, record) != 0;
+            memcpy(destination, &value, sizeof(bool));
+        }
+        else if (argument->value_type == VALUE_STRING)
+        {
+            const char *value = argparser_value_of(argument, record);
+            memcpy(destination, &value, sizeof(const char *));
+        }
+        else if (argument->value_type == VALUE_DOUBLE)
+        {
+            double value = argparser_slot_double(parser, argument, record);
+            float narrow = (float)value;
+
+            memcpy(destination, size == sizeof(float) ? (const void *)&narrow : (const void *)&value, size);
+        }
+        else if (argument->value_type == VALUE_INT || argument->value_type == VALUE_ENUM)
+        {
+            int64_t value = argparser_slot_int(parser, argument, record);
+            int8_t i8 = (int8_t)value;
+            int16_t i16 = (int16_t)value;
+            int32_t i32 = (int32_t)value;
+
+            memcpy(destination, size == 1 ? (const void *)&i8 : size == 2 ? (const void *)&i16 : size == 4 ? (const void *)&i32 : (const void *)&value, size);
+        }
+        else
+            memcpy(destination, &argparser_slot_of(parser, argument, record)->list, sizeof(ArgumentList_t));
+    };
+
+    /*
+     * Runs after a successful parse, so a rejected command line leaves the
+     * destinations alone. The values lazy_conversion left are converted
+     * first, and one that is rejected fails the parse before any store.
+     */
+    static int argparser_store_bound(const ArgumentParser_t *parser, ArgumentResult_t *result)
+    {
+        for (int i = 0; i < result->count; i++)
+        {
+            const Argument_t *argument = &parser->arguments[i];
+
+            if (argparser_hot_flag(result, i, ARGPARSER_HOT_BOUND) && argparser_converted_of(parser, result, argument)->is_invalid)
+            {
+                const ArgumentError_t *error = result->error;
+
+                result->error = NULL;
+                return argparser_fail(parser, result, PARSE, argument->name, error ? error->message : "invalid value");
+            }
+        }
+
+        for (int i = 0; i < result->count; i++)
+        {
+            const Argument_t *argument = &parser->arguments[i];
+            const ArgumentValue_t *record = &result->values[i];
+
+            if (!argparser_hot_flag(result, i, ARGPARSER_HOT_BOUND) || (record->occurrences == 0 && argument->default_value == NULL && argument->config.data == NULL))
+                continue;
+            if (argument->store_address != NULL)
+                argparser_store_value(parser, argument, record, argument->store_address);
+            else if (result->target != NULL)
+                argparser_store_value(parser, argument, record, (char *)result->target + argument->store_offset - 1);
+        }
+        return ARGPARSER_SUCCESS;
+    };
+
+    static void argparser_format_spec(const Argument_t *argument, char *buf, size_t len)
+    {
+        if (argument->type == ARG)
+            snprintf(buf, len, "%s", argument->name);
+        else if (argument->sym != '\0')
+            snprintf(buf, len, "-%c,--%s", argument->sym, argument->name);
+        else
+            snprintf(buf, len, "--%s", argument->name);
+    };
+
+    static void argparser_write(ArgumentWriter_t *writer, const char *format, ...)
+    {
+        size_t room = writer->length < writer->capacity ? writer->capacity - writer->length : 0;
+        va_list args;
+        int n;
+
+        va_start(args, format);
+        n = vsnprintf(room ? writer->data + writer->length : NULL, room, format, args);
+        va_end(args);
+
+        if (n > 0)
+            writer->length += (size_t)n;
+    };
+
+    static void argparser_render_usage(const ArgumentParser_t *parser, ArgumentWriter_t *writer)
+    {
+        if (parser->usage != NULL)
+        {
+            argparser_write(writer, "Usage: %s\n", parser->usage);
+            return;
+        }
+
+        argparser_write(writer, "Usage: %s", parser->program ? parser->program : "");
+        for (int i = 0; i < parser->count; i++)
+        {
+            const Argument_t *argument = &parser->arguments[i];
+            const char *metavar = argument->metavar ? argument->metavar : argument->name;
+            bool optional = argument->type == ARG ? argument->narg_min == 0 : !argument->is_required;
+
+            if (argument->is_hidden)
+                continue;
+
+            argparser_write(writer, optional ? " [" : " ");
+            if (argument->type == ARG)
+                argparser_write(writer, "%s", argument->name);
+            else if (argument->sym != '\0')
+                argparser_write(writer, "-%c", argument->sym);
+            else
+                argparser_write(writer, "--%s", argument->name);
+            if (argument->type == KWARG)
+                argparser_write(writer, " %s", metavar);
+            if (argument->narg_max == ARGPARSER_NARGS_UNBOUNDED)
+                argparser_write(writer, "...");
+            if (optional)
+                argparser_write(writer, "]");
+        }
+        if (parser->subcommand_count > 0)
+            argparser_write(writer, " <command> ...");
+        argparser_write(writer, "\n");
+    };
+
+    static void argparser_render_help(const ArgumentParser_t *parser, ArgumentWriter_t *writer)
+    {
+        char spec[ARGPARSER_MESSAGE_SIZE];
+        int width = 0;
+
+        for (int i = 0; i < parser->count; i++)
+        {
+            argparser_format_spec(&parser->arguments[i], spec, sizeof(spec));
+            if ((int)strlen(spec) > width)
+                width = (int)strlen(spec);
+        }
+
+        if (parser->description != NULL)
+            argparser_write(writer, "%s\n", parser->description);
+        argparser_render_usage(parser, writer);
+
+        for (int pass = 0; pass < 2; pass++)
+        {
+            if (pass == 1)
+                argparser_write(writer, "\nOptions:\n");
+
+            for (int i = 0; i < parser->count; i++)
+            {
+                const Argument_t *argument = &parser->arguments[i];
+
+                if (argument->is_hidden || (argument->type == ARG) != (pass == 0))
+                    continue;
+
+                argparser_format_spec(argument, spec, sizeof(spec));
+                argparser_write(writer, "  %*s : %s", width, spec, argument->help ? argument->help : "");
+
+                if (argument->choice_count > 0 || argument->default_value != NULL || argument->is_required)
+                {
+                    const char *separator = " [";
+
+                    if (argument->choice_count > 0)
+                    {
+                        argparser_write(writer, "%sallowed: <", separator);
+                        for (int c = 0; c < argument->choice_count; c++)
+                            argparser_write(writer, c ? ", %s" : "%s", argument->choices[c]);
+                        argparser_write(writer, ">");
+                        separator = ", ";
+                    }
+                    if (argument->default_value != NULL)
+                    {
+                        argparser_write(writer, "%sdefault: %s", separator, (const char *)argument->default_value);
+                        separator = ", ";
+                    }
+                    if (argument->is_required)
+                        argparser_write(writer, "%srequired", separator);
+                    argparser_write(writer, "]");
+                }
+                argparser_write(writer, "\n");
+            }
+        }
+
+        if (parser->subcommand_count > 0)
+        {
+            width = 0;
+            for (int i = 0; i < parser->subcommand_count; i++)
+            {
+                if ((int)strlen(parser->subcommands[i].name) > width)
+                    width = (int)strlen(parser->subcommands[i].name);
+            }
+
+            argparser_write(writer, "\nCommands:\n");
+            for (int i = 0; i < parser->subcommand_count; i++)
+                argparser_write(writer, "  %*s : %s\n", width, parser->subcommands[i].name, parser->subcommands[i].help ? parser->subcommands[i].help : "");
+        }
+
+        if (parser->epilog != NULL)
+            argparser_write(writer, "\n%s\n", parser->epilog);
+    };
+
+    /* Renders into a stack buffer, or a heap one sized by a first pass, then writes once. */
+    static void argparser_emit(const ArgumentParser_t *parser, FILE *stream, ArgumentRender_t render)
+    {
+        char small[1024];
+        ArgumentWriter_t writer;
+
+        writer.data = small;
+        writer.capacity = sizeof(small);
+        writer.length = 0;
+        render(parser, &writer);
+
+        if (writer.length >= sizeof(small))
+        {
+            char *data = (char *)ARGPARSER_MALLOC(writer.length + 1);
+
+            if (data != NULL)
+            {
+                writer.data = data;
+                writer.capacity = writer.length + 1;
+                writer.length = 0;
+                render(parser, &writer);
+                fwrite(data, 1, writer.length, stream);
+                ARGPARSER_FREE(data);
+                return;
+            }
+            writer.length = sizeof(small) - 1;
+        }
+        fwrite(small, 1, writer.length, stream);
+    };
+
+    static bool argparser_cache_help(ArgumentParser_t *parser)
+    {
+        ArgumentWriter_t writer;
+
+        if (parser->help != NULL)
+            return true;
+
+        writer.data = NULL;
+        writer.capacity = 0;
+        writer.length = 0;
+        argparser_render_help(parser, &writer);
+
+        writer.data = (char *)argparser_arena_alloc(&parser->arena, writer.length + 1);
+        if (writer.data == NULL)
+            return false;
+        writer.capacity = writer.length + 1;
+        writer.length = 0;
+        argparser_render_help(parser, &writer);
+
+        parser->help = writer.data;
+        parser->help_size = writer.length;
+        return true;
+    };
+
+    /* The tables live in the parser arena, so dropping them frees nothing until argparser_delete(). */
+    static void argparser_invalidate(ArgumentParser_t *parser)
+    {
+        parser->help = NULL;
+        parser->help_size = 0;
+
+        parser->trie = NULL;
+        parser->trie_count = 0;
+        parser->tables_are_static = false;
+
+        parser->hot = NULL;
+        parser->flags = NULL;
+
+        parser->env = NULL;
+        parser->env_capacity = 0;
+    };
+
+    /* One node per character at most, so the array is sized once up front. */
+    static size_t argparser_trie_capacity(const ArgumentParser_t *parser)
+    {
+        size_t capacity = 1;
+
+        for (int i = 0; i < parser->count; i++)
+        {
+            if (parser->arguments[i].type != ARG)
+                capacity += strlen(parser->arguments[i].name);
+        }
+        return capacity;
+    };
+
+    /* Returns the number of nodes used. */
+    static int argparser_fill_trie(const ArgumentParser_t *parser, ArgumentTrieNode_t *trie)
+    {
+        int count = 1;
+
+        memset(&trie[0], 0, sizeof(ArgumentTrieNode_t));
+        trie[0].slot = -1;
+        trie[0].first = -1;
+
+        for (int i = 0; i < parser->count; i++)
+        {
+            const Argument_t *argument = &parser->arguments[i];
+            int node = 0;
+
+            if (argument->type == ARG)
+                continue;
+
+            if (trie[0].count++ == 0)
+                trie[0].first = i;
+
+            for (const char *c = argument->name; *c != '\0'; c++)
+            {
+                int *link = &trie[node].child;
+
+                while (*link != 0 && trie[*link].c < *c)
+                    link = &trie[*link].sibling;
+
+                if (*link == 0 || trie[*link].c != *c)
+                {
+                    ArgumentTrieNode_t *added = &trie[count];
+
+                    added->child = 0;
+                    added->sibling = *link;
+                    added->slot = -1;
+                    added->first = -1;
+                    added->count = 0;
+                    added->c = *c;
+                    *link = count++;
+                }
+
+                node = *link;
+                if (trie[node].count++ == 0)
+                    trie[node].first = i;
+            }
+            trie[node].slot = i;
+        }
+        return count;
+    };
+
+    static bool argparser_build_trie(ArgumentParser_t *parser)
+    {
+        ArgumentTrieNode_t *trie;
+
+        if (parser->trie != NULL)
+            return true;
+
+        trie = (ArgumentTrieNode_t *)argparser_arena_alloc(&parser->arena, argparser_trie_capacity(parser) * sizeof(ArgumentTrieNode_t));
+        if (trie == NULL)
+            return false;
+
+        parser->trie_count = argparser_fill_trie(parser, trie);
+        parser->trie = trie;
+        return true;
+    };
+
+    /* Returns the node reached by the key, or -1 when no name starts with it. */
+    static int argparser_trie_walk(const ArgumentTrieNode_t *trie, const char *key, size_t length)
+    {
+        int node = 0;
+
+        for (size_t i = 0; i < length; i++)
+        {
+            int child = trie[node].child;
+
+            while (child != 0 && trie[child].c < key[i])
+                child = trie[child].sibling;
+
+            if (child == 0 || trie[child].c != key[i])
+                return -1;
+            node = child;
+        }
+        return node;
+    };
+
+    static void argparser_trie_collect(const ArgumentParser_t *parser, int node, const char **names, int max, int *count)
+    {
+        const ArgumentTrieNode_t *trie = parser->trie;
+
+        if (trie[node].slot >= 0 && !parser->arguments[trie[node].slot].is_hidden)
+        {
+            if (*count < max)
+                names[*count] = parser->arguments[trie[node].slot].name;
+            ++*count;
+        }
+
+        for (int child = trie[node].child; child != 0; child = trie[child].sibling)
+            argparser_trie_collect(parser, child, names, max, count);
+    };
+
+    /* An exact name always wins, otherwise the prefix must be shared by a single name. */
+    static Argument_t *argparser_find_abbrev(const ArgumentParser_t *parser, const ArgumentTrieNode_t *trie, const char *key, size_t length, bool *ambiguous)
+    {
+        int node = argparser_trie_walk(trie, key, length);
+
+        *ambiguous = false;
+
+        if (node <= 0)
+            return NULL;
+        if (trie[node].slot >= 0)
+            return &parser->arguments[trie[node].slot];
+
+        *ambiguous = trie[node].count > 1;
+        return *ambiguous ? NULL : &parser->arguments[trie[node].first];
+    };
+
+    /* A parser that was never frozen has no trie of its own, and may be shared
+       by argparser_parse_into(), so each parse builds one in its arena. */
+    static const ArgumentTrieNode_t *argparser_result_trie(const ArgumentParser_t *parser, ArgumentResult_t *result)
+    {
+        ArgumentTrieNode_t *trie;
+
+        if (result->trie != NULL)
+            return result->trie;
+
+        trie = (ArgumentTrieNode_t *)argparser_arena_alloc(&result->arena, argparser_trie_capacity(parser) * sizeof(ArgumentTrieNode_t));
+        if (trie == NULL)
+            return NULL;
+
+        argparser_fill_trie(parser, trie);
+        ARGPARSER_STAT(result, trie_builds, 1);
+        result->trie = trie;
+        return trie;
+    };
+
+#ifdef ARGPARSER_ENABLE_STATS
+    /* Monotonic where POSIX exposes it, the C11 wall clock otherwise. */
+    static uint64_t argparser_stats_clock(void)
+    {
+        struct timespec ts;
+
+#if defined(CLOCK_MONOTONIC)
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+        timespec_get(&ts, TIME_UTC);
+#endif
+        return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+    };
+#endif
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#pragma endregion // C
+
+//-----------------------------------------------------------------------------
+// [SECTION] C++ Only Classes
+//-----------------------------------------------------------------------------
+
+#pragma region Cpp
+
+#ifdef __cplusplus
+
+namespace argparser
+{
+
+    //-----------------------------------------------------------------------------
+    // [SECTION] Declarations
+    //-----------------------------------------------------------------------------
+
+    //-----------------------------------------------------------------------------
+    // [SECTION] Definations
+    //-----------------------------------------------------------------------------
+
+    Argument::Argument(ArgumentParser_t *parser, char sym, const char *name)
+        : m_Parser(parser)
+    {
+        Argument_t *argument = argparser_emplace_argument(parser, sym, name, 1);
+
+        if (argument == NULL)
+        {
+            ArgumentError_t *error = parser->error;
+            parser->error = NULL;
+            throw UsageError(error);
+        }
+
+        m_Slot = (int)(argument - parser->arguments);
+    };
+
+    /* Threads may be reading a frozen parser, so the error is not stored on it. */
+    void Argument::check() const
+    {
+        if (m_Parser->is_frozen)
+        {
+            ArgumentError_t *error = (ArgumentError_t *)ARGPARSER_MALLOC(sizeof(ArgumentError_t));
+
+            if (error != NULL)
+                argparser_error_initialize(error, USAGE, m_Parser->arguments[m_Slot].name, (char *)"parser is frozen");
+            throw UsageError(error);
+        }
+    };
+
+    /* Every setter goes through here, so the cached help and trie are dropped on change. */
+    Argument_t *Argument::get() const
+    {
+        check();
+        argparser_invalidate(m_Parser);
+        return &m_Parser->arguments[m_Slot];
+    };
+
+    char *Argument::copy(const char *str) const
+    {
+        check();
+        return argparser_arena_strdup(&m_Parser->arena, str);
+    };
+
+    char *Argument::intern(std::string_view str, uint32_t *hash) const
+    {
+        check();
+        return argparser_intern(m_Parser, str.data() ? str.data() : "", str.size(), false, hash);
+    };
+
+    Argument &Argument::flag()
+    {
+        nargs(0);
+        default_value(false);
+        implicit_value(true);
+        return *this;
+    };
+
+    Argument &Argument::nargs(Nargs pattern)
+    {
+        argparser_set_nargs(get(), ARGPARSER_NARGS(pattern));
+        if (get()->type == FLAG)
+            get()->type = KWARG;
+        return *this;
+    };
+
+    Argument &Argument::nargs(std::size_t num_args)
+    {
+        return nargs(num_args, num_args);
+    };
+
+    Argument &Argument::nargs(std::size_t nargs_min, std::size_t nargs_max)
+    {
+        Argument_t *argument = get();
+
+        argument->narg_min = nargs_min;
+        argument->narg_max = nargs_max;
+        argument->count = (int)nargs_max;
+
+        if (nargs_max == 0)
+            argument->type = FLAG;
+        else if (argument->type == FLAG)
+            argument->type = KWARG;
+        return *this;
+    };
+
+    Argument &Argument::help(std::string_view help_text)
+    {
+        get()->help = intern(help_text, nullptr);
+        return *this;
+    };
+
+    Argument &Argument::dest(std::string_view dest)
+    {
+        uint32_t hash;
+        char *key = intern(dest, &hash);
+
+        if (key != nullptr && argparser_index_probe(m_Parser, nullptr, key, dest.size(), hash, false) != nullptr)
+        {
+            argparser_raise(m_Parser, USAGE, key, "conflicting dest");
+            return *this;
+        }
+
+        if (key == nullptr || !argparser_index_reserve(m_Parser, 1))
+        {
+            argparser_raise(m_Parser, USAGE, get()->name, "out of memory");
+            return *this;
+        }
+
+        get()->dest = key;
+        argparser_index_insert(m_Parser, m_Slot, true, hash);
+        return *this;
+    };
+
+    Argument &Argument::metavar(std::string_view metavar)
+    {
+        get()->metavar = intern(metavar, nullptr);
+        return *this;
+    };
+
+    Argument &Argument::hidden()
+    {
+        get()->is_hidden = true;
+        return *this;
+    };
+
+    Argument &Argument::repeat()
+    {
+        get()->is_repeatable = true;
+        return *this;
+    };
+
+    Argument &Argument::required()
+    {
+        get()->required = 1;
+        get()->is_required = true;
+        return *this;
+    };
+
+    Argument &Argument::stored_count()
+    {
+        get()->store_count = true;
+        return *this;
+    };
+
+    Argument &Argument::type(ArgumentValueType type)
+    {
+        get()->value_type = type;
+        argparser_apply_default(m_Parser, get());
+        return *this;
+    };
+
+    Argument &Argument::choices(std::initializer_list<const char *> choices)
+    {
+        Argument_t *argument = get();
+        const char **table = (const char **)argparser_arena_alloc(&m_Parser->arena, choices.size() * sizeof(const char *));
+        int count = 0;
+
+        if (table == NULL)
+        {
+            argparser_raise(m_Parser, USAGE, argument->name, "out of memory");
+            return *this;
+        }
+
+        for (const char *choice : choices)
+            table[count++] = copy(choice);
+
+        argument->choices = table;
+        argument->choice_count = count;
+        return type(VALUE_ENUM);
+    };
+
+    Argument &Argument::bind(void *destination, std::size_t size)
+    {
+        if (!argparser_store_fits(get(), size))
+        {
+            argparser_raise(m_Parser, USAGE, get()->name, "destination does not fit the value type");
+            return *this;
+        }
+
+        get()->store_address = destination;
+        get()->store_offset = 0;
+        get()->store_size = size;
+        return *this;
+    };
+
+    Argument &Argument::separator(char separator)
+    {
+        if (!argparser_is_separator(separator))
+        {
+            argparser_raise(m_Parser, USAGE, get()->name, "separator can be part of a number");
+            return *this;
+        }
+
+        get()->separator = separator;
+        return type(get()->value_type);
+    };
+
+    Argument &Argument::env(const char *variable)
+    {
+        argparser_set_env(m_Parser, get()->name, variable);
+        return *this;
+    };
+
+    Argument &Argument::set_default(const char *value)
+    {
+        get()->default_value = copy(value);
+        argparser_apply_default(m_Parser, get());
+        return *this;
+    };
+
+    Argument &Argument::set_implicit(const char *value)
+    {
+        get()->implicit_value = copy(value);
+        return *this;
+    };
+
+    Argument &Argument::set_callback(ArgumentCallback_t callback, void *data, void (*release)(void *))
+    {
+        Argument_t *argument = get();
+
+        if (argument->on_value_release != NULL)
+            argument->on_value_release(argument->on_value_data);
+
+        argument->on_value = callback;
+        argument->on_value_data = data;
+        argument->on_value_release = release;
+        return *this;
+    };
+
+}; // namespace argparser
+
+#endif //__cplusplus
+
+#pragma endregion // Cpp
+
+#pragma endregion // Internal
+
+#pragma region Argparser
+
+//-----------------------------------------------------------------------------
+// [SECTION] C Only Functions
+//-----------------------------------------------------------------------------
+
+#pragma region C
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+    ARGPARSER_API void argparser_initialize(ArgumentParser_t *parser, const char *program, const char *usage, const char *description, const char *epilog)
+    {
+        ARGPARSER_ASSERT(parser);
+
+        memset(parser, 0, sizeof(ArgumentParser_t));
+
+        parser->program = argparser_arena_strdup(&parser->arena, program);
+        parser->usage = argparser_arena_strdup(&parser->arena, usage);
+        parser->description = argparser_arena_strdup(&parser->arena, description);
+        parser->epilog = argparser_arena_strdup(&parser->arena, epilog);
+        parser->prefix_char = '-';
+        parser->add_help = true;
+        parser->allow_abbrev = true;
+        parser->exit_on_error = true;
+
+        argparser_add_argument(parser, 'h', "help", 0, 0, NULL, "show this help message and exit");
+        if (parser->count > 0)
+            parser->arguments[parser->count - 1].is_exit = true;
+    };
+
+    ARGPARSER_API void argparser_delete(ArgumentParser_t *parser)
+    {
+        ARGPARSER_ASSERT(parser);
+
+        if (parser->error != NULL)
+            argparser_error_delete(parser->error);
+
+        for (int i = 0; i < parser->count; i++)
+        {
+            if (parser->arguments[i].on_value_release != NULL)
+                parser->arguments[i].on_value_release(parser->arguments[i].on_value_data);
+        }
+
+        for (int i = 0; i < parser->subcommand_count; i++)
+        {
+            if (parser->subcommands[i].parser != NULL)
+            {
+                argparser_delete(parser->subcommands[i].parser);
+                ARGPARSER_FREE(parser->subcommands[i].parser);
+            }
+        }
+
+        argparser_result_delete(&parser->result);
+        argparser_invalidate(parser);
+        argparser_unmap(parser->config_files);
+        argparser_arena_release(&parser->arena);
+
+        memset(parser, 0, sizeof(ArgumentParser_t));
+    };
+
+    ARGPARSER_API int argparser_reserve(ArgumentParser_t *parser, int count)
+    {
+        ARGPARSER_ASSERT(parser);
+
+        if (parser->is_frozen)
+            return argparser_raise(parser, USAGE, "", "parser is frozen");
+
+        if (count <= parser->capacity)
+            return ARGPARSER_SUCCESS;
+
+        if (!argparser_grow_arguments(parser, (size_t)count) ||
+            !argparser_index_reserve(parser, 2 * (size_t)(count - parser->count)))
+            return argparser_raise(parser, USAGE, "", "out of memory");
+
+        return ARGPARSER_SUCCESS;
+    };
+
+    ARGPARSER_API int argparser_load_schema(ArgumentParser_t *parser, const ArgumentSchema_t *schema)
+    {
+        Argument_t *arguments;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(schema);
+
+        if (parser->is_frozen)
+            return argparser_raise(parser, USAGE, "", "parser is frozen");
+        argparser_invalidate(parser);
+
+        arguments = (Argument_t *)argparser_arena_alloc(&parser->arena, (size_t)schema->count * sizeof(Argument_t));
+        if (arguments == NULL)
+            return argparser_raise(parser, USAGE, "", "out of memory");
+
+        memcpy(arguments, schema->arguments, (size_t)schema->count * sizeof(Argument_t));
+        memcpy(parser->symbols, schema->symbols, sizeof(parser->symbols));
+
+        parser->arguments = arguments;
+        parser->count = schema->count;
+        parser->capacity = schema->count;
+        parser->index = (ArgumentIndexEntry_t *)schema->index;
+        parser->index_capacity = schema->index_capacity;
+        parser->index_count = schema->index_count;
+        parser->index_is_static = true;
+        parser->groups = NULL;
+        parser->group_count = 0;
+
+        return ARGPARSER_SUCCESS;
+    };
+
+    /* Appends a string after the tables and returns its offset, copying it only when it fits. */
+    static uint32_t argparser_blob_string(ArgumentWriter_t *writer, const char *str)
+    {
+        size_t offset = writer->length;
+        size_t size;
+
+        if (str == NULL)
+            return ARGPARSER_BLOB_NULL;
+
+        size = strlen(str) + 1;
+        if (offset + size <= writer->capacity)
+            memcpy(writer->data + offset, str, size);
+        writer->length += size;
+        return (uint32_t)offset;
+    };
+
+    static void argparser_blob_put(ArgumentWriter_t *writer, size_t offset, const void *data, size_t size)
+    {
+        if (size > 0 && offset + size <= writer->capacity)
+            memcpy(writer->data + offset, data, size);
+    };
+
+    static char *argparser_blob_string_at(const unsigned char *blob, uint32_t offset)
+    {
+        return offset == ARGPARSER_BLOB_NULL ? NULL : (char *)(blob + offset);
+    };
+
+    /* Whether count items of item bytes at offset lie inside the blob, 8-aligned as written. */
+    static bool argparser_blob_fits(size_t size, uint32_t offset, size_t count, size_t item)
+    {
+        return (offset & 7) == 0 && offset <= size && count <= (size - offset) / item;
+    };
+
+    /* Whether offset stands for NULL, or for a string ending inside the blob. */
+    static bool argparser_blob_has_string(const unsigned char *blob, size_t size, uint32_t offset)
+    {
+        return offset == ARGPARSER_BLOB_NULL || (offset < size && memchr(blob + offset, '\0', size - offset) != NULL);
+    };
+
+    /*
+     * Every link and position must be in range, and the nodes reachable from
+     * the root must form a tree, so walking and collecting always end. The
+     * scratch marks each node once, a node reached twice is a cycle or a join.
+     */
+    static bool argparser_blob_check_trie(const ArgumentTrieNode_t *trie, uint32_t trie_count, uint32_t count)
+    {
+        uint32_t *queue;
+        unsigned char *seen;
+        uint32_t head = 0;
+        uint32_t tail = 0;
+        bool valid = true;
+
+        if (trie_count == 0)
+            return true;
+
+        for (uint32_t i = 0; i < trie_count; i++)
+        {
+            const ArgumentTrieNode_t *node = &trie[i];
+
+            if (node->child < 0 || (uint32_t)node->child >= trie_count || node->sibling < 0 || (uint32_t)node->sibling >= trie_count ||
+                node->slot < -1 || (node->slot >= 0 && (uint32_t)node->slot >= count) || node->count < 0 ||
+                (i > 0 && (node->first < 0 || (uint32_t)node->first >= count)))
+                return false;
+        }
+
+        queue = (uint32_t *)ARGPARSER_MALLOC(trie_count * (sizeof(uint32_t) + 1));
+        if (queue == NULL)
+            return false;
+        seen = (unsigned char *)(queue + trie_count);
+        memset(seen, 0, trie_count);
+
+        seen[0] = 1;
+        queue[tail++] = 0;
+        while (valid && head < tail)
+        {
+            const ArgumentTrieNode_t *node = &trie[queue[head++]];
+            int links[2] = {node->child, node->sibling};
+
+            for (int k = 0; k < 2 && valid; k++)
+            {
+                if (links[k] == 0)
+                    continue;
+                valid = !seen[links[k]];
+                seen[links[k]] = 1;
+                queue[tail++] = (uint32_t)links[k];
+            }
+        }
+
+        ARGPARSER_FREE(queue);
+        return valid;
+    };
+
+    /* Run before anything is borrowed, so a truncated or corrupted blob is refused rather than read out of bounds. */
+    static bool argparser_blob_check(const unsigned char *blob, size_t size)
+    {
+        const ArgumentBlobHeader_t *header = (const ArgumentBlobHeader_t *)blob;
+        const ArgumentBlobArgument_t *entries = (const ArgumentBlobArgument_t *)(blob + header->arguments);
+        const ArgumentBlobGroup_t *groups = (const ArgumentBlobGroup_t *)(blob + header->groups);
+        const uint32_t *choices = (const uint32_t *)(blob + header->choices);
+        const ArgumentIndexEntry_t *index = (const ArgumentIndexEntry_t *)(blob + header->index);
+        const uint64_t *masks = (const uint64_t *)(blob + header->masks);
+        const int *symbols = (const int *)(blob + header->symbols);
+        size_t words = ARGPARSER_BITSET_WORDS(header->count);
+        uint32_t used = 0;
+        const uint32_t strings[] = {header->program, header->usage, header->description, header->epilog, header->program_version, header->env_prefix};
+
+        if (!argparser_blob_fits(size, header->arguments, header->count, sizeof(ArgumentBlobArgument_t)) ||
+            !argparser_blob_fits(size, header->choices, header->choice_count, sizeof(uint32_t)) ||
+            !argparser_blob_fits(size, header->groups, header->group_count, sizeof(ArgumentBlobGroup_t)) ||
+            !argparser_blob_fits(size, header->masks, header->mask_words, sizeof(uint64_t)) ||
+            !argparser_blob_fits(size, header->index, header->index_capacity, sizeof(ArgumentIndexEntry_t)) ||
+            !argparser_blob_fits(size, header->trie, header->trie_count, sizeof(ArgumentTrieNode_t)) ||
+            !argparser_blob_fits(size, header->symbols, 1, 256 * sizeof(int)) ||
+            header->help >= size || header->help_size >= size - header->help || blob[header->help + header->help_size] != '\0')
+            return false;
+
+        for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); i++)
+        {
+            if (!argparser_blob_has_string(blob, size, strings[i]))
+                return false;
+        }
+
+        /* Probing stops at an empty slot, so a full index would never end. */
+        if ((header->index_capacity & (header->index_capacity - 1)) != 0 || (header->count > 0 && header->index_capacity == 0))
+            return false;
+        for (uint32_t i = 0; i < header->index_capacity; i++)
+        {
+            unsigned char is_dest;
+
+            /* The index is borrowed as it is, so its flag must already be a valid bool. */
+            memcpy(&is_dest, &index[i].is_dest, 1);
+            if (index[i].slot < 0 || (uint32_t)index[i].slot > header->count || is_dest > 1 ||
+                (index[i].slot != 0 && is_dest && entries[index[i].slot - 1].dest == ARGPARSER_BLOB_NULL))
+                return false;
+            used += index[i].slot != 0;
+        }
+        if (used != header->index_count || (header->index_capacity > 0 && used >= header->index_capacity))
+            return false;
+
+        for (int i = 0; i < 256; i++)
+        {
+            if (symbols[i] < 0 || (uint32_t)symbols[i] > header->count)
+                return false;
+        }
+
+        for (uint32_t i = 0; i < header->choice_count; i++)
+        {
+            if (choices[i] == ARGPARSER_BLOB_NULL || !argparser_blob_has_string(blob, size, choices[i]))
+                return false;
+        }
+
+        for (uint32_t i = 0; i < header->count; i++)
+        {
+            const ArgumentBlobArgument_t *entry = &entries[i];
+            Argument_t argument;
+
+            if (entry->name == ARGPARSER_BLOB_NULL || !argparser_blob_has_string(blob, size, entry->name) ||
+                !argparser_blob_has_string(blob, size, entry->dest) || !argparser_blob_has_string(blob, size, entry->metavar) ||
+                !argparser_blob_has_string(blob, size, entry->help) || !argparser_blob_has_string(blob, size, entry->default_value) ||
+                !argparser_blob_has_string(blob, size, entry->implicit_value) || !argparser_blob_has_string(blob, size, entry->env) ||
+                entry->type > ARG || entry->value_type > VALUE_DOUBLE_LIST || entry->choice_count < 0 ||
+                (uint64_t)entry->first_choice + (uint64_t)entry->choice_count > header->choice_count)
+                return false;
+
+            /* A bound member is written through the target, so its size must fit the value. */
+            memset(&argument, 0, sizeof(argument));
+            argument.type = (ArgumentType)entry->type;
+            argument.value_type = (ArgumentValueType)entry->value_type;
+            if (entry->store_offset != 0 && !argparser_store_fits(&argument, entry->store_size))
+                return false;
+        }
+
+        /* Masks index the parse table, so no bit may name an argument past the last. */
+        for (uint32_t i = 0; i < header->group_count; i++)
+        {
+            const ArgumentBlobGroup_t *group = &groups[i];
+
+            if (group->type > GROUP_INCLUSIVE || group->words > words ||
+                (uint64_t)group->mask + group->words > header->mask_words)
+                return false;
+            if (group->words == words && words > 0 && header->count % 64 != 0 &&
+                (masks[group->mask + words - 1] >> (header->count % 64)) != 0)
+                return false;
+        }
+
+        return argparser_blob_check_trie((const ArgumentTrieNode_t *)(blob + header->trie), header->trie_count, header->count);
+    };
+
+    ARGPARSER_API size_t argparser_serialize(ArgumentParser_t *parser, void *buffer, size_t size)
+    {
+        ArgumentBlobHeader_t header;
+        ArgumentWriter_t writer;
+        size_t choice = 0;
+        size_t word = 0;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(buffer || size == 0);
+
+        if (!argparser_cache_help(parser) || !argparser_build_trie(parser))
+            return 0;
+
+        memset(&header, 0, sizeof(header));
+        header.magic = ARGPARSER_BLOB_MAGIC;
+        header.version = ARGPARSER_BLOB_VERSION;
+        header.entry_size = (uint16_t)sizeof(ArgumentIndexEntry_t);
+        header.node_size = (uint16_t)sizeof(ArgumentTrieNode_t);
+        header.count = (uint32_t)parser->count;
+        header.group_count = (uint32_t)parser->group_count;
+        header.index_capacity = (uint32_t)parser->index_capacity;
+        header.index_count = (uint32_t)parser->index_count;
+        header.trie_count = (uint32_t)parser->trie_count;
+        header.help_size = (uint32_t)parser->help_size;
+        header.prefix_char = parser->prefix_char;
+        header.fromfile_prefix_char = parser->fromfile_prefix_char;
+        header.allow_abbrev = parser->allow_abbrev;
+        header.add_help = parser->add_help;
+
+        for (int i = 0; i < parser->count; i++)
+            header.choice_count += (uint32_t)parser->arguments[i].choice_count;
+        for (int i = 0; i < parser->group_count; i++)
+            header.mask_words += (uint32_t)parser->groups[i].words;
+
+        /* Fixed sections first, each 8-aligned, then the help and the strings. */
+        writer.length = ARGPARSER_BLOB_ROUND(sizeof(header));
+        header.arguments = (uint32_t)writer.length;
+        writer.length = ARGPARSER_BLOB_ROUND(writer.length + header.count * sizeof(ArgumentBlobArgument_t));
+        header.choices = (uint32_t)writer.length;
+        writer.length = ARGPARSER_BLOB_ROUND(writer.length + header.choice_count * sizeof(uint32_t));
+        header.groups = (uint32_t)writer.length;
+        writer.length = ARGPARSER_BLOB_ROUND(writer.length + header.group_count * sizeof(ArgumentBlobGroup_t));
+        header.masks = (uint32_t)writer.length;
+        writer.length += header.mask_words * sizeof(uint64_t);
+        header.index = (uint32_t)writer.length;
+        writer.length = ARGPARSER_BLOB_ROUND(writer.length + header.index_capacity * sizeof(ArgumentIndexEntry_t));
+        header.trie = (uint32_t)writer.length;
+        writer.length = ARGPARSER_BLOB_ROUND(writer.length + header.trie_count * sizeof(ArgumentTrieNode_t));
+        header.symbols = (uint32_t)writer.length;
+        writer.length += sizeof(parser->symbols);
+        header.help = (uint32_t)writer.length;
+
+        writer.data = (char *)buffer;
+        writer.capacity = size;
+        argparser_blob_put(&writer, header.index, parser->index, header.index_capacity * sizeof(ArgumentIndexEntry_t));
+        argparser_blob_put(&writer, header.trie, parser->trie, header.trie_count * sizeof(ArgumentTrieNode_t));
+        argparser_blob_put(&writer, header.symbols, parser->symbols, sizeof(parser->symbols));
+        argparser_blob_put(&writer, header.help, parser->help, header.help_size);
+        argparser_blob_put(&writer, header.help + header.help_size, "", 1);
+        writer.length += header.help_size + 1;
+
+        header.program = argparser_blob_string(&writer, parser->program);
+        header.usage = argparser_blob_string(&writer, parser->usage);
+        header.description = argparser_blob_string(&writer, parser->description);
+        header.epilog = argparser_blob_string(&writer, parser->epilog);
+        header.program_version = argparser_blob_string(&writer, parser->version);
+        header.env_prefix = argparser_blob_string(&writer, parser->env_prefix);
+
+        for (int i = 0; i < parser->count; i++)
+        {
+            const Argument_t *argument = &parser->arguments[i];
+            ArgumentBlobArgument_t entry;
+
+            memset(&entry, 0, sizeof(entry));
+            entry.narg_min = argument->narg_min;
+            entry.narg_max = argument->narg_max;
+            entry.name = argparser_blob_string(&writer, argument->name);
+            entry.dest = argparser_blob_string(&writer, argument->dest);
+            entry.metavar = argparser_blob_string(&writer, argument->metavar);
+            entry.help = argparser_blob_string(&writer, argument->help);
+            entry.default_value = argparser_blob_string(&writer, (const char *)argument->default_value);
+            entry.implicit_value = argparser_blob_string(&writer, (const char *)argument->implicit_value);
+            entry.first_choice = (uint32_t)choice;
+            entry.choice_count = argument->choice_count;
+            entry.count = argument->count;
+            entry.required = argument->required;
+            entry.action_type = argument->action_type;
+            entry.store_offset = (uint32_t)argument->store_offset;
+            entry.store_size = (uint32_t)argument->store_size;
+            entry.type = (uint8_t)argument->type;
+            entry.value_type = (uint8_t)argument->value_type;
+            entry.sym = argument->sym;
+            entry.separator = argument->separator;
+            entry.store_count = argument->store_count;
+            entry.is_repeatable = argument->is_repeatable;
+            entry.is_deprecated = argument->is_deprecated;
+            entry.is_optional = argument->is_optional;
+            entry.is_required = argument->is_required;
+            entry.is_hidden = argument->is_hidden;
+            entry.is_exit = argument->is_exit;
+            entry.env = argparser_blob_string(&writer, argument->env);
+
+            for (int k = 0; k < argument->choice_count; k++, choice++)
+            {
+                uint32_t offset = argparser_blob_string(&writer, argument->choices[k]);
+                argparser_blob_put(&writer, header.choices + choice * sizeof(uint32_t), &offset, sizeof(offset));
+            }
+            argparser_blob_put(&writer, header.arguments + (size_t)i * sizeof(entry), &entry, sizeof(entry));
+        }
+
+        for (int i = 0; i < parser->group_count; i++)
+        {
+            const ArgumentGroup_t *group = &parser->groups[i];
+            ArgumentBlobGroup_t entry;
+
+            entry.type = (uint32_t)group->type;
+            entry.is_required = group->is_required;
+            entry.words = (uint32_t)group->words;
+            entry.mask = (uint32_t)word;
+            argparser_blob_put(&writer, header.masks + word * sizeof(uint64_t), group->mask, (size_t)group->words * sizeof(uint64_t));
+            argparser_blob_put(&writer, header.groups + (size_t)i * sizeof(entry), &entry, sizeof(entry));
+            word += (size_t)group->words;
+        }
+
+        writer.length = ARGPARSER_BLOB_ROUND(writer.length);
+        if (writer.length > UINT32_MAX)
+            return 0;
+
+        header.size = (uint32_t)writer.length;
+        argparser_blob_put(&writer, 0, &header, sizeof(header));
+        return writer.length;
+    };
+
+    ARGPARSER_API int argparser_load_blob(ArgumentParser_t *parser, const void *blob, size_t size)
+    {
+        const unsigned char *base = (const unsigned char *)blob;
+        const ArgumentBlobHeader_t *header = (const ArgumentBlobHeader_t *)blob;
+        const ArgumentBlobArgument_t *entries;
+        const ArgumentBlobGroup_t *groups;
+        const uint32_t *choices;
+        Argument_t *arguments;
+        const char **table;
+        ArgumentGroup_t *compiled;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(blob || size == 0);
+
+        if (parser->is_frozen)
+            return argparser_raise(parser, USAGE, "", "parser is frozen");
+
+        if (size < sizeof(ArgumentBlobHeader_t) || ((uintptr_t)blob & 7) != 0 ||
+            header->magic != ARGPARSER_BLOB_MAGIC || header->version != ARGPARSER_BLOB_VERSION ||
+            header->size != size || header->entry_size != sizeof(ArgumentIndexEntry_t) ||
+            header->node_size != sizeof(ArgumentTrieNode_t) || !argparser_blob_check(base, size))
+            return argparser_raise(parser, USAGE, "", "invalid schema blob");
+
+        argparser_invalidate(parser);
+
+        entries = (const ArgumentBlobArgument_t *)(base + header->arguments);
+        groups = (const ArgumentBlobGroup_t *)(base + header->groups);
+        choices = (const uint32_t *)(base + header->choices);
+
+        arguments = (Argument_t *)argparser_arena_alloc(&parser->arena, header->count * sizeof(Argument_t));
+        table = (const char **)argparser_arena_alloc(&parser->arena, header->choice_count * sizeof(const char *));
+        compiled = (ArgumentGroup_t *)argparser_arena_alloc(&parser->arena, header->group_count * sizeof(ArgumentGroup_t));
+        if ((arguments == NULL && header->count > 0) || (table == NULL && header->choice_count > 0) ||
+            (compiled == NULL && header->group_count > 0))
+            return argparser_raise(parser, USAGE, "", "out of memory");
+
+        /* Zeroed up front, so a default failing below leaves nothing for argparser_delete() to misread. */
+        if (header->count > 0)
+            memset(arguments, 0, header->count * sizeof(Argument_t));
+
+        for (uint32_t i = 0; i < header->choice_count; i++)
+            table[i] = argparser_blob_string_at(base, choices[i]);
+
+        for (uint32_t i = 0; i < header->group_count; i++)
+        {
+            compiled[i].type = (ArgumentGroupType)groups[i].type;
+            compiled[i].is_required = groups[i].is_required != 0;
+            compiled[i].mask = (uint64_t *)(base + header->masks) + groups[i].mask;
+            compiled[i].words = (int)groups[i].words;
+        }
+
+        parser->program = argparser_blob_string_at(base, header->program);
+        parser->usage = argparser_blob_string_at(base, header->usage);
+        parser->description = argparser_blob_string_at(base, header->description);
+        parser->epilog = argparser_blob_string_at(base, header->epilog);
+        parser->version = argparser_blob_string_at(base, header->program_version);
+        parser->env_prefix = argparser_blob_string_at(base, header->env_prefix);
+        parser->env_count = 0;
+        parser->prefix_char = header->prefix_char;
+        parser->fromfile_prefix_char = header->fromfile_prefix_char;
+        parser->allow_abbrev = header->allow_abbrev != 0;
+        parser->add_help = header->add_help != 0;
+
+        parser->arguments = arguments;
+        parser->count = (int)header->count;
+        parser->capacity = (int)header->count;
+        parser->groups = compiled;
+        parser->group_count = (int)header->group_count;
+        parser->index = header->index_capacity > 0 ? (ArgumentIndexEntry_t *)(base + header->index) : NULL;
+        parser->index_capacity = header->index_capacity;
+        parser->index_count = header->index_count;
+        parser->index_is_static = true;
+        memcpy(parser->symbols, base + header->symbols, sizeof(parser->symbols));
+
+        for (uint32_t i = 0; i < header->count; i++)
+        {
+            const ArgumentBlobArgument_t *entry = &entries[i];
+            Argument_t *argument = &arguments[i];
+
+            argument->type = (ArgumentType)entry->type;
+            argument->required = entry->required;
+            argument->help = argparser_blob_string_at(base, entry->help);
+            argument->dest = argparser_blob_string_at(base, entry->dest);
+            argument->metavar = argparser_blob_string_at(base, entry->metavar);
+            argument->count = entry->count;
+            argument->sym = entry->sym;
+            argument->default_value = argparser_blob_string_at(base, entry->default_value);
+            argument->name = argparser_blob_string_at(base, entry->name);
+            argument->narg_max = (size_t)entry->narg_max;
+            argument->narg_min = (size_t)entry->narg_min;
+            argument->action_type = entry->action_type;
+            argument->store_count = entry->store_count != 0;
+            argument->implicit_value = argparser_blob_string_at(base, entry->implicit_value);
+            argument->value_type = (ArgumentValueType)entry->value_type;
+            argument->choices = entry->choice_count > 0 ? table + entry->first_choice : NULL;
+            argument->choice_count = entry->choice_count;
+            argument->separator = entry->separator;
+            argument->store_offset = entry->store_offset;
+            argument->store_size = entry->store_size;
+            argument->is_repeatable = entry->is_repeatable != 0;
+            argument->is_deprecated = entry->is_deprecated != 0;
+            argument->is_optional = entry->is_optional != 0;
+            argument->is_required = entry->is_required != 0;
+            argument->is_hidden = entry->is_hidden != 0;
+            argument->is_exit = entry->is_exit != 0;
+            argument->env = argparser_blob_string_at(base, entry->env);
+            parser->env_count += argument->env != NULL;
+
+            if (argparser_apply_default(parser, argument) != ARGPARSER_SUCCESS)
+                return ARGPARSER_FAILURE;
+        }
+
+        /* Set last, the defaults above must not drop what they borrow. */
+        parser->help = (char *)(base + header->help);
+        parser->help_size = header->help_size;
+        parser->trie = header->trie_count > 0 ? (ArgumentTrieNode_t *)(base + header->trie) : NULL;
+        parser->trie_count = (int)header->trie_count;
+        parser->tables_are_static = true;
+
+        return ARGPARSER_SUCCESS;
+    };
+
+    ARGPARSER_API void argparser_add_argument(ArgumentParser_t *parser, char sym, const char *name, int required, int nargs, const char *default_value, const char *help)
+    {
+        Argument_t *argument = argparser_emplace_argument(parser, sym, name, nargs);
+
+        if (argument == NULL)
+            return;
+
+        argument->help = argparser_intern(parser, help, help ? strlen(help) : 0, false, NULL);
+        argument->default_value = argparser_arena_strdup(&parser->arena, default_value);
+        argument->required = required;
+        argument->is_required = required != 0;
+        argparser_apply_default(parser, argument);
+    };
+
+    ARGPARSER_API int argparser_set_type(ArgumentParser_t *parser, const char *name, ArgumentValueType type)
+    {
+        Argument_t *argument;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(name);
+
+        argument = argparser_find_mutable(parser, name);
+        if (argument == NULL)
+            return ARGPARSER_FAILURE;
+
+        argument->value_type = type;
+        return argparser_apply_default(parser, argument);
+    };
+
+    ARGPARSER_API int argparser_set_choices(ArgumentParser_t *parser, const char *name, const char **choices, int count)
+    {
+        Argument_t *argument;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(name);
+
+        argument = argparser_find_mutable(parser, name);
+        if (argument == NULL)
+            return ARGPARSER_FAILURE;
+
+        argument->choices = choices;
+        argument->choice_count = count;
+        argument->value_type = VALUE_ENUM;
+        return argparser_apply_default(parser, argument);
+    };
+
+    ARGPARSER_API int argparser_set_separator(ArgumentParser_t *parser, const char *name, char separator)
+    {
+        Argument_t *argument;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(name);
+
+        if (!argparser_is_separator(separator))
+            return argparser_raise(parser, USAGE, name, "separator can be part of a number");
+
+        argument = argparser_find_mutable(parser, name);
+        if (argument == NULL)
+            return ARGPARSER_FAILURE;
+
+        argument->separator = separator;
+        return argparser_apply_default(parser, argument);
+    };
+
+    ARGPARSER_API int argparser_bind(ArgumentParser_t *parser, const char *name, size_t offset, size_t size)
+    {
+        Argument_t *argument;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(name);
+
+        argument = argparser_find_mutable(parser, name);
+        if (argument == NULL)
+            return ARGPARSER_FAILURE;
+        if (!argparser_store_fits(argument, size))
+            return argparser_raise(parser, USAGE, name, "destination does not fit the value type");
+
+        argument->store_address = NULL;
+        argument->store_offset = offset + 1;
+        argument->store_size = size;
+        return ARGPARSER_SUCCESS;
+    };
+
+    ARGPARSER_API int argparser_store_into(ArgumentParser_t *parser, const char *name, void *destination, size_t size)
+    {
+        Argument_t *argument;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(name);
+        ARGPARSER_ASSERT(destination);
+
+        argument = argparser_find_mutable(parser, name);
+        if (argument == NULL)
+            return ARGPARSER_FAILURE;
+        if (!argparser_store_fits(argument, size))
+            return argparser_raise(parser, USAGE, name, "destination does not fit the value type");
+
+        argument->store_address = destination;
+        argument->store_offset = 0;
+        argument->store_size = size;
+        return ARGPARSER_SUCCESS;
+    };
+
+    ARGPARSER_API void argparser_set_target(ArgumentParser_t *parser, void *target)
+    {
+        ARGPARSER_ASSERT(parser);
+
+        parser->result.target = target;
+    };
+
+    ARGPARSER_API int argparser_set_callback(ArgumentParser_t *parser, const char *name, ArgumentCallback_t callback, void *user_data)
+    {
+        Argument_t *argument;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(name);
+
+        argument = argparser_find_mutable(parser, name);
+        if (argument == NULL)
+            return ARGPARSER_FAILURE;
+
+        if (argument->on_value_release != NULL)
+            argument->on_value_release(argument->on_value_data);
+
+        argument->on_value = callback;
+        argument->on_value_data = user_data;
+        argument->on_value_release = NULL;
+        return ARGPARSER_SUCCESS;
+    };
+
+    ARGPARSER_API int argparser_add_group(ArgumentParser_t *parser, ArgumentGroupType type, int required, const char **names, int count)
+    {
+        ArgumentGroup_t *groups;
+        uint64_t *mask;
+        size_t words = 0;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(names || count == 0);
+
+        if (parser->is_frozen)
+            return argparser_raise(parser, USAGE, "", "parser is frozen");
+
+        for (int i = 0; i < count; i++)
+        {
+            Argument_t *argument = argparser_index_find(parser, names[i], strlen(names[i]), false);
+
+            if (argument == NULL)
+                return argparser_raise(parser, MAP, names[i], "unknown argument");
+            if (ARGPARSER_BITSET_WORDS(argument - parser->arguments + 1) > words)
+                words = ARGPARSER_BITSET_WORDS(argument - parser->arguments + 1);
+        }
+
+        mask = (uint64_t *)argparser_arena_alloc(&parser->arena, words * sizeof(uint64_t));
+        groups = (ArgumentGroup_t *)argparser_arena_realloc(&parser->arena, parser->groups,
+                                                            (size_t)parser->group_count * sizeof(ArgumentGroup_t),
+                                                            (size_t)(parser->group_count + 1) * sizeof(ArgumentGroup_t));
+        if ((mask == NULL && words > 0) || groups == NULL)
+            return argparser_raise(parser, USAGE, "", "out of memory");
+
+        if (words > 0)
+            memset(mask, 0, words * sizeof(uint64_t));
+        for (int i = 0; i < count; i++)
+        {
+            int slot = (int)(argparser_index_find(parser, names[i], strlen(names[i]), false) - parser->arguments);
+            mask[slot / 64] |= (uint64_t)1 << (slot % 64);
+        }
+
+        groups[parser->group_count].type = type;
+        groups[parser->group_count].is_required = required != 0;
+        groups[parser->group_count].mask = mask;
+        groups[parser->group_count].words = (int)words;
+        parser->groups = groups;
+        parser->group_count++;
+        return ARGPARSER_SUCCESS;
+    };
+
+    ARGPARSER_API int argparser_add_version(ArgumentParser_t *parser, char sym, const char *version)
+    {
+        Argument_t *argument;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(version);
+
+        argument = argparser_emplace_argument(parser, sym, "version", 0);
+        if (argument == NULL)
+            return ARGPARSER_FAILURE;
+
+        argument->help = argparser_intern(parser, "show program's version number and exit", 39, true, NULL);
+        argument->is_exit = true;
+        parser->version = argparser_arena_strdup(&parser->arena, version);
+        return argparser_apply_default(parser, argument);
+    };
+
+    ARGPARSER_API int argparser_set_env(ArgumentParser_t *parser, const char *name, const char *variable)
+    {
+        Argument_t *argument;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(name);
+
+        argument = argparser_find_mutable(parser, name);
+        if (argument == NULL)
+            return ARGPARSER_FAILURE;
+
+        parser->env_count += (variable != NULL) - (argument->env != NULL);
+        argument->env = argparser_arena_strdup(&parser->arena, variable);
+        if (variable != NULL && argument->env == NULL)
+        {
+            parser->env_count--;
+            return argparser_raise(parser, USAGE, name, "out of memory");
+        }
+        return ARGPARSER_SUCCESS;
+    };
+
+    ARGPARSER_API int argparser_set_env_prefix(ArgumentParser_t *parser, const char *prefix)
+    {
+        ARGPARSER_ASSERT(parser);
+
+        if (parser->is_frozen)
+            return argparser_raise(parser, USAGE, "", "parser is frozen");
+
+        argparser_invalidate(parser);
+        parser->env_prefix = argparser_arena_strdup(&parser->arena, prefix);
+        if (prefix != NULL && parser->env_prefix == NULL)
+            return argparser_raise(parser, USAGE, "", "out of memory");
+        return ARGPARSER_SUCCESS;
+    };
+
+    /* Splits one line in place. A value is terminated where it ends, copied only when that is past the file. */
+    static void argparser_config_line(ArgumentParser_t *parser, char *line, char *line_end, bool terminable, char *section, size_t *section_length)
+    {
+        char key[ARGPARSER_CONFIG_KEY_SIZE];
+        size_t length = 0;
+        Argument_t *argument;
+        char *c = line;
+        char *value;
+        char *out;
+
+        while (c < line_end && (*c == ' ' || *c == '\t' || *c == '\r'))
+            c++;
+        if (c == line_end || *c == '#' || *c == ';')
+            return;
+
+        /* "[log]" makes "level" stand for "log-level", as "log.level" does. */
+        if (*c == '[')
+        {
+            *section_length = 0;
+            for (c++; c < line_end && *c != ']'; c++)
+            {
+                if (*c == ' ' || *c == '\t')
+                    continue;
+                if (*section_length + 2 >= ARGPARSER_CONFIG_KEY_SIZE)
+                {
+                    *section_length = ARGPARSER_CONFIG_KEY_SIZE;
+                    return;
+                }
+                section[(*section_length)++] = *c == '.' ? '-' : *c;
+            }
+            if (*section_length > 0)
+                section[(*section_length)++] = '-';
+            return;
+        }
+
+        if (*section_length >= ARGPARSER_CONFIG_KEY_SIZE)
+            return;
+        memcpy(key, section, *section_length);
+        length = *section_length;
+
+        for (; c < line_end && *c != '=' && *c != ':' && *c != ' ' && *c != '\t'; c++)
+        {
+            if (length + 1 >= ARGPARSER_CONFIG_KEY_SIZE)
+                return;
+            key[length++] = *c == '.' ? '-' : *c;
+        }
+        while (c < line_end && (*c == ' ' || *c == '\t'))
+            c++;
+        if (c == line_end || (*c != '=' && *c != ':') || length == *section_length)
+            return;
+        for (c++; c < line_end && (*c == ' ' || *c == '\t'); c++)
+            ;
+
+        argument = argparser_index_find(parser, key, length, false);
+        if (argument == NULL)
+            return;
+
+        value = out = c;
+        if (c < line_end && (*c == '"' || *c == '\''))
+        {
+            char quote = *c++;
+
+            for (; c < line_end && *c != quote; c++)
+            {
+                if (quote == '"' && *c == '\\' && c + 1 < line_end)
+                    c++;
+                *out++ = *c;
+            }
+            if (c == line_end)
+                return;
+        }
+        else if (c < line_end && *c == '[')
+        {
+            /* An array loses its brackets, blanks and quotes: [1, 2, 3] reads as 1,2,3. */
+            for (c++; c < line_end && *c != ']'; c++)
+            {
+                if (*c != ' ' && *c != '\t' && *c != '"' && *c != '\'')
+                    *out++ = *c;
+            }
+            if (c == line_end)
+                return;
+        }
+        else
+        {
+            for (; c < line_end && !(*c == '#' && c > value && (c[-1] == ' ' || c[-1] == '\t')); c++)
+                ;
+            out = c;
+            while (out > value && (out[-1] == ' ' || out[-1] == '\t' || out[-1] == '\r'))
+                out--;
+        }
+
+        argument->config.size = (size_t)(out - value);
+        if (out < line_end || terminable)
+        {
+            *out = '\0';
+            argument->config.data = value;
+        }
+        else
+        {
+            char *copy = (char *)argparser_arena_alloc(&parser->arena, argument->config.size + 1);
+            if (copy == NULL)
+                return;
+            memcpy(copy, value, argument->config.size);
+            copy[argument->config.size] = '\0';
+            argument->config.data = copy;
+        }
+        argument->is_config_converted = false;
+    };
+
+    ARGPARSER_API int argparser_load_config(ArgumentParser_t *parser, const char *path)
+    {
+        char section[ARGPARSER_CONFIG_KEY_SIZE];
+        size_t section_length = 0;
+        ArgumentMapping_t *mapping;
+        int status = ARGPARSER_SUCCESS;
+        size_t size;
+        bool slack;
+        char *c;
+        char *end;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(path);
+
+        if (parser->is_frozen)
+            return argparser_raise(parser, USAGE, path, "parser is frozen");
+
+        mapping = (ArgumentMapping_t *)argparser_arena_alloc(&parser->arena, sizeof(ArgumentMapping_t));
+        if (mapping == NULL)
+            return argparser_raise(parser, USAGE, path, "out of memory");
+        if (!argparser_map(&parser->arena, path, mapping, &size, &slack))
+            return argparser_raise(parser, USAGE, path, "cannot read config file");
+
+        mapping->next = parser->config_files;
+        parser->config_files = mapping;
+
+        c = (char *)mapping->data;
+        end = c ? c + size : NULL;
+        while (c < end)
+        {
+            char *line_end = (char *)memchr(c, '\n', (size_t)(end - c));
+
+            if (line_end == NULL)
+                line_end = end;
+            argparser_config_line(parser, c, line_end, line_end < end || slack, section, &section_length);
+            c = line_end + 1;
+        }
+
+        for (int i = 0; i < parser->count; i++)
+        {
+            if (argparser_convert_config(parser, &parser->arguments[i]) != ARGPARSER_SUCCESS)
+                status = ARGPARSER_FAILURE;
+        }
+        return status;
+    };
+
+    static int argparser_find_subcommand(const ArgumentParser_t *parser, const char *name, size_t length)
+    {
+        for (int i = 0; i < parser->subcommand_count; i++)
+        {
+            const char *candidate = parser->subcommands[i].name;
 
-#pragma region Cpp
+            if (strncmp(candidate, name, length) == 0 && candidate[length] == '\0')
+                return i;
+        }
+        return -1;
+    };
 
-#ifdef __cplusplus
+    /* The subparser inherits how its parent parses, and is named like "git commit". */
+    static ArgumentParser_t *argparser_build_subcommand(ArgumentParser_t *parser, int index)
+    {
+        ArgumentSubcommand_t *command = &parser->subcommands[index];
+        ArgumentParser_t *subparser;
+        size_t size;
+        char *program;
 
-//-----------------------------------------------------------------------------
-// [SECTION] C++ Only Classes
-//-----------------------------------------------------------------------------
+        if (command->parser != NULL)
+            return command->parser;
 
-namespace argparser
-{
+        /* argparser_freeze() built every subcommand it could, and a frozen parser is never written. */
+        if (parser->is_frozen)
+        {
+            argparser_raise(parser, USAGE, command->name, "subcommand could not be built");
+            return NULL;
+        }
 
-    /**
-     * @class ArgumentError
-     * @brief ArgumentError class for Argument-related errors.
-     */
-    class ArgumentError : public std::exception
+        subparser = (ArgumentParser_t *)ARGPARSER_MALLOC(sizeof(ArgumentParser_t));
+        if (subparser == NULL)
+        {
+            argparser_raise(parser, USAGE, command->name, "out of memory");
+            return NULL;
+        }
+
+        argparser_initialize(subparser, NULL, NULL, command->help, NULL);
+        size = (parser->program ? strlen(parser->program) + 1 : 0) + strlen(command->name) + 1;
+        program = (char *)argparser_arena_alloc(&subparser->arena, size);
+        if (program != NULL)
+            snprintf(program, size, "%s%s%s", parser->program ? parser->program : "", parser->program ? " " : "", command->name);
+        subparser->program = program;
+        subparser->prefix_char = parser->prefix_char;
+        subparser->allow_abbrev = parser->allow_abbrev;
+        subparser->exit_on_error = parser->exit_on_error;
+        subparser->zero_copy = parser->zero_copy;
+        subparser->lazy_conversion = parser->lazy_conversion;
+        subparser->fromfile_prefix_char = parser->fromfile_prefix_char;
+
+        if (program == NULL || command->build(subparser, command->build_data) != ARGPARSER_SUCCESS)
+        {
+            argparser_delete(subparser);
+            ARGPARSER_FREE(subparser);
+            argparser_raise(parser, USAGE, command->name, "subcommand could not be built");
+            return NULL;
+        }
+
+        command->parser = subparser;
+        return subparser;
+    };
+
+    ARGPARSER_API int argparser_add_subcommand(ArgumentParser_t *parser, const char *name, const char *help, ArgumentBuilder_t build, void *user_data)
     {
-    public:
-        /**
-         * @brief Constructs an exception with a specific error type.
-         * @param type The type of the error.
-         */
-        ArgumentError(ArgumentError_t *error);
+        ArgumentSubcommand_t *command;
+        size_t count;
 
-        /**
-         * @brief Destroy an ArgumentError.
-         */
-        ~ArgumentError();
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(name);
+        ARGPARSER_ASSERT(build);
 
-        /**
-         * @brief Gets the error argument.
-         * @return The error argument.
-         */
-        const char *argument() const noexcept;
+        if (parser->is_frozen)
+            return argparser_raise(parser, USAGE, name, "parser is frozen");
+        if (argparser_find_subcommand(parser, name, strlen(name)) >= 0)
+            return argparser_raise(parser, USAGE, name, "conflicting subcommand name");
 
-        /**
-         * @brief Gets the error message.
-         * @return The error message.
-         */
-        const char *what() const noexcept override;
+        /* Grown like the values of an argument, so registering many subcommands stays linear. */
+        count = (size_t)parser->subcommand_count;
+        if (count == 0 || (count >= 4 && (count & (count - 1)) == 0))
+        {
+            size_t capacity = count ? count * 2 : 4;
+            ArgumentSubcommand_t *commands = (ArgumentSubcommand_t *)argparser_arena_realloc(&parser->arena, parser->subcommands, count * sizeof(ArgumentSubcommand_t), capacity * sizeof(ArgumentSubcommand_t));
 
-        /**
-         * @brief Gets the error type.
-         * @return The error type.
-         */
-        ArgumentErrorType type() const noexcept;
+            if (commands == NULL)
+                return argparser_raise(parser, USAGE, name, "out of memory");
+            parser->subcommands = commands;
+        }
 
-    private:
-        ArgumentError_t *m_Error; /**< The error type. */
+        command = &parser->subcommands[count];
+        command->name = argparser_arena_strdup(&parser->arena, name);
+        command->help = argparser_arena_strdup(&parser->arena, help);
+        command->build = build;
+        command->build_data = user_data;
+        command->parser = NULL;
+        if (command->name == NULL || (help != NULL && command->help == NULL))
+            return argparser_raise(parser, USAGE, name, "out of memory");
+
+        parser->subcommand_count++;
+        argparser_invalidate(parser);
+        return ARGPARSER_SUCCESS;
     };
 
-    /** Errors that occur during usage
+    ARGPARSER_API ArgumentParser_t *argparser_get_subparser(ArgumentParser_t *parser, const char *name)
+    {
+        int index;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(name);
+
+        index = argparser_find_subcommand(parser, name, strlen(name));
+        if (index < 0)
+        {
+            argparser_raise(parser, MAP, name, "unknown subcommand");
+            return NULL;
+        }
+        return argparser_build_subcommand(parser, index);
+    };
+
+    ARGPARSER_API int argparser_add_parent(ArgumentParser_t *parser, const ArgumentParser_t *parent)
+    {
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(parent);
+
+        if (parser->is_frozen)
+            return argparser_raise(parser, USAGE, "", "parser is frozen");
+
+        for (int i = 0; i < parent->count; i++)
+        {
+            const Argument_t *shared = &parent->arguments[i];
+            Argument_t *argument;
+            uint32_t name_hash;
+            uint32_t dest_hash = 0;
+
+            if (strcmp(shared->name, "help") == 0 && argparser_index_find(parser, "help", 4, true) != NULL)
+                continue;
+            if (argparser_index_find(parser, shared->name, strlen(shared->name), false) != NULL ||
+                (shared->sym != '\0' && argparser_find_sym(parser, shared->sym) != NULL))
+                return argparser_raise(parser, USAGE, shared->name, "conflicting option string");
+
+            if (!argparser_index_reserve(parser, 2) ||
+                (parser->count == parser->capacity && !argparser_grow_arguments(parser, parser->capacity ? 2 * (size_t)parser->capacity : 8)))
+                return argparser_raise(parser, USAGE, shared->name, "out of memory");
+
+            /*
+             * The strings and choices stay the parent's, as does the callback data. The strings join this pool
+             * borrowed. A config value belongs to the file the parent loaded, so this parser starts without one.
+             */
+            argument = &parser->arguments[parser->count];
+            memcpy(argument, shared, sizeof(Argument_t));
+            argument->on_value_release = NULL;
+            argument->config.data = NULL;
+            argument->config.size = 0;
+            memset(&argument->config_slot, 0, sizeof(ArgumentSlot_t));
+            argument->is_config_converted = false;
+            argument->name = argparser_intern(parser, shared->name, strlen(shared->name), true, &name_hash);
+            argument->dest = shared->dest == shared->name ? argument->name : argparser_intern(parser, shared->dest, shared->dest ? strlen(shared->dest) : 0, true, &dest_hash);
+            if (argument->name == NULL || (shared->dest != NULL && argument->dest == NULL))
+                return argparser_raise(parser, USAGE, shared->name, "out of memory");
+            if (argument->dest == argument->name)
+                dest_hash = name_hash;
+            parser->env_count += argument->env != NULL;
+            argparser_register_argument(parser, name_hash, dest_hash);
+        }
+
+        argparser_invalidate(parser);
+        return ARGPARSER_SUCCESS;
+    };
+
+    static int argparser_run(const ArgumentParser_t *parser, ArgumentResult_t *result, int argc, char **argv)
+    {
+#ifdef ARGPARSER_ENABLE_STATS
+        size_t allocations = result->arena.allocations;
+        size_t bytes = result->arena.bytes;
+        uint64_t start;
+        int status;
+
+        memset(&result->stats, 0, sizeof(ArgumentStats_t));
+        start = argparser_stats_clock();
+
+        status = argparser_run_args(parser, result, argc, argv);
+
+        result->stats.total_ns = argparser_stats_clock() - start;
+        result->stats.allocations = result->arena.allocations - allocations;
+        result->stats.bytes = result->arena.bytes - bytes;
+        if (parser->on_stats != NULL)
+            parser->on_stats(parser, &result->stats, parser->on_stats_data);
+        return status;
+#else
+        return argparser_run_args(parser, result, argc, argv);
+#endif
+    };
+
+    static int argparser_run_args(const ArgumentParser_t *parser, ArgumentResult_t *result, int argc, char **argv)
+    {
+        ArgumentCursor_t cursor;
+        ArgumentMatch_t match;
+        int status;
+
+        if (argparser_run_start(parser, result, &cursor, argc, argv, NULL, NULL) != ARGPARSER_SUCCESS)
+            return ARGPARSER_FAILURE;
+
+        while ((status = argparser_step(parser, result, &cursor, &match)) > 0)
+            ;
+        result->cursor = NULL;
+        if (status < 0)
+            return ARGPARSER_FAILURE;
+        return argparser_run_finish(parser, result);
+    };
+
+    /* Rewinds result for a parse of argv, or of the tokens source returns when it is not NULL. */
+    static int argparser_run_start(const ArgumentParser_t *parser, ArgumentResult_t *result, ArgumentCursor_t *cursor, int argc, char **argv, ArgumentSource_t source, void *data)
+    {
+        size_t words = ARGPARSER_BITSET_WORDS(parser->count);
+
+        if (result->error != NULL)
+            argparser_error_delete(result->error);
+        result->error = NULL;
+
+        /* Only a parser-owned run reaches here with its own result, so no shared parser is written. */
+        if (result == &parser->result && parser->error != NULL)
+        {
+            argparser_error_delete(parser->error);
+            ((ArgumentParser_t *)parser)->error = NULL;
+        }
+
+        argparser_unmap_files(result);
+        argparser_arena_reset(&result->arena);
+
+        result->cursor = NULL;
+        result->count = 0;
+        result->values = (ArgumentValue_t *)argparser_arena_alloc(&result->arena, (size_t)parser->count * sizeof(ArgumentValue_t));
+        if (result->values == NULL && parser->count > 0)
+            return argparser_fail(parser, result, PARSE, parser->program, "out of memory");
+        if (parser->count > 0)
+            memset(result->values, 0, (size_t)parser->count * sizeof(ArgumentValue_t));
+
+        result->used = (uint64_t *)argparser_arena_alloc(&result->arena, words * sizeof(uint64_t));
+        if (result->used == NULL && words > 0)
+            return argparser_fail(parser, result, PARSE, parser->program, "out of memory");
+        if (words > 0)
+            memset(result->used, 0, words * sizeof(uint64_t));
+
+        /* A parser never parsed nor frozen has no table, and argparser_parse_into() cannot give it one. */
+        result->hot = parser->hot;
+        result->flags = parser->flags;
+        if (result->hot == NULL && parser->count > 0)
+        {
+            ArgumentHot_t *hot = (ArgumentHot_t *)argparser_arena_alloc(&result->arena, argparser_hot_size(parser));
+
+            if (hot == NULL)
+                return argparser_fail(parser, result, PARSE, parser->program, "out of memory");
+            argparser_build_hot(parser, hot);
+            result->hot = hot;
+            result->flags = (const uint64_t *)(hot + parser->count);
+        }
+        result->trie = NULL;
+        result->count = parser->count;
+        result->subcommand = 0;
+        result->remaining = argc > 0 ? 1 : 0;
+
+        if (source == NULL)
+        {
+            int slot = argparser_find_exit(parser, result, argc, argv);
+
+            if (slot >= 0)
+                return argparser_exit(parser, result, slot);
+        }
+
+        memset(cursor, 0, sizeof(ArgumentCursor_t));
+        cursor->tokens.parser = parser;
+        cursor->tokens.result = result;
+        cursor->tokens.argc = argc;
+        cursor->tokens.argv = argv;
+        cursor->tokens.index = 1;
+        cursor->tokens.source = source;
+        cursor->tokens.source_data = data;
+        cursor->slot = -1;
+        result->cursor = cursor;
+        return ARGPARSER_SUCCESS;
+    };
+
+    /* Reads the environment for what argv left out, then checks and stores the values. */
+    static int argparser_run_finish(const ArgumentParser_t *parser, ArgumentResult_t *result)
+    {
+        int status;
+
+        if ((parser->env_prefix != NULL || parser->env_count > 0) && argparser_read_env(parser, result) != ARGPARSER_SUCCESS)
+            return ARGPARSER_FAILURE;
+
+        ARGPARSER_STAT_START(validate);
+        status = argparser_validate(parser, result);
+        ARGPARSER_STAT_STOP(result, validate_ns, validate);
+        if (status == ARGPARSER_SUCCESS)
+            status = argparser_store_bound(parser, result);
+        return status;
+    };
+
+    /* Stores a value and reports it, as the record keeps it or, for a streamed argument, as read. */
+    static int argparser_step_store(const ArgumentParser_t *parser, ArgumentResult_t *result, int slot, const char *value, size_t size, ArgumentMatch_t *match)
+    {
+        const ArgumentValue_t *record = &result->values[slot];
+
+        if (argparser_store(parser, result, slot, value, size) != ARGPARSER_SUCCESS)
+            return -1;
+
+        match->argument = &parser->arguments[slot];
+        if (argparser_hot_flag(result, slot, ARGPARSER_HOT_STREAMED))
+        {
+            match->value.data = value;
+            match->value.size = size;
+        }
+        else
+            match->value = argparser_hot_flag(result, slot, ARGPARSER_HOT_MULTIPLE) ? record->values[record->stored_count - 1] : record->value;
+        return 1;
+    };
+
+    /* Starts an option taking values, from the inline value or else from the following tokens. */
+    static int argparser_step_option(const ArgumentParser_t *parser, ArgumentResult_t *result, ArgumentCursor_t *cursor, int slot, const char *inline_value, size_t inline_size, ArgumentMatch_t *match)
+    {
+        const ArgumentHot_t *hot = &result->hot[slot];
+        char message[ARGPARSER_MESSAGE_SIZE];
+
+        if (inline_value == NULL)
+        {
+            cursor->slot = slot;
+            cursor->taken = 0;
+            return 0;
+        }
+
+        if (argparser_step_store(parser, result, slot, inline_value, inline_size, match) < 0)
+            return -1;
+        if (hot->narg_min > 1)
+        {
+            snprintf(message, sizeof(message), "expected %u argument(s)", (unsigned)hot->narg_min);
+            argparser_fail(parser, result, PARSE, hot->name, message);
+            return -1;
+        }
+        return 1;
+    };
+
+    /* Resolves the next symbols of a short cluster, 0 once it is done or an option takes the following tokens. */
+    static int argparser_step_short(const ArgumentParser_t *parser, ArgumentResult_t *result, ArgumentCursor_t *cursor, ArgumentMatch_t *match)
+    {
+        const char *token = cursor->cluster_token;
+        const char *c = cursor->cluster;
+        const char *rest = c + 1;
+        int slot = parser->symbols[(unsigned char)*c] - 1;
+
+        cursor->cluster = *rest != '\0' ? rest : NULL;
+
+        if (slot < 0)
+        {
+            cursor->cluster = NULL;
+
+            /* Only a cluster starting with an unknown symbol is kept, the rest cannot be split off. */
+            if (result->keep_unknown && c == token + 1 && argparser_keep_unknown(result, &cursor->tokens, token, &cursor->separator) == ARGPARSER_SUCCESS)
+                return 0;
+            argparser_fail(parser, result, PARSE, token, "unrecognized argument");
+            return -1;
+        }
+        if (argparser_mark_used(parser, result, slot, token) != ARGPARSER_SUCCESS)
+            return -1;
+        if (argparser_hot_flag(result, slot, ARGPARSER_HOT_EXIT))
+        {
+            argparser_exit(parser, result, slot);
+            return -1;
+        }
+
+        if (result->hot[slot].type == FLAG)
+        {
+            match->argument = &parser->arguments[slot];
+            match->value.data = NULL;
+            match->value.size = 0;
+            return 1;
+        }
+
+        /* The rest of the cluster is the value. */
+        cursor->cluster = NULL;
+        if (*rest == '=')
+            rest++;
+        return argparser_step_option(parser, result, cursor, slot, *rest ? rest : NULL, cursor->cluster_length - (size_t)(rest - token), match);
+    };
+
+    /*
+     * Resolves tokens up to the next value or flag and reports it in match.
+     * Returns 1 for a match, 0 once the tokens end or a subcommand starts,
+     * -1 when the parse failed.
      */
-    class UsageError : public ArgumentError
+    static int argparser_step(const ArgumentParser_t *parser, ArgumentResult_t *result, ArgumentCursor_t *cursor, ArgumentMatch_t *match)
     {
-    public:
-        UsageError(ArgumentError_t *error)
-            : ArgumentError(error) {};
+        ArgumentTokens_t *tokens = &cursor->tokens;
+        const ArgumentToken_t *current;
+        char message[ARGPARSER_MESSAGE_SIZE];
+        int status;
+
+        for (;;)
+        {
+            /* An option takes the following tokens up to narg_max or one that looks like an option. */
+            if (cursor->slot >= 0)
+            {
+                int slot = cursor->slot;
+                const ArgumentHot_t *hot = &result->hot[slot];
+
+                if (cursor->taken < hot->narg_max && (current = argparser_tokens_peek(tokens)) != NULL && !current->is_option)
+                {
+                    argparser_tokens_next(tokens);
+                    cursor->taken++;
+                    return argparser_step_store(parser, result, slot, current->text, current->length, match);
+                }
+                if (tokens->failed)
+                    return -1;
+
+                cursor->slot = -1;
+                if (cursor->taken < hot->narg_min)
+                {
+                    snprintf(message, sizeof(message), "expected %u argument(s)", (unsigned)hot->narg_min);
+                    argparser_fail(parser, result, PARSE, hot->name, message);
+                    return -1;
+                }
+
+                /* Given without one of its optional values. */
+                if (cursor->taken == 0)
+                {
+                    match->argument = &parser->arguments[slot];
+                    match->value.data = NULL;
+                    match->value.size = 0;
+                    return 1;
+                }
+            }
+
+            if (cursor->cluster != NULL)
+            {
+                if ((status = argparser_step_short(parser, result, cursor, match)) != 0)
+                    return status;
+                continue;
+            }
+
+            if ((current = argparser_tokens_next(tokens)) == NULL)
+                return tokens->failed ? -1 : 0;
+
+            {
+                /* The descriptor is overwritten once values are peeked, so it is copied out first. */
+                const char *token = current->text;
+                size_t token_length = current->length;
+                size_t token_equals = current->equals;
+                int kind = cursor->only_positionals ? ARGPARSER_TOKEN_POSITIONAL : current->kind;
+
+                if (kind == ARGPARSER_TOKEN_SEPARATOR)
+                {
+                    cursor->only_positionals = true;
+                    if (result->keep_unknown && tokens->argv[tokens->index - 1] == token)
+                        cursor->separator = tokens->argv[tokens->index - 1];
+                    continue;
+                }
+
+                if (kind == ARGPARSER_TOKEN_LONG)
+                {
+                    ARGPARSER_STAT_START(resolve);
+                    int slot;
+                    const char *name = token + 2;
+                    const char *equals = token_equals < token_length ? token + token_equals : NULL;
+                    size_t length = token_equals - 2;
+                    Argument_t *argument = argparser_index_lookup(parser, result, name, length, true);
+                    bool ambiguous = false;
+
+                    if (argument == NULL && parser->allow_abbrev)
+                    {
+                        const ArgumentTrieNode_t *trie = parser->trie ? parser->trie : argparser_result_trie(parser, result);
+
+                        if (trie == NULL)
+                        {
+                            argparser_fail(parser, result, PARSE, parser->program, "out of memory");
+                            return -1;
+                        }
+                        argument = argparser_find_abbrev(parser, trie, name, length, &ambiguous);
+                    }
+
+                    ARGPARSER_STAT_STOP(result, resolve_ns, resolve);
+                    if (ambiguous)
+                    {
+                        argparser_fail(parser, result, PARSE, token, "ambiguous option");
+                        return -1;
+                    }
+
+                    slot = argument ? (int)(argument - parser->arguments) : -1;
+
+                    if (slot < 0 || result->hot[slot].type == ARG)
+                    {
+                        if (result->keep_unknown && argparser_keep_unknown(result, tokens, token, &cursor->separator) == ARGPARSER_SUCCESS)
+                            continue;
+                        argparser_fail(parser, result, PARSE, token, "unrecognized argument");
+                        return -1;
+                    }
+                    if (argparser_mark_used(parser, result, slot, token) != ARGPARSER_SUCCESS)
+                        return -1;
+                    if (argparser_hot_flag(result, slot, ARGPARSER_HOT_EXIT))
+                    {
+                        argparser_exit(parser, result, slot);
+                        return -1;
+                    }
+
+                    if (result->hot[slot].type == FLAG)
+                    {
+                        if (equals != NULL)
+                        {
+                            argparser_fail(parser, result, PARSE, token, "flag does not take a value");
+                            return -1;
+                        }
+                        match->argument = argument;
+                        match->value.data = NULL;
+                        match->value.size = 0;
+                        return 1;
+                    }
+
+                    if ((status = argparser_step_option(parser, result, cursor, slot, equals ? equals + 1 : NULL, token_length - token_equals - 1, match)) != 0)
+                        return status;
+                    continue;
+                }
+
+                if (kind == ARGPARSER_TOKEN_SHORT)
+                {
+                    cursor->cluster_token = token;
+                    cursor->cluster_length = token_length;
+                    cursor->cluster = token + 1;
+                    continue;
+                }
+
+                ARGPARSER_STAT_START(resolve);
+                while (cursor->positional < parser->count &&
+                       (result->hot[cursor->positional].type != ARG ||
+                        (uint32_t)result->values[cursor->positional].stored_count >= result->hot[cursor->positional].narg_max))
+                    cursor->positional++;
+                ARGPARSER_STAT_STOP(result, resolve_ns, resolve);
+
+                if (cursor->positional == parser->count)
+                {
+                    int command = argparser_find_subcommand(parser, token, token_length);
+
+                    if (command < 0 && result->keep_unknown && parser->subcommand_count == 0 &&
+                        argparser_keep_unknown(result, tokens, token, &cursor->separator) == ARGPARSER_SUCCESS)
+                        continue;
+                    if (command < 0)
+                    {
+                        argparser_fail(parser, result, PARSE, token, parser->subcommand_count ? "invalid subcommand" : "unrecognized argument");
+                        return -1;
+                    }
+                    /* The rest of argv or the source goes to the subcommand, so its name cannot come from a response file. */
+                    if (tokens->source != NULL ? tokens->sourced != token : tokens->argv[tokens->index - 1] != token)
+                    {
+                        argparser_fail(parser, result, PARSE, token, "subcommand must be given on the command line");
+                        return -1;
+                    }
+
+                    result->subcommand = command + 1;
+                    result->subcommand_index = tokens->index - 1;
+                    return 0;
+                }
+
+                result->used[cursor->positional / 64] |= (uint64_t)1 << (cursor->positional % 64);
+                result->values[cursor->positional].occurrences++;
+                return argparser_step_store(parser, result, cursor->positional, token, token_length, match);
+            }
+        }
     };
 
-    /** Errors that occur during regular parsing
+    static bool argparser_env_derived(const ArgumentParser_t *parser, const Argument_t *argument)
+    {
+        return argument->env == NULL && parser->env_prefix != NULL && argument->type != ARG && !argument->is_exit;
+    };
+
+    /* Returns the bytes the derived names take, and sets the table size to twice the variables. */
+    static size_t argparser_env_size(const ArgumentParser_t *parser, size_t *capacity)
+    {
+        size_t prefix = parser->env_prefix ? strlen(parser->env_prefix) : 0;
+        size_t count = 0;
+        size_t bytes = 0;
+
+        for (int i = 0; i < parser->count; i++)
+        {
+            const Argument_t *argument = &parser->arguments[i];
+
+            if (argument->env != NULL)
+                count++;
+            else if (argparser_env_derived(parser, argument))
+            {
+                count++;
+                bytes += prefix + strlen(argument->dest) + 1;
+            }
+        }
+
+        *capacity = 0;
+        if (count > 0)
+        {
+            *capacity = 8;
+            while (*capacity < 2 * count)
+                *capacity *= 2;
+        }
+        return bytes;
+    };
+
+    static void argparser_build_env(const ArgumentParser_t *parser, ArgumentEnvEntry_t *table, size_t capacity, char *names)
+    {
+        size_t prefix = parser->env_prefix ? strlen(parser->env_prefix) : 0;
+
+        memset(table, 0, capacity * sizeof(ArgumentEnvEntry_t));
+        for (int i = 0; i < parser->count; i++)
+        {
+            const Argument_t *argument = &parser->arguments[i];
+            const char *name = argument->env;
+            size_t length;
+            uint32_t hash;
+            size_t pos;
+
+            if (name == NULL)
+            {
+                if (!argparser_env_derived(parser, argument))
+                    continue;
+
+                /* "APP_" and "dry_run" give "APP_DRY_RUN". */
+                memcpy(names, parser->env_prefix, prefix);
+                length = prefix;
+                for (const char *c = argument->dest; *c != '\0'; c++)
+                    names[length++] = (char)(*c >= 'a' && *c <= 'z' ? *c - 'a' + 'A' : *c);
+                names[length] = '\0';
+                name = names;
+                names += length + 1;
+            }
+            else
+                length = strlen(name);
+
+            hash = argparser_hash(name, length);
+            pos = hash & (capacity - 1);
+            while (table[pos].slot != 0)
+                pos = (pos + 1) & (capacity - 1);
+
+            table[pos].hash = hash;
+            table[pos].slot = i + 1;
+            table[pos].name = name;
+            table[pos].length = length;
+        }
+    };
+
+    /* The environment outlives the parse, so values are stored as views into it. */
+    static int argparser_env_store(const ArgumentParser_t *parser, ArgumentResult_t *result, int slot, const char *variable, const char *value)
+    {
+        size_t size = strlen(value);
+        bool on;
+
+        if (result->hot[slot].type == FLAG)
+        {
+            if (!argparser_parse_bool(value, size, &on))
+                return argparser_fail(parser, result, PARSE, variable, "invalid bool value");
+            return on ? argparser_mark_used(parser, result, slot, variable) : ARGPARSER_SUCCESS;
+        }
+
+        if (argparser_mark_used(parser, result, slot, variable) != ARGPARSER_SUCCESS)
+            return ARGPARSER_FAILURE;
+        return argparser_store_view(parser, result, slot, value, size, false);
+    };
+
+    /* One pass over the environment, each name hashed once whatever the number of variables bound. */
+    static int argparser_read_env(const ArgumentParser_t *parser, ArgumentResult_t *result)
+    {
+        const ArgumentEnvEntry_t *table = parser->env;
+        size_t capacity = parser->env_capacity;
+        char **envp = parser->envp != NULL ? parser->envp : ARGPARSER_ENVIRON;
+
+        if (table == NULL)
+        {
+            size_t bytes = argparser_env_size(parser, &capacity);
+            ArgumentEnvEntry_t *built;
+
+            if (capacity == 0)
+                return ARGPARSER_SUCCESS;
+
+            built = (ArgumentEnvEntry_t *)argparser_arena_alloc(&result->arena, capacity * sizeof(ArgumentEnvEntry_t) + bytes);
+            if (built == NULL)
+                return argparser_fail(parser, result, PARSE, parser->program, "out of memory");
+            argparser_build_env(parser, built, capacity, (char *)(built + capacity));
+            table = built;
+        }
+
+        for (char **entry = envp; entry != NULL && *entry != NULL; entry++)
+        {
+            const char *name = *entry;
+            const char *equals = strchr(name, '=');
+            size_t length;
+            uint32_t hash;
+
+            if (equals == NULL || equals == name)
+                continue;
+
+            length = (size_t)(equals - name);
+            hash = argparser_hash(name, length);
+
+            /* Several arguments may share a variable, so the whole run of the slot is checked. */
+            for (size_t pos = hash & (capacity - 1); table[pos].slot != 0; pos = (pos + 1) & (capacity - 1))
+            {
+                int slot = table[pos].slot - 1;
+
+                if (table[pos].hash != hash || table[pos].length != length || memcmp(table[pos].name, name, length) != 0)
+                    continue;
+                if (result->used[slot / 64] & ((uint64_t)1 << (slot % 64)))
+                    continue;
+                if (argparser_env_store(parser, result, slot, table[pos].name, equals + 1) != ARGPARSER_SUCCESS)
+                    return ARGPARSER_FAILURE;
+            }
+        }
+        return ARGPARSER_SUCCESS;
+    };
+
+    /* Nothing is stored after the option, so neither conversions nor required arguments are checked. */
+    static int argparser_exit(const ArgumentParser_t *parser, ArgumentResult_t *result, int slot)
+    {
+        if (strcmp(result->hot[slot].name, "help") == 0)
+            return argparser_fail(parser, result, HELP, "help", "help requested");
+        return argparser_fail(parser, result, VERSION, result->hot[slot].name, "version requested");
+    };
+
+    /*
+     * Looks through argv for help or version before anything is stored, so
+     * no value is converted nor callback run. Only names are resolved: the
+     * scan stops at "--" or a subcommand, a cluster at a symbol it cannot
+     * split, and response files are left to the parse.
      */
-    class ParseError : public ArgumentError
+    static int argparser_find_exit(const ArgumentParser_t *parser, ArgumentResult_t *result, int argc, char **argv)
     {
-    public:
-        ParseError(ArgumentError_t *error)
-            : ArgumentError(error) {};
+        size_t words = ARGPARSER_BITSET_WORDS(parser->count);
+        uint64_t any = 0;
+        ArgumentToken_t token;
+
+        for (size_t w = 0; w < words; w++)
+            any |= result->flags[ARGPARSER_HOT_EXIT * words + w];
+        if (any == 0)
+            return -1;
+
+        for (int i = 1; i < argc; i++)
+        {
+            argparser_classify(parser, argv[i], &token);
+
+            if (token.kind == ARGPARSER_TOKEN_SEPARATOR)
+                return -1;
+
+            if (token.kind == ARGPARSER_TOKEN_LONG)
+            {
+                const char *name = token.text + 2;
+                size_t length = token.equals - 2;
+                Argument_t *argument = argparser_index_lookup(parser, result, name, length, true);
+                bool ambiguous = false;
+
+                if (argument == NULL && parser->allow_abbrev)
+                {
+                    const ArgumentTrieNode_t *trie = parser->trie ? parser->trie : argparser_result_trie(parser, result);
+
+                    if (trie != NULL)
+                        argument = argparser_find_abbrev(parser, trie, name, length, &ambiguous);
+                }
+                if (argument != NULL && !ambiguous && argparser_hot_flag(result, (int)(argument - parser->arguments), ARGPARSER_HOT_EXIT))
+                    return (int)(argument - parser->arguments);
+            }
+            else if (token.kind == ARGPARSER_TOKEN_SHORT)
+            {
+                for (const char *c = token.text + 1; *c != '\0'; c++)
+                {
+                    int slot = parser->symbols[(unsigned char)*c] - 1;
+
+                    if (slot < 0)
+                        break;
+                    if (argparser_hot_flag(result, slot, ARGPARSER_HOT_EXIT))
+                        return slot;
+                    /* The rest of the cluster is a value. */
+                    if (result->hot[slot].type != FLAG)
+                        break;
+                }
+            }
+            else if (parser->subcommand_count > 0 && argparser_find_subcommand(parser, token.text, token.length) >= 0)
+                return -1;
+        }
+        return -1;
+    };
+
+    /* Stable and in place: the kept prefix of argv never passes the token being read. */
+    static int argparser_keep_unknown(ArgumentResult_t *result, ArgumentTokens_t *tokens, const char *token, char **separator)
+    {
+        /* A response file is released by the next parse, so its tokens cannot be handed back. */
+        if (tokens->argv[tokens->index - 1] != token)
+            return ARGPARSER_FAILURE;
+
+        if (*separator != NULL)
+        {
+            tokens->argv[result->remaining++] = *separator;
+            *separator = NULL;
+        }
+        tokens->argv[result->remaining++] = tokens->argv[tokens->index - 1];
+        return ARGPARSER_SUCCESS;
+    };
+
+    ARGPARSER_API int argparser_parse_args(ArgumentParser_t *parser, int argc, char **argv)
+    {
+        ARGPARSER_ASSERT(parser);
+
+        if (parser->program == NULL && argc > 0)
+        {
+            parser->program = argparser_arena_strdup(&parser->arena, argv[0]);
+            argparser_invalidate(parser);
+        }
+        if (!parser->is_frozen)
+            argparser_cache_help(parser);
+        if (parser->allow_abbrev)
+            argparser_build_trie(parser);
+        argparser_cache_hot(parser);
+
+        parser->result.status = argparser_run(parser, &parser->result, argc, argv);
+
+        argparser_adopt_error(parser, &parser->result.error);
+
+        if (parser->result.status == ARGPARSER_SUCCESS && parser->result.subcommand != 0)
+        {
+            int index = parser->result.subcommand_index;
+            ArgumentParser_t *subparser = argparser_build_subcommand(parser, parser->result.subcommand - 1);
+
+            if (subparser == NULL)
+                return parser->result.status = ARGPARSER_FAILURE;
+
+            subparser->result.keep_unknown = parser->result.keep_unknown;
+            parser->result.status = argparser_parse_args(subparser, argc - index, argv + index);
+            subparser->result.keep_unknown = false;
+            argparser_adopt_error(parser, &subparser->error);
+
+            /* What the subcommand kept follows what was kept before its name. */
+            if (parser->result.keep_unknown && parser->result.status == ARGPARSER_SUCCESS)
+            {
+                int kept = subparser->result.remaining - 1;
+
+                memmove(argv + parser->result.remaining, argv + index + 1, (size_t)kept * sizeof(char *));
+                parser->result.remaining += kept;
+            }
+        }
+        return parser->result.status;
+    };
+
+    ARGPARSER_API int argparser_parse_known_args(ArgumentParser_t *parser, int argc, char **argv)
+    {
+        int status;
+
+        ARGPARSER_ASSERT(parser);
+
+        parser->result.keep_unknown = true;
+        status = argparser_parse_args(parser, argc, argv);
+        parser->result.keep_unknown = false;
+
+        if (status != ARGPARSER_SUCCESS)
+            return -1;
+        if (parser->result.remaining < argc)
+            argv[parser->result.remaining] = NULL;
+        return parser->result.remaining;
+    };
+
+    /* Moves an error raised elsewhere to parser->error, replacing the one there. */
+    static void argparser_adopt_error(ArgumentParser_t *parser, ArgumentError_t **error)
+    {
+        if (*error == NULL)
+            return;
+        if (parser->error != NULL)
+            argparser_error_delete(parser->error);
+        parser->error = *error;
+        *error = NULL;
+    };
+
+    /* Prepares the parser like argparser_parse_args(), with the cursor in the result arena. */
+    static int argparser_begin_run(ArgumentParser_t *parser, int argc, char **argv, ArgumentSource_t source, void *data)
+    {
+        ArgumentResult_t *result = &parser->result;
+        ArgumentCursor_t cursor;
+
+        if (parser->program == NULL && argc > 0)
+        {
+            parser->program = argparser_arena_strdup(&parser->arena, argv[0]);
+            argparser_invalidate(parser);
+        }
+        if (parser->allow_abbrev)
+            argparser_build_trie(parser);
+        argparser_cache_hot(parser);
+
+        result->keep_unknown = false;
+        result->status = argparser_run_start(parser, result, &cursor, argc, argv, source, data);
+        if (result->status == ARGPARSER_SUCCESS)
+        {
+            result->cursor = (ArgumentCursor_t *)argparser_arena_alloc(&result->arena, sizeof(ArgumentCursor_t));
+            if (result->cursor == NULL)
+                result->status = argparser_fail(parser, result, PARSE, parser->program, "out of memory");
+            else
+                memcpy(result->cursor, &cursor, sizeof(ArgumentCursor_t));
+        }
+        else
+            result->cursor = NULL;
+
+        argparser_adopt_error(parser, &result->error);
+        return result->status;
+    };
+
+    ARGPARSER_API int argparser_begin(ArgumentParser_t *parser, int argc, char **argv)
+    {
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(argv || argc == 0);
+
+        return argparser_begin_run(parser, argc, argv, NULL, NULL);
+    };
+
+    ARGPARSER_API int argparser_begin_source(ArgumentParser_t *parser, ArgumentSource_t source, void *data)
+    {
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(source);
+
+        return argparser_begin_run(parser, 0, NULL, source, data);
+    };
+
+    ARGPARSER_API int argparser_next(ArgumentParser_t *parser, ArgumentMatch_t *match)
+    {
+        ArgumentResult_t *result;
+        ArgumentCursor_t *cursor;
+        int status;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(match);
+
+        result = &parser->result;
+        cursor = result->cursor;
+        if (cursor == NULL)
+            return -1;
+        if (cursor->subparser != NULL)
+        {
+            ArgumentParser_t *subparser = cursor->subparser;
+
+            status = argparser_next(subparser, match);
+            argparser_adopt_error(parser, &subparser->error);
+            if (status <= 0)
+            {
+                result->status = status == 0 ? ARGPARSER_SUCCESS : ARGPARSER_FAILURE;
+                cursor->subparser = NULL;
+                cursor->is_done = true;
+            }
+            return status;
+        }
+        if (cursor->is_done)
+            return result->status == ARGPARSER_SUCCESS ? 0 : -1;
+
+        status = argparser_step(parser, result, cursor, match);
+        if (status == 0)
+            status = argparser_run_finish(parser, result) == ARGPARSER_SUCCESS ? 0 : -1;
+        if (status <= 0)
+        {
+            cursor->is_done = true;
+            result->status = status == 0 ? ARGPARSER_SUCCESS : ARGPARSER_FAILURE;
+        }
+
+        if (status == 0 && result->subcommand != 0)
+        {
+            ArgumentTokens_t *tokens = &cursor->tokens;
+            ArgumentParser_t *subparser = argparser_build_subcommand(parser, result->subcommand - 1);
+
+            /* The subparser goes on from its name, in argv or the source. */
+            if (subparser == NULL)
+                status = -1;
+            else if (tokens->source != NULL)
+                status = argparser_begin_source(subparser, tokens->source, tokens->source_data) == ARGPARSER_SUCCESS ? 1 : -1;
+            else
+                status = argparser_begin(subparser, tokens->argc - result->subcommand_index, tokens->argv + result->subcommand_index) == ARGPARSER_SUCCESS ? 1 : -1;
+
+            if (status > 0)
+            {
+                cursor->subparser = subparser;
+                cursor->is_done = false;
+                return argparser_next(parser, match);
+            }
+            if (subparser != NULL)
+                argparser_adopt_error(parser, &subparser->error);
+            result->status = ARGPARSER_FAILURE;
+        }
+
+        argparser_adopt_error(parser, &result->error);
+        return status;
+    };
+
+    ARGPARSER_API int argparser_parse_into(const ArgumentParser_t *parser, ArgumentResult_t *result, int argc, char **argv)
+    {
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(result);
+
+        result->status = argparser_run(parser, result, argc, argv);
+        return result->status;
+    };
+
+    ARGPARSER_API ArgumentErrorType argparser_try_parse(const ArgumentParser_t *parser, ArgumentResult_t *result, int argc, char **argv, ArgumentErrorBuffer_t *error)
+    {
+        ArgumentErrorBuffer_t scratch;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(result);
+
+        if (error == NULL)
+            error = &scratch;
+        argparser_error_fill(error, NONE, "", "");
+
+        result->error_buffer = error;
+        result->status = argparser_run(parser, result, argc, argv);
+        result->error_buffer = NULL;
+
+        return result->status == ARGPARSER_SUCCESS ? NONE : error->error.type;
     };
 
-    /** Errors that when a required flag is omitted
-     */
-    class RequiredError : public ArgumentError
+    ARGPARSER_API void argparser_freeze(ArgumentParser_t *parser)
     {
-    public:
-        RequiredError(ArgumentError_t *error)
-            : ArgumentError(error) {};
-    };
+        ARGPARSER_ASSERT(parser);
 
-}; // namespace argparser
+        /* Built now, so threads sharing the parser only ever read the help and trie. A loaded blob keeps its own. */
+        if (!parser->tables_are_static)
+            argparser_invalidate(parser);
+        else
+            parser->hot = NULL;
+        argparser_cache_help(parser);
+        argparser_build_trie(parser);
 
-#endif //__cplusplus
+        for (int i = 0; i < parser->count; i++)
+            argparser_convert_config(parser, &parser->arguments[i]);
 
-#pragma endregion // Cpp
+        /* The entries, then the derived variable names they point to. */
+        if (parser->env_prefix != NULL || parser->env_count > 0)
+        {
+            size_t capacity;
+            size_t bytes = argparser_env_size(parser, &capacity);
 
-#endif // ARGPARSER_H
+            parser->env = capacity ? (ArgumentEnvEntry_t *)argparser_arena_alloc(&parser->arena, capacity * sizeof(ArgumentEnvEntry_t) + bytes) : NULL;
+            parser->env_capacity = parser->env != NULL ? capacity : 0;
+            if (parser->env != NULL)
+                argparser_build_env(parser, parser->env, capacity, (char *)(parser->env + capacity));
+        }
 
-#pragma region Implementation
+        argparser_cache_hot(parser);
 
-#ifdef ARGPARSER_IMPLEMENTATION
+        /* Shared subparsers cannot be built on first use, so the whole tree is built and frozen now. */
+        for (int i = 0; i < parser->subcommand_count; i++)
+        {
+            ArgumentParser_t *subparser = argparser_build_subcommand(parser, i);
 
-#pragma region Internal
+            if (subparser != NULL)
+                argparser_freeze(subparser);
+        }
+        parser->is_frozen = true;
+    };
 
-//-----------------------------------------------------------------------------
-// [SECTION] Defines
-//-----------------------------------------------------------------------------
+    ARGPARSER_API void argparser_reset(ArgumentParser_t *parser)
+    {
+        ARGPARSER_ASSERT(parser);
 
-//-----------------------------------------------------------------------------
-// [SECTION] Data Structures
-//-----------------------------------------------------------------------------
+        if (parser->error != NULL)
+            argparser_error_delete(parser->error);
+        parser->error = NULL;
 
-//-----------------------------------------------------------------------------
-// [SECTION] C Only Functions
-//-----------------------------------------------------------------------------
+        argparser_unmap_files(&parser->result);
+        argparser_arena_reset(&parser->result.arena);
+        parser->result.values = NULL;
+        parser->result.count = 0;
+        parser->result.status = ARGPARSER_SUCCESS;
+    };
 
-#pragma region C
+    ARGPARSER_API int argparser_parse_batch(const ArgumentParser_t *parser, int n, const int *argcs, char **const *argvs, ArgumentResult_t *results)
+    {
+        int status = ARGPARSER_SUCCESS;
 
-#ifdef __cplusplus
-extern "C"
-{
-#endif // __cplusplus
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(n == 0 || (argcs && argvs && results));
 
-    //-----------------------------------------------------------------------------
-    // [SECTION] Declarations
-    //-----------------------------------------------------------------------------
+        for (int i = 0; i < n; i++)
+        {
+            if (argparser_parse_into(parser, &results[i], argcs[i], argvs[i]) != ARGPARSER_SUCCESS)
+                status = ARGPARSER_FAILURE;
+        }
+        return status;
+    };
 
-    //-----------------------------------------------------------------------------
-    // [SECTION] Definations
-    //-----------------------------------------------------------------------------
+    ARGPARSER_API void argparser_result_initialize(ArgumentResult_t *result, void *buffer, size_t size)
+    {
+        ARGPARSER_ASSERT(result);
 
-#ifdef __cplusplus
-}
-#endif // __cplusplus
+        memset(result, 0, sizeof(ArgumentResult_t));
+        argparser_arena_borrow(&result->arena, buffer, size);
+    };
 
-#pragma endregion // C
+    ARGPARSER_API void argparser_result_delete(ArgumentResult_t *result)
+    {
+        ARGPARSER_ASSERT(result);
 
-//-----------------------------------------------------------------------------
-// [SECTION] C++ Only Classes
-//-----------------------------------------------------------------------------
+        if (result->error != NULL)
+            argparser_error_delete(result->error);
 
-#pragma region Cpp
+        argparser_unmap_files(result);
+        argparser_arena_release(&result->arena);
+        memset(result, 0, sizeof(ArgumentResult_t));
+    };
 
-#ifdef __cplusplus
+    ARGPARSER_API const char *argparser_get_arg(ArgumentParser_t *parser, const char *name)
+    {
+        return argparser_result_get_arg(parser, &parser->result, name);
+    };
 
-namespace argparser
-{
+    ARGPARSER_API const char *argparser_get_arg_at(ArgumentParser_t *parser, int slot)
+    {
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(slot >= 0 && slot < parser->count);
 
-    //-----------------------------------------------------------------------------
-    // [SECTION] Declarations
-    //-----------------------------------------------------------------------------
+        return argparser_value_of(&parser->arguments[slot], argparser_record_of(parser, &parser->result, &parser->arguments[slot]));
+    };
 
-    class Argument
+    ARGPARSER_API int64_t argparser_get_int(ArgumentParser_t *parser, const char *name)
     {
-    public:
-        Argument();
-        ~Argument();
+        int64_t value = argparser_result_get_int(parser, &parser->result, name);
 
-        Argument &flag();
+        argparser_adopt_error(parser, &parser->result.error);
+        return value;
+    };
 
-        Argument &nargs(std::size_t num_args);
+    ARGPARSER_API double argparser_get_double(ArgumentParser_t *parser, const char *name)
+    {
+        double value = argparser_result_get_double(parser, &parser->result, name);
 
-        Argument &nargs(Nargs pattern);
-        Argument &nargs(std::size_t num_args);
-        Argument &nargs(std::size_t nargs_min, std::size_t nargs_max);
+        argparser_adopt_error(parser, &parser->result.error);
+        return value;
+    };
 
-        Argument &help(std::string help_text);
-        Argument &dest(std::string dest);
-        Argument &metavar(std::string metavar);
+    ARGPARSER_API bool argparser_get_bool(ArgumentParser_t *parser, const char *name)
+    {
+        bool value = argparser_result_get_bool(parser, &parser->result, name);
 
-        Argument &hidden();
-        Argument &repeat();
-        Argument &required();
-        Argument &stored_count();
+        argparser_adopt_error(parser, &parser->result.error);
+        return value;
+    };
 
-        Argument &implicit_value(bool value);
+    ARGPARSER_API int argparser_get_enum(ArgumentParser_t *parser, const char *name)
+    {
+        int value = argparser_result_get_enum(parser, &parser->result, name);
 
-        template <typename T>
-        Argument &implicit_value(T &value);
+        argparser_adopt_error(parser, &parser->result.error);
+        return value;
+    };
 
-        template <typename T>
-        Argument &default_value(T &&value);
+    ARGPARSER_API const char *argparser_get_subcommand(ArgumentParser_t *parser)
+    {
+        return argparser_result_get_subcommand(parser, &parser->result);
+    };
 
-    private:
-        explicit Argument();
+    ARGPARSER_API const int64_t *argparser_get_int_list(ArgumentParser_t *parser, const char *name, size_t *count)
+    {
+        const int64_t *values = argparser_result_get_int_list(parser, &parser->result, name, count);
 
-    private:
-        Argument_t m_Argument;
+        argparser_adopt_error(parser, &parser->result.error);
+        return values;
     };
 
-    //-----------------------------------------------------------------------------
-    // [SECTION] Definations
-    //-----------------------------------------------------------------------------
+    ARGPARSER_API const double *argparser_get_double_list(ArgumentParser_t *parser, const char *name, size_t *count)
+    {
+        const double *values = argparser_result_get_double_list(parser, &parser->result, name, count);
 
-    Argument::Argument() {
+        argparser_adopt_error(parser, &parser->result.error);
+        return values;
     };
 
-    Argument::~Argument() {
+    ARGPARSER_API const ArgumentView_t *argparser_get_values(ArgumentParser_t *parser, const char *name, int *count)
+    {
+        return argparser_result_get_values(parser, &parser->result, name, count);
     };
 
-    Argument &Argument::flag()
+    ARGPARSER_API const char *argparser_result_get_arg(const ArgumentParser_t *parser, const ArgumentResult_t *result, const char *name)
     {
-        default_value(false);
-        implicit_value(true);
-        return *this;
+        Argument_t *argument;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(result);
+        ARGPARSER_ASSERT(name);
+
+        argument = argparser_index_find(parser, name, strlen(name), false);
+        return argument ? argparser_value_of(argument, argparser_record_of(parser, result, argument)) : NULL;
     };
 
-    Argument &Argument::nargs(Nargs pattern)
+    ARGPARSER_API const ArgumentView_t *argparser_result_get_values(const ArgumentParser_t *parser, const ArgumentResult_t *result, const char *name, int *count)
     {
-        switch (pattern)
+        Argument_t *argument;
+        const ArgumentValue_t *record;
+
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(result);
+        ARGPARSER_ASSERT(name);
+        ARGPARSER_ASSERT(count);
+
+        argument = argparser_index_find(parser, name, strlen(name), false);
+        if (argument == NULL)
         {
-        case OPTIONAL:
-            m_Argument.narg_min = 0;
-            m_Argument.narg_max = 1;
-            break;
-        case ZERO_OR_MORE:
-            m_Argument.narg_min = 0;
-            m_Argument.narg_max = sizeof(size_t);
-            break;
-        case ONE_OR_MORE:
-            m_Argument.narg_min = 1;
-            m_Argument.narg_max = sizeof(size_t);
-            break;
+            *count = 0;
+            return NULL;
         }
-        return *this;
+
+        record = argparser_record_of(parser, result, argument);
+        *count = record->stored_count;
+        if (argument->on_value != NULL && *count > 1)
+            *count = 1;
+
+        if (*count == 0)
+            return NULL;
+        return argparser_is_multiple(argument) ? record->values : &record->value;
     };
 
-    Argument &Argument::nargs(std::size_t num_args)
+    ARGPARSER_API int64_t argparser_result_get_int(const ArgumentParser_t *parser, const ArgumentResult_t *result, const char *name)
     {
-        m_Argument.narg_min = num_args;
-        m_Argument.narg_max = num_args;
+        Argument_t *argument = argparser_index_find(parser, name, strlen(name), false);
+        return argument ? argparser_slot_int(parser, argument, argparser_converted_of(parser, result, argument)) : 0;
     };
 
-    Argument &Argument::nargs(std::size_t nargs_min, std::size_t nargs_max)
+    ARGPARSER_API double argparser_result_get_double(const ArgumentParser_t *parser, const ArgumentResult_t *result, const char *name)
     {
-        m_Argument.narg_min = nargs_min;
-        m_Argument.narg_max = nargs_max;
+        Argument_t *argument = argparser_index_find(parser, name, strlen(name), false);
+        return argument ? argparser_slot_double(parser, argument, argparser_converted_of(parser, result, argument)) : 0.0;
     };
 
-    Argument &Argument::help(std::string help_text)
+    ARGPARSER_API bool argparser_result_get_bool(const ArgumentParser_t *parser, const ArgumentResult_t *result, const char *name)
     {
-        m_Argument.help = const_cast<char *>(std::move(help_text).c_str());
-        return *this;
+        Argument_t *argument = argparser_index_find(parser, name, strlen(name), false);
+        return argument ? argparser_slot_int(parser, argument, argparser_converted_of(parser, result, argument)) != 0 : false;
     };
 
-    Argument &Argument::dest(std::string dest)
+    ARGPARSER_API int argparser_result_get_enum(const ArgumentParser_t *parser, const ArgumentResult_t *result, const char *name)
     {
-        m_Argument.dest = const_cast<char *>(std::move(dest).c_str());
+        Argument_t *argument = argparser_index_find(parser, name, strlen(name), false);
+        const ArgumentSlot_t *slot = argument ? argparser_slot_of(parser, argument, argparser_converted_of(parser, result, argument)) : NULL;
+        return slot && slot->type == VALUE_ENUM ? slot->choice : -1;
     };
 
-    Argument &Argument::metavar(std::string metavar)
+    ARGPARSER_API const int64_t *argparser_result_get_int_list(const ArgumentParser_t *parser, const ArgumentResult_t *result, const char *name, size_t *count)
     {
-        m_Argument.metavar = const_cast<char *>(std::move(metavar).c_str());
+        const ArgumentList_t *list = argparser_list_of(parser, result, name, VALUE_INT_LIST);
+
+        *count = list ? list->count : 0;
+        return list ? list->ints : NULL;
     };
 
-    Argument &Argument::implicit_value(bool value)
+    ARGPARSER_API const double *argparser_result_get_double_list(const ArgumentParser_t *parser, const ArgumentResult_t *result, const char *name, size_t *count)
     {
-        return *this;
-    }
+        const ArgumentList_t *list = argparser_list_of(parser, result, name, VALUE_DOUBLE_LIST);
 
-    Argument &Argument::hidden()
-    {
-        m_Argument.is_hidden = true;
-        return *this;
+        *count = list ? list->count : 0;
+        return list ? list->doubles : NULL;
     };
 
-    Argument &Argument::repeat()
+    ARGPARSER_API const char *argparser_result_get_subcommand(const ArgumentParser_t *parser, const ArgumentResult_t *result)
     {
-        m_Argument.is_repeatable = true;
-        return *this;
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(result);
+
+        return result->subcommand > 0 && result->subcommand <= parser->subcommand_count ? parser->subcommands[result->subcommand - 1].name : NULL;
     };
 
-    Argument &Argument::required()
+    ARGPARSER_API void argparser_print_help(ArgumentParser_t *parser)
     {
-        m_Argument.is_required = true;
-        return *this;
+        ARGPARSER_ASSERT(parser);
+
+        if (argparser_cache_help(parser))
+            fwrite(parser->help, 1, parser->help_size, stdout);
+        else
+            argparser_emit(parser, stdout, argparser_render_help);
     };
 
-    Argument &Argument::stored_count()
+    ARGPARSER_API size_t argparser_format_help(ArgumentParser_t *parser, char *buf, size_t len)
     {
-        m_Argument.store_count = true;
+        ArgumentWriter_t writer;
+
+        ARGPARSER_ASSERT(parser);
+
+        if (argparser_cache_help(parser))
+        {
+            if (len > 0)
+            {
+                size_t size = parser->help_size < len ? parser->help_size : len - 1;
+                memcpy(buf, parser->help, size);
+                buf[size] = '\0';
+            }
+            return parser->help_size;
+        }
+
+        writer.data = buf;
+        writer.capacity = len;
+        writer.length = 0;
+        argparser_render_help(parser, &writer);
+        return writer.length;
     };
 
-}; // namespace argparser
+    ARGPARSER_API int argparser_complete(ArgumentParser_t *parser, const char *prefix, const char **names, int max)
+    {
+        const char *start = prefix;
+        int count = 0;
+        int node;
 
-#endif //__cplusplus
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(prefix);
 
-#pragma endregion // Cpp
+        if (!argparser_build_trie(parser))
+            return 0;
 
-#pragma endregion // Internal
+        while (*prefix == parser->prefix_char)
+            prefix++;
 
-#pragma region Argparser
+        node = argparser_trie_walk(parser->trie, prefix, strlen(prefix));
+        if (node >= 0)
+            argparser_trie_collect(parser, node, names, max, &count);
 
-//-----------------------------------------------------------------------------
-// [SECTION] C Only Functions
-//-----------------------------------------------------------------------------
+        if (prefix != start)
+            return count;
+        for (int i = 0; i < parser->subcommand_count; i++)
+        {
+            if (strncmp(parser->subcommands[i].name, prefix, strlen(prefix)) != 0)
+                continue;
+            if (count < max)
+                names[count] = parser->subcommands[i].name;
+            count++;
+        }
+        return count;
+    };
 
-#pragma region C
+    ARGPARSER_API int argparser_complete_args(ArgumentParser_t *parser, int argc, char **argv, const char **names, int max)
+    {
+        ARGPARSER_ASSERT(parser);
+        ARGPARSER_ASSERT(argv || argc == 0);
 
-#ifdef __cplusplus
-extern "C"
-{
-#endif // __cplusplus
+        for (int i = 1; i < argc - 1; i++)
+        {
+            int index = argv[i][0] == parser->prefix_char ? -1 : argparser_find_subcommand(parser, argv[i], strlen(argv[i]));
+
+            if (index < 0)
+                continue;
+            parser = argparser_build_subcommand(parser, index);
+            if (parser == NULL)
+                return 0;
+        }
+        return argparser_complete(parser, argc > 1 ? argv[argc - 1] : "", names, max);
+    };
 
     ARGPARSER_API void argparser_error_initialize(ArgumentError_t *error, ArgumentErrorType type, char *argument, char *message)
     {
         ARGPARSER_ASSERT(error);
 
+        size_t argument_size = strlen(argument ? argument : "") + 1;
+        size_t message_size = strlen(message ? message : "") + 1;
+        char *buffer = (char *)ARGPARSER_MALLOC(argument_size + message_size);
+
         error->type = type;
-        error->argument = strdup(argument);
-        error->message = strdup(message);
+        error->argument = buffer;
+        error->message = buffer ? buffer + argument_size : NULL;
+        error->is_borrowed = false;
+
+        if (buffer != NULL)
+        {
+            memcpy(error->argument, argument ? argument : "", argument_size);
+            memcpy(error->message, message ? message : "", message_size);
+        }
     };
 
     ARGPARSER_API void argparser_error_delete(ArgumentError_t *error)
     {
-        free(error->argument);
-        free(error->message);
-        free(error);
+        if (error->is_borrowed)
+            return;
+
+        /* The message shares the allocation of the argument. */
+        ARGPARSER_FREE(error->argument);
+        ARGPARSER_FREE(error);
     };
 
     ARGPARSER_API const char *argparser_error_arg(ArgumentError_t *error)
@@ -1297,28 +8166,215 @@ namespace argparser
     ArgumentError::ArgumentError(ArgumentError_t *error)
     {
         m_Error = error;
+
+        /* An error in a result arena is rewound by the next parse, so the exception keeps a copy. */
+        if (error != NULL && error->is_borrowed)
+        {
+            m_Error = (ArgumentError_t *)ARGPARSER_MALLOC(sizeof(ArgumentError_t));
+            if (m_Error != NULL)
+                argparser_error_initialize(m_Error, error->type, error->argument, error->message);
+        }
+    };
+
+    ArgumentError::ArgumentError(const ArgumentError &other)
+    {
+        m_Error = (ArgumentError_t *)ARGPARSER_MALLOC(sizeof(ArgumentError_t));
+        if (m_Error != NULL)
+            argparser_error_initialize(m_Error, other.type(), (char *)other.argument(), (char *)other.what());
     };
 
     ArgumentError::~ArgumentError()
     {
-        argparser_error_delete(m_Error);
+        if (m_Error != NULL)
+            argparser_error_delete(m_Error);
     };
 
     const char *ArgumentError::argument() const noexcept
     {
-        return argparser_error_arg(m_Error);
+        return m_Error ? argparser_error_arg(m_Error) : "";
     };
 
     const char *ArgumentError::what() const noexcept
     {
-        return argparser_error_what(m_Error);
+        return m_Error ? argparser_error_what(m_Error) : "";
     };
 
     ArgumentErrorType ArgumentError::type() const noexcept
     {
-        return argparser_error_type(m_Error);
+        return m_Error ? argparser_error_type(m_Error) : UKNOWN;
+    };
+
+    ParseResult::ParseResult(const ArgumentParser_t *parser) noexcept
+        : m_Parser(parser), m_Type(NONE)
+    {
+        argparser_result_initialize(&m_Result, NULL, 0);
+        argparser_error_fill(&m_Error, NONE, "", "");
+    };
+
+    /* The error strings point into the buffer they live in, so they are moved by offset. */
+    ParseResult::ParseResult(ParseResult &&other) noexcept
+        : m_Parser(other.m_Parser), m_Result(other.m_Result), m_Error(other.m_Error), m_Type(other.m_Type)
+    {
+        m_Error.error.argument = m_Error.text;
+        m_Error.error.message = m_Error.text + (other.m_Error.error.message - other.m_Error.text);
+        argparser_result_initialize(&other.m_Result, NULL, 0);
+    };
+
+    ParseResult::~ParseResult()
+    {
+        argparser_result_delete(&m_Result);
+    };
+
+    bool ParseResult::has_value() const noexcept
+    {
+        return m_Type == NONE;
+    };
+
+    ParseResult::operator bool() const noexcept
+    {
+        return m_Type == NONE;
+    };
+
+    ArgumentErrorType ParseResult::error() const noexcept
+    {
+        return m_Type;
+    };
+
+    const char *ParseResult::what() const noexcept
+    {
+        return m_Error.error.message;
+    };
+
+    const char *ParseResult::argument() const noexcept
+    {
+        return m_Error.error.argument;
+    };
+
+    const ArgumentResult_t *ParseResult::result() const noexcept
+    {
+        return &m_Result;
+    };
+
+    ParseResult try_parse(const ArgumentParser_t *parser, int argc, char **argv) noexcept
+    {
+        ParseResult result(parser);
+        result.m_Type = argparser_try_parse(parser, &result.m_Result, argc, argv, &result.m_Error);
+        return result;
+    };
+
+#if ARGPARSER_HAS_COROUTINES
+    Matches Matches::promise_type::get_return_object() noexcept
+    {
+        return Matches(std::coroutine_handle<promise_type>::from_promise(*this));
+    };
+
+    std::suspend_always Matches::promise_type::initial_suspend() noexcept
+    {
+        return {};
+    };
+
+    std::suspend_always Matches::promise_type::final_suspend() noexcept
+    {
+        return {};
+    };
+
+    std::suspend_always Matches::promise_type::yield_value(const ArgumentMatch_t &match) noexcept
+    {
+        current = &match;
+        return {};
+    };
+
+    void Matches::promise_type::return_void() noexcept {};
+
+    void Matches::promise_type::unhandled_exception() noexcept
+    {
+        error = std::current_exception();
+    };
+
+    Matches::iterator::iterator(std::coroutine_handle<promise_type> handle)
+        : m_Handle(handle)
+    {
+        resume();
+    };
+
+    void Matches::iterator::resume()
+    {
+        m_Handle.resume();
+        if (m_Handle.done() && m_Handle.promise().error)
+            std::rethrow_exception(std::exchange(m_Handle.promise().error, nullptr));
+    };
+
+    const ArgumentMatch_t &Matches::iterator::operator*() const noexcept
+    {
+        return *m_Handle.promise().current;
     };
 
+    const ArgumentMatch_t *Matches::iterator::operator->() const noexcept
+    {
+        return m_Handle.promise().current;
+    };
+
+    Matches::iterator &Matches::iterator::operator++()
+    {
+        resume();
+        return *this;
+    };
+
+    void Matches::iterator::operator++(int)
+    {
+        ++*this;
+    };
+
+    bool Matches::iterator::operator==(std::default_sentinel_t) const noexcept
+    {
+        return !m_Handle || m_Handle.done();
+    };
+
+    Matches::Matches(std::coroutine_handle<promise_type> handle) noexcept
+        : m_Handle(handle) {};
+
+    Matches::Matches(Matches &&other) noexcept
+        : m_Handle(std::exchange(other.m_Handle, nullptr)) {};
+
+    Matches::~Matches()
+    {
+        if (m_Handle)
+            m_Handle.destroy();
+    };
+
+    Matches::iterator Matches::begin()
+    {
+        return iterator(m_Handle);
+    };
+
+    std::default_sentinel_t Matches::end() const noexcept
+    {
+        return {};
+    };
+
+    Matches matches(ArgumentParser_t *parser, int argc, char **argv)
+    {
+        ArgumentMatch_t match;
+        int status = argparser_begin(parser, argc, argv) == ARGPARSER_SUCCESS ? 1 : -1;
+
+        while (status > 0 && (status = argparser_next(parser, &match)) > 0)
+            co_yield match;
+
+        if (status < 0)
+        {
+            ArgumentError_t *error = parser->error;
+            ArgumentErrorType type = error ? argparser_error_type(error) : PARSE;
+
+            parser->error = NULL;
+            if (type == REQUIRED)
+                throw RequiredError(error);
+            if (type == USAGE)
+                throw UsageError(error);
+            throw ParseError(error);
+        }
+    };
+#endif
+
 }; // namespace argparser
 
 #endif //__cplusplus
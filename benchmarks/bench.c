@@ -0,0 +1,281 @@
+/**
+ * @file bench.c
+ * @brief Benchmarks of the parse, lookup and help paths.
+ *
+ * Every measurement is printed as one JSON object per line, so runs can be
+ * stored and compared between releases:
+ *
+ * @code
+ * {"bench":"parse","options":100,"tokens":10000,"zero_copy":false,"iterations":200,"ns_per_op":...,"ns_per_token":...,"allocs_per_op":0.00}
+ * @endcode
+ *
+ * Example usage:
+ * ./argparser_bench --quick --filter parse
+ */
+
+#include <stdlib.h>
+#include <time.h>
+
+static size_t bench_allocs;
+
+static void *bench_malloc(size_t size)
+{
+    bench_allocs++;
+    return malloc(size);
+}
+
+#define ARGPARSER_MALLOC(size) bench_malloc(size)
+#define ARGPARSER_FREE(ptr) free(ptr)
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+
+/** Smallest number of tokens a measurement covers, to keep timings stable. */
+#define BENCH_MIN_TOKENS 2000000
+
+typedef struct Bench_t
+{
+    const char *filter; /**< Only benchmarks whose name contains it run. */
+    size_t max_tokens;  /**< Largest argv to parse. */
+} Bench_t;
+
+typedef struct BenchArgv_t
+{
+    char **argv;     /**< The vector, its strings point into names or values. */
+    int argc;        /**< Number of entries in argv. */
+    char **names;    /**< One owned token per option. */
+    int name_count;  /**< Number of entries in names. */
+} BenchArgv_t;
+
+static double bench_now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static bool bench_enabled(const Bench_t *bench, const char *name)
+{
+    return bench->filter == NULL || strstr(name, bench->filter) != NULL;
+}
+
+static char *bench_strdup(const char *str)
+{
+    size_t size = strlen(str) + 1;
+    char *copy = (char *)malloc(size);
+    memcpy(copy, str, size);
+    return copy;
+}
+
+/* Options --opt-0 .. --opt-N, all repeatable so any number of tokens parses. */
+static void bench_parser(ArgumentParser_t *parser, int options)
+{
+    char name[32];
+
+    argparser_initialize(parser, "bench", NULL, "Benchmark parser.", NULL);
+    parser->exit_on_error = false;
+    argparser_reserve(parser, options + 32);
+
+    for (int i = 0; i < options; i++)
+    {
+        snprintf(name, sizeof(name), "--opt-%d", i);
+        argparser_add_argument(parser, '\0', name, false, 1, NULL, "A benchmarked option");
+    }
+    for (int i = 0; i < 26; i++)
+    {
+        if ('a' + i == 'h')
+            continue;
+        snprintf(name, sizeof(name), "--flag-%c", 'a' + i);
+        argparser_add_argument(parser, (char)('a' + i), name, false, 0, NULL, "A benchmarked flag");
+    }
+    for (int i = 0; i < parser->count; i++)
+        parser->arguments[i].is_repeatable = true;
+}
+
+/* "kwarg": --opt-k value pairs, "equals": --opt-k=value, "bundle": -abcdefgijklm. */
+static void bench_argv(BenchArgv_t *args, const char *kind, int options, size_t tokens)
+{
+    char token[48];
+
+    args->argc = (int)tokens + 1;
+    args->argv = (char **)malloc(((size_t)args->argc + 1) * sizeof(char *));
+    args->name_count = strcmp(kind, "bundle") == 0 ? 1 : options;
+    args->names = (char **)malloc((size_t)args->name_count * sizeof(char *));
+
+    for (int i = 0; i < args->name_count; i++)
+    {
+        if (strcmp(kind, "bundle") == 0)
+            snprintf(token, sizeof(token), "-abcdefgijklm");
+        else if (strcmp(kind, "equals") == 0)
+            snprintf(token, sizeof(token), "--opt-%d=value-%d", i, i);
+        else
+            snprintf(token, sizeof(token), "--opt-%d", i);
+        args->names[i] = bench_strdup(token);
+    }
+
+    args->argv[0] = (char *)"bench";
+    for (size_t i = 1; i <= tokens; i++)
+    {
+        if (strcmp(kind, "kwarg") == 0)
+            args->argv[i] = i % 2 ? args->names[(i / 2) % (size_t)options] : (char *)"value";
+        else
+            args->argv[i] = args->names[i % (size_t)args->name_count];
+    }
+    args->argv[args->argc] = NULL;
+}
+
+static void bench_argv_free(BenchArgv_t *args)
+{
+    for (int i = 0; i < args->name_count; i++)
+        free(args->names[i]);
+    free(args->names);
+    free(args->argv);
+}
+
+static void bench_report(const char *name, int options, size_t tokens, bool zero_copy, size_t iterations, double elapsed, size_t allocs)
+{
+    printf("{\"bench\":\"%s\",\"options\":%d,\"tokens\":%zu,\"zero_copy\":%s,\"iterations\":%zu,"
+           "\"ns_per_op\":%.1f,\"ns_per_token\":%.2f,\"allocs_per_op\":%.2f}\n",
+           name, options, tokens, zero_copy ? "true" : "false", iterations,
+           elapsed / (double)iterations, tokens ? elapsed / (double)iterations / (double)tokens : 0.0,
+           (double)allocs / (double)iterations);
+    fflush(stdout);
+}
+
+static void bench_parse(const Bench_t *bench, const char *name, const char *kind, int options, size_t tokens, bool zero_copy)
+{
+    ArgumentParser_t parser;
+    BenchArgv_t args;
+    size_t iterations = tokens >= BENCH_MIN_TOKENS ? 1 : BENCH_MIN_TOKENS / tokens;
+    size_t allocs;
+    double start;
+
+    if (!bench_enabled(bench, name) || tokens > bench->max_tokens)
+        return;
+
+    bench_parser(&parser, options);
+    parser.zero_copy = zero_copy;
+    bench_argv(&args, kind, options, tokens);
+
+    /* The first parse grows the arenas, the measured ones should reuse them. */
+    if (argparser_parse_args(&parser, args.argc, args.argv) != ARGPARSER_SUCCESS)
+    {
+        fprintf(stderr, "%s: %s\n", name, argparser_error_what(parser.error));
+        exit(1);
+    }
+
+    allocs = bench_allocs;
+    start = bench_now();
+    for (size_t i = 0; i < iterations; i++)
+        argparser_parse_args(&parser, args.argc, args.argv);
+    bench_report(name, options, tokens, zero_copy, iterations, bench_now() - start, bench_allocs - allocs);
+
+    bench_argv_free(&args);
+    argparser_delete(&parser);
+}
+
+static void bench_lookup(const Bench_t *bench, int options)
+{
+    ArgumentParser_t parser;
+    BenchArgv_t args;
+    char **names;
+    char name[32];
+    size_t iterations = BENCH_MIN_TOKENS;
+    size_t allocs;
+    size_t found = 0;
+    double start;
+
+    if (!bench_enabled(bench, "get_arg"))
+        return;
+
+    /* Every option is given once, so each lookup finds a value. */
+    bench_parser(&parser, options);
+    bench_argv(&args, "kwarg", options, (size_t)options * 2);
+    argparser_parse_args(&parser, args.argc, args.argv);
+
+    names = (char **)malloc((size_t)options * sizeof(char *));
+    for (int i = 0; i < options; i++)
+    {
+        snprintf(name, sizeof(name), "opt-%d", i);
+        names[i] = bench_strdup(name);
+    }
+
+    allocs = bench_allocs;
+    start = bench_now();
+    for (size_t i = 0; i < iterations; i++)
+        found += argparser_get_arg(&parser, names[i % (size_t)options]) != NULL;
+    bench_report("get_arg", options, 0, false, iterations, bench_now() - start, bench_allocs - allocs);
+
+    if (found != iterations)
+        exit(1);
+
+    for (int i = 0; i < options; i++)
+        free(names[i]);
+    free(names);
+    bench_argv_free(&args);
+    argparser_delete(&parser);
+}
+
+static void bench_help(const Bench_t *bench, const char *name, int options, bool cached)
+{
+    ArgumentParser_t parser;
+    size_t size;
+    char *buffer;
+    size_t iterations = cached ? 100000 : 200000 / (size_t)options;
+    size_t allocs;
+    double start;
+
+    if (!bench_enabled(bench, name))
+        return;
+
+    bench_parser(&parser, options);
+    size = argparser_format_help(&parser, NULL, 0) + 1;
+    buffer = (char *)malloc(size);
+
+    allocs = bench_allocs;
+    start = bench_now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        if (!cached)
+            argparser_invalidate(&parser);
+        argparser_format_help(&parser, buffer, size);
+    }
+    bench_report(name, options, 0, false, iterations, bench_now() - start, bench_allocs - allocs);
+
+    free(buffer);
+    argparser_delete(&parser);
+}
+
+int main(int argc, char **argv)
+{
+    static const int options[] = {10, 100, 1000};
+    static const size_t tokens[] = {1000, 10000, 100000, 1000000};
+    ArgumentParser_t cli;
+    Bench_t bench;
+
+    argparser_initialize(&cli, "argparser_bench", NULL, "Benchmarks argparser, one JSON object per line.", NULL);
+    argparser_add_argument(&cli, 'q', "--quick", false, 0, NULL, "Stop at 100000 tokens");
+    argparser_add_argument(&cli, 'f', "--filter", false, 1, NULL, "Only run benchmarks whose name contains this");
+    argparser_parse_args(&cli, argc, argv);
+
+    bench.filter = argparser_get_arg(&cli, "filter");
+    bench.max_tokens = argparser_get_bool(&cli, "quick") ? 100000 : 1000000;
+
+    for (size_t o = 0; o < sizeof(options) / sizeof(options[0]); o++)
+    {
+        for (size_t t = 0; t < sizeof(tokens) / sizeof(tokens[0]); t++)
+        {
+            bench_parse(&bench, "parse", "kwarg", options[o], tokens[t], false);
+            bench_parse(&bench, "parse", "kwarg", options[o], tokens[t], true);
+            bench_parse(&bench, "parse_equals", "equals", options[o], tokens[t], false);
+        }
+        bench_lookup(&bench, options[o]);
+        bench_help(&bench, "help_render", options[o], false);
+        bench_help(&bench, "help_cached", options[o], true);
+    }
+
+    for (size_t t = 0; t < sizeof(tokens) / sizeof(tokens[0]); t++)
+        bench_parse(&bench, "parse_bundle", "bundle", 10, tokens[t], false);
+
+    argparser_delete(&cli);
+    return 0;
+}
@@ -0,0 +1,121 @@
+#--------------------------------------------------------------------
+# Embed a serialized parser in an executable.
+#
+#   argparser_embed_blob(<target>
+#       GENERATOR <executable target>
+#       NAME <symbol>
+#       [LANGUAGE C|CXX]
+#       [ARGS <extra arguments>...])
+#
+# Runs GENERATOR at build time as `<generator> <args>... <file.bin>`. It is
+# expected to build its parser and write argparser_serialize() to that
+# file. The blob is then compiled into <target> as
+#
+#   extern const unsigned char <symbol>[];
+#   extern const size_t <symbol>_size;
+#
+# declared in <symbol>.h, ready for argparser_load_blob(). The source is
+# <symbol>.c, or <symbol>.cpp for LANGUAGE CXX, which is the default when
+# the project does not enable C. The generator must be built for the same
+# target as <target>, which with a cross compiler means running it through
+# CMAKE_CROSSCOMPILING_EMULATOR.
+#--------------------------------------------------------------------
+
+if(CMAKE_SCRIPT_MODE_FILE)
+
+    # Script mode: convert ARGPARSER_BLOB into ARGPARSER_SOURCE and ARGPARSER_HEADER.
+    # The source includes the header, which gives the C++ definition C and external linkage.
+    if(ARGPARSER_LANGUAGE STREQUAL "CXX")
+        set(align "alignas(8)")
+    else()
+        set(align "_Alignas(8)")
+    endif()
+
+    file(READ "${ARGPARSER_BLOB}" hex HEX)
+    file(SIZE "${ARGPARSER_BLOB}" size)
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+    string(REGEX REPLACE "(0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,)" "\\1\n    " bytes "${bytes}")
+
+    file(WRITE "${ARGPARSER_SOURCE}"
+"/* Generated from ${ARGPARSER_BLOB}, do not edit. */\n"
+"#include \"${ARGPARSER_NAME}.h\"\n"
+"${align} const unsigned char ${ARGPARSER_NAME}[] = {\n"
+"    ${bytes}\n"
+"};\n"
+"const size_t ${ARGPARSER_NAME}_size = ${size};\n")
+
+    file(WRITE "${ARGPARSER_HEADER}"
+"/* Generated from ${ARGPARSER_BLOB}, do not edit. */\n"
+"#pragma once\n"
+"#include <stddef.h>\n"
+"#ifdef __cplusplus\n"
+"extern \"C\"\n"
+"{\n"
+"#endif\n"
+"    extern const unsigned char ${ARGPARSER_NAME}[];\n"
+"    extern const size_t ${ARGPARSER_NAME}_size;\n"
+"#ifdef __cplusplus\n"
+"}\n"
+"#endif\n")
+
+    return()
+
+endif()
+
+# Cached, so the function also finds it when called from a parent directory.
+set(ARGPARSER_EMBED_SCRIPT "${CMAKE_CURRENT_LIST_FILE}" CACHE INTERNAL "")
+
+function(argparser_embed_blob target)
+    cmake_parse_arguments(EMBED "" "GENERATOR;NAME;LANGUAGE" "ARGS" ${ARGN})
+
+    if(NOT EMBED_GENERATOR OR NOT EMBED_NAME)
+        message(FATAL_ERROR "argparser_embed_blob: GENERATOR and NAME are required")
+    endif()
+
+    if(NOT EMBED_LANGUAGE)
+        get_property(languages GLOBAL PROPERTY ENABLED_LANGUAGES)
+        if("C" IN_LIST languages)
+            set(EMBED_LANGUAGE C)
+        else()
+            set(EMBED_LANGUAGE CXX)
+        endif()
+    endif()
+    if(EMBED_LANGUAGE STREQUAL "C")
+        set(extension c)
+    elseif(EMBED_LANGUAGE STREQUAL "CXX")
+        set(extension cpp)
+    else()
+        message(FATAL_ERROR "argparser_embed_blob: LANGUAGE must be C or CXX")
+    endif()
+
+    set(dir "${CMAKE_CURRENT_BINARY_DIR}/argparser_embed")
+    set(blob "${dir}/${EMBED_NAME}.bin")
+    set(source "${dir}/${EMBED_NAME}.${extension}")
+    set(header "${dir}/${EMBED_NAME}.h")
+
+    add_custom_command(
+        OUTPUT "${blob}"
+        COMMAND ${CMAKE_COMMAND} -E make_directory "${dir}"
+        COMMAND ${EMBED_GENERATOR} ${EMBED_ARGS} "${blob}"
+        DEPENDS ${EMBED_GENERATOR}
+        COMMENT "Serializing the ${EMBED_NAME} parser"
+        VERBATIM
+    )
+
+    add_custom_command(
+        OUTPUT "${source}" "${header}"
+        COMMAND ${CMAKE_COMMAND}
+                -DARGPARSER_BLOB=${blob}
+                -DARGPARSER_SOURCE=${source}
+                -DARGPARSER_HEADER=${header}
+                -DARGPARSER_NAME=${EMBED_NAME}
+                -DARGPARSER_LANGUAGE=${EMBED_LANGUAGE}
+                -P "${ARGPARSER_EMBED_SCRIPT}"
+        DEPENDS "${blob}" "${ARGPARSER_EMBED_SCRIPT}"
+        COMMENT "Embedding the ${EMBED_NAME} parser"
+        VERBATIM
+    )
+
+    target_sources(${target} PRIVATE "${source}" "${header}")
+    target_include_directories(${target} PRIVATE "${dir}")
+endfunction()
@@ -0,0 +1,122 @@
+/**
+ * @file test.h
+ * @brief Checks shared by the test programs.
+ *
+ * Every test is a program that includes the implementation once, runs its
+ * CHECK()s and returns TEST_RESULT() from main. A failed check prints its
+ * location and the test goes on, so one run reports every failure:
+ *
+ * @code
+ * #define ARGPARSER_IMPLEMENTATION
+ * #include "argparser.h"
+ * #include "test.h"
+ *
+ * int main(void)
+ * {
+ *     CHECK(1 + 1 == 2);
+ *     return TEST_RESULT();
+ * }
+ * @endcode
+ */
+
+#ifndef ARGPARSER_TEST_H
+#define ARGPARSER_TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int test_failures = 0;
+
+/** Reports @p cond when it is false, without stopping the test. */
+#define CHECK(cond)                                                              \
+    do                                                                           \
+    {                                                                            \
+        if (!(cond))                                                             \
+        {                                                                        \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            test_failures++;                                                     \
+        }                                                                        \
+    } while (0)
+
+/** Checks two strings for equality, NULL only equals NULL. */
+#define CHECK_STR(actual, expected)                                                  \
+    do                                                                               \
+    {                                                                                \
+        const char *check_actual = (actual);                                         \
+        const char *check_expected = (expected);                                     \
+        if (!test_same_string(check_actual, check_expected))                         \
+        {                                                                            \
+            fprintf(stderr, "%s:%d: check failed: %s is \"%s\", expected \"%s\"\n", \
+                    __FILE__, __LINE__, #actual, check_actual ? check_actual : "(null)", \
+                    check_expected ? check_expected : "(null)");                     \
+            test_failures++;                                                         \
+        }                                                                            \
+    } while (0)
+
+/** Number of entries of a NULL terminated argv array, without the NULL. */
+#define TEST_ARGC(argv) ((int)(sizeof(argv) / sizeof((argv)[0])) - 1)
+
+/** Exit status of the test: 0 when every check passed. */
+#define TEST_RESULT() (test_failures == 0 ? 0 : 1)
+
+static inline int test_same_string(const char *a, const char *b)
+{
+    return a == NULL || b == NULL ? a == b : strcmp(a, b) == 0;
+}
+
+/** Starts a parser named "prog" whose errors are returned rather than exiting. */
+static inline void test_parser(ArgumentParser_t *parser)
+{
+    argparser_initialize(parser, "prog", NULL, NULL, NULL);
+    parser->exit_on_error = false;
+}
+
+/** One argument of a test parser: the argparser_add_argument() fields, then its type. */
+typedef struct TestArgument_t
+{
+    char sym;
+    const char *name;
+    int required;
+    int nargs;
+    const char *default_value;
+    const char *help;
+    ArgumentValueType type; /**< Set with argparser_set_type() unless VALUE_STRING. */
+    bool is_repeatable;
+} TestArgument_t;
+
+/** Starts test_parser() with every argument of a TestArgument_t array, in order. */
+#define TEST_PARSER(parser, arguments) \
+    test_parser_with((parser), (arguments), (int)(sizeof(arguments) / sizeof((arguments)[0])))
+
+static inline void test_parser_with(ArgumentParser_t *parser, const TestArgument_t *arguments, int count)
+{
+    test_parser(parser);
+    for (int i = 0; i < count; i++)
+    {
+        const TestArgument_t *argument = &arguments[i];
+
+        argparser_add_argument(parser, argument->sym, argument->name, argument->required, argument->nargs,
+                               argument->default_value, argument->help);
+        if (argument->type != VALUE_STRING)
+            CHECK(argparser_set_type(parser, parser->arguments[parser->count - 1].name, argument->type) == ARGPARSER_SUCCESS);
+        if (argument->is_repeatable)
+            parser->arguments[parser->count - 1].is_repeatable = true;
+    }
+}
+
+/** Writes @p text to @p path, for tests reading files. */
+static inline void test_write_file(const char *path, const char *text)
+{
+    FILE *file = fopen(path, "wb");
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "cannot write %s\n", path);
+        exit(1);
+    }
+    fputs(text, file);
+    fclose(file);
+}
+
+#endif /* ARGPARSER_TEST_H */
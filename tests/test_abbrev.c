@@ -0,0 +1,114 @@
+/**
+ * @file test_abbrev.c
+ * @brief Abbreviated long options and completion through the prefix trie.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+enum
+{
+    TEST_UNFROZEN, /* Trie built by argparser_parse_args(). */
+    TEST_FROZEN,   /* Trie built by argparser_freeze(). */
+    TEST_SCAN,     /* No trie, argparser_parse_into() builds one in the result. */
+};
+
+static const TestArgument_t abbrev_arguments[] = {
+    {'v', "--verbose", 0, 0, NULL, "Verbose", VALUE_STRING, false},
+    {'\0', "--version", 0, 0, NULL, "Version", VALUE_STRING, false},
+    {'\0', "--out", 0, 1, NULL, "Output", VALUE_STRING, false},
+    {'\0', "--output-format", 0, 1, NULL, "Format", VALUE_STRING, false},
+    {'\0', "--color", 0, 1, NULL, "Color", VALUE_STRING, false},
+};
+
+static void test_abbreviations(int mode)
+{
+    ArgumentParser_t parser;
+    ArgumentResult_t result;
+    ArgumentErrorBuffer_t error;
+    const ArgumentResult_t *parsed;
+    char *argv[] = {"prog", "--verb", "--col=red", "--out", "x", "--output-f", "json", NULL};
+    char *ambiguous[] = {"prog", "--ver", NULL};
+    char *shared[] = {"prog", "--o", "1", NULL};
+    char *unknown[] = {"prog", "--nope", NULL};
+    int status;
+
+    TEST_PARSER(&parser, abbrev_arguments);
+    argparser_result_initialize(&result, NULL, 0);
+    if (mode == TEST_FROZEN)
+        argparser_freeze(&parser);
+
+    if (mode == TEST_SCAN)
+        status = argparser_parse_into(&parser, &result, TEST_ARGC(argv), argv);
+    else
+        status = argparser_parse_args(&parser, TEST_ARGC(argv), argv);
+    parsed = mode == TEST_SCAN ? &result : &parser.result;
+
+    CHECK(status == ARGPARSER_SUCCESS);
+    CHECK(argparser_result_get_bool(&parser, parsed, "verbose"));
+    CHECK(!argparser_result_get_bool(&parser, parsed, "version"));
+    CHECK_STR(argparser_result_get_arg(&parser, parsed, "color"), "red");
+    CHECK_STR(argparser_result_get_arg(&parser, parsed, "out"), "x");
+    CHECK_STR(argparser_result_get_arg(&parser, parsed, "output-format"), "json");
+
+    CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(ambiguous), ambiguous, &error) == PARSE);
+    CHECK_STR(error.error.message, "ambiguous option");
+    CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(shared), shared, &error) == PARSE);
+    CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(unknown), unknown, &error) == PARSE);
+    CHECK_STR(error.error.message, "unrecognized argument");
+
+    argparser_result_delete(&result);
+    argparser_delete(&parser);
+}
+
+static void test_disabled(void)
+{
+    ArgumentParser_t parser;
+    char *argv[] = {"prog", "--verb", NULL};
+
+    TEST_PARSER(&parser, abbrev_arguments);
+    parser.allow_abbrev = false;
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_FAILURE);
+    CHECK_STR(argparser_error_arg(parser.error), "--verb");
+    argparser_delete(&parser);
+}
+
+static void test_complete(void)
+{
+    ArgumentParser_t parser;
+    const char *names[8];
+
+    TEST_PARSER(&parser, abbrev_arguments);
+    argparser_add_argument(&parser, '\0', "--secret", 0, 0, NULL, "Hidden");
+    parser.arguments[parser.count - 1].is_hidden = true;
+
+    CHECK(argparser_complete(&parser, "--ver", names, 8) == 2);
+    CHECK_STR(names[0], "verbose");
+    CHECK_STR(names[1], "version");
+
+    CHECK(argparser_complete(&parser, "--out", names, 8) == 2);
+    CHECK_STR(names[0], "out");
+    CHECK_STR(names[1], "output-format");
+
+    /* Every visible name, sorted, counted past max. */
+    CHECK(argparser_complete(&parser, "", names, 3) == 6);
+    CHECK_STR(names[0], "color");
+    CHECK_STR(names[1], "help");
+    CHECK_STR(names[2], "out");
+
+    CHECK(argparser_complete(&parser, "--sec", names, 8) == 0);
+    CHECK(argparser_complete(&parser, "--x", names, 8) == 0);
+
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_abbreviations(TEST_UNFROZEN);
+    test_abbreviations(TEST_FROZEN);
+    test_abbreviations(TEST_SCAN);
+    test_disabled();
+    test_complete();
+    return TEST_RESULT();
+}
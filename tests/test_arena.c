@@ -0,0 +1,119 @@
+/**
+ * @file test_arena.c
+ * @brief Arena allocation through the ARGPARSER_MALLOC/FREE hooks.
+ */
+
+#include <stdlib.h>
+
+static size_t test_allocs;
+static size_t test_frees;
+
+static void *test_malloc(size_t size)
+{
+    test_allocs++;
+    return malloc(size);
+}
+
+static void test_free(void *ptr)
+{
+    if (ptr != NULL)
+        test_frees++;
+    free(ptr);
+}
+
+#define ARGPARSER_MALLOC(size) test_malloc(size)
+#define ARGPARSER_FREE(ptr) test_free(ptr)
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static void test_warm_parses(void)
+{
+    ArgumentParser_t parser;
+    char names[200][16];
+    char *argv[1001];
+    size_t allocs;
+
+    test_parser(&parser);
+    for (int i = 0; i < 200; i++)
+    {
+        snprintf(names[i], sizeof(names[i]), "--opt-%d", i);
+        argparser_add_argument(&parser, '\0', names[i], 0, 1, NULL, "An option");
+    }
+    argparser_add_argument(&parser, '\0', "files", 0, ARGPARSER_NARGS(ZERO_OR_MORE), NULL, "Files");
+
+    argv[0] = "prog";
+    argv[1] = "--opt-7=x";
+    for (int i = 2; i < 1000; i++)
+        argv[i] = "value";
+    argv[1000] = NULL;
+
+    /* The arena keeps only its largest block, which is big enough after a second parse. */
+    CHECK(argparser_parse_args(&parser, 1000, argv) == ARGPARSER_SUCCESS);
+    CHECK(argparser_parse_args(&parser, 1000, argv) == ARGPARSER_SUCCESS);
+
+    /* Once the arenas have grown, parsing the same argv again allocates nothing. */
+    allocs = test_allocs;
+    for (int i = 0; i < 5; i++)
+        CHECK(argparser_parse_args(&parser, 1000, argv) == ARGPARSER_SUCCESS);
+    CHECK(test_allocs == allocs);
+
+    CHECK_STR(argparser_get_arg(&parser, "opt-7"), "x");
+    CHECK_STR(argparser_get_arg(&parser, "opt-8"), NULL);
+
+    argparser_delete(&parser);
+}
+
+static void test_release(void)
+{
+    ArgumentParser_t parser;
+    char *bad[] = {"prog", "--bogus", NULL};
+    char *good[] = {"prog", "-n", "1", NULL};
+
+    test_parser(&parser);
+    argparser_add_argument(&parser, 'n', "number", 0, 1, "0", "A number");
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(bad), bad) == ARGPARSER_FAILURE);
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(good), good) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "number"), "1");
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(bad), bad) == ARGPARSER_FAILURE);
+    argparser_delete(&parser);
+}
+
+static void test_errors_and_tables(void)
+{
+    ArgumentParser_t parser;
+    char *bad[] = {"prog", "--bogus", NULL};
+    size_t allocs;
+    size_t frees;
+
+    test_parser(&parser);
+    parser.allow_abbrev = true;
+    argparser_add_argument(&parser, 'n', "number", 0, 1, "0", "A number");
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(bad), bad) == ARGPARSER_FAILURE);
+
+    /* A failed parse keeps its error in the result arena. */
+    allocs = test_allocs;
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(bad), bad) == ARGPARSER_FAILURE);
+    CHECK(test_allocs == allocs);
+    CHECK_STR(argparser_error_arg(parser.error), "--bogus");
+
+    /* Help, trie and parse table come from the parser arena, rebuilt or not. */
+    frees = test_frees;
+    argparser_freeze(&parser);
+    CHECK(parser.help != NULL && parser.trie != NULL && parser.hot != NULL);
+    argparser_freeze(&parser);
+    CHECK(test_frees == frees);
+
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_warm_parses();
+    test_release();
+    test_errors_and_tables();
+
+    /* Every block the parsers took went back through ARGPARSER_FREE. */
+    CHECK(test_allocs == test_frees);
+    return TEST_RESULT();
+}
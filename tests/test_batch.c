@@ -0,0 +1,107 @@
+/**
+ * @file test_batch.c
+ * @brief Results kept apart from the parser, reset and batch parsing.
+ */
+
+#include <stdlib.h>
+
+static size_t test_allocs;
+
+static void *test_malloc(size_t size)
+{
+    test_allocs++;
+    return malloc(size);
+}
+
+#define ARGPARSER_MALLOC(size) test_malloc(size)
+#define ARGPARSER_FREE(ptr) free(ptr)
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static const TestArgument_t batch_arguments[] = {
+    {'n', "--num", 0, 1, "7", "A number", VALUE_INT, false},
+    {'v', "--verbose", 0, 0, NULL, "Verbose", VALUE_STRING, true},
+    {'\0', "files", 0, ARGPARSER_NARGS(ZERO_OR_MORE), NULL, "Files", VALUE_STRING, false},
+};
+
+static void test_batch(void)
+{
+    ArgumentParser_t parser;
+    char *a0[] = {"prog", "-n", "1", "x", "y", "z", NULL};
+    char *a1[] = {"prog", "-vv", NULL};
+    char *a2[] = {"prog", "--num", "oops", NULL};
+    char *a3[] = {"prog", "a", NULL};
+    char **argvs[] = {a0, a1, a2, a3};
+    int argcs[] = {TEST_ARGC(a0), TEST_ARGC(a1), TEST_ARGC(a2), TEST_ARGC(a3)};
+    ArgumentResult_t results[4];
+    size_t allocs = 0;
+    int count;
+
+    TEST_PARSER(&parser, batch_arguments);
+    for (int i = 0; i < 4; i++)
+        argparser_result_initialize(&results[i], NULL, 0);
+
+    for (int round = 0; round < 4; round++)
+    {
+        /* Rewound results allocate nothing, the failed entry's error included. */
+        if (round == 2)
+            allocs = test_allocs;
+        CHECK(argparser_parse_batch(&parser, 4, argcs, argvs, results) == ARGPARSER_FAILURE);
+    }
+    CHECK(test_allocs == allocs);
+
+    CHECK(results[0].status == ARGPARSER_SUCCESS);
+    CHECK(argparser_result_get_int(&parser, &results[0], "num") == 1);
+    CHECK(argparser_result_get_values(&parser, &results[0], "files", &count) != NULL && count == 3);
+
+    CHECK(results[1].status == ARGPARSER_SUCCESS);
+    CHECK(argparser_result_get_int(&parser, &results[1], "num") == 7);
+    CHECK(argparser_result_get_int(&parser, &results[1], "verbose") == 2);
+
+    CHECK(results[2].status == ARGPARSER_FAILURE);
+    CHECK(results[2].error != NULL && argparser_error_type(results[2].error) == PARSE);
+
+    CHECK(results[3].status == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_result_get_arg(&parser, &results[3], "files"), "a");
+
+    /* Batches never touch the parser's own result. */
+    CHECK(parser.error == NULL);
+    CHECK(argparser_get_arg(&parser, "files") == NULL);
+
+    for (int i = 0; i < 4; i++)
+        argparser_result_delete(&results[i]);
+    argparser_delete(&parser);
+}
+
+static void test_reset(void)
+{
+    ArgumentParser_t parser;
+    char *bad[] = {"prog", "--num", "oops", NULL};
+    char *good[] = {"prog", "--num", "3", "f", NULL};
+
+    TEST_PARSER(&parser, batch_arguments);
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(good), good) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_int(&parser, "num") == 3);
+    argparser_reset(&parser);
+    CHECK(argparser_get_int(&parser, "num") == 7);
+    CHECK(argparser_get_arg(&parser, "files") == NULL);
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(bad), bad) == ARGPARSER_FAILURE);
+    CHECK(parser.error != NULL);
+    argparser_reset(&parser);
+    CHECK(parser.error == NULL);
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(good), good) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "files"), "f");
+
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_batch();
+    test_reset();
+    return TEST_RESULT();
+}
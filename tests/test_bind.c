@@ -0,0 +1,142 @@
+/**
+ * @file test_bind.c
+ * @brief Typed values written straight into struct members and variables.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+typedef struct TestConfig_t
+{
+    int32_t port;
+    int8_t level;
+    bool verbose;
+    int64_t count;
+    const char *name;
+    double ratio;
+    float scale;
+    bool color;
+    int mode;
+    ArgumentList_t sizes;
+    const char *untouched;
+} TestConfig_t;
+
+static const char *modes[] = {"fast", "slow"};
+static int64_t jobs = -1;
+
+static const TestArgument_t bind_arguments[] = {
+    {'p', "--port", 0, 1, "80", "Port", VALUE_INT, false},
+    {'l', "--level", 0, 1, NULL, "Level", VALUE_INT, false},
+    {'v', "--verbose", 0, 0, NULL, "Verbose", VALUE_STRING, false},
+    {'c', "--count", 0, 0, NULL, "Count", VALUE_INT, true},
+    {'n', "--name", 0, 1, "anon", "Name", VALUE_STRING, false},
+    {'r', "--ratio", 0, 1, NULL, "Ratio", VALUE_DOUBLE, false},
+    {'s', "--scale", 0, 1, "0.5", "Scale", VALUE_DOUBLE, false},
+    {'C', "--color", 0, 1, NULL, "Color", VALUE_BOOL, false},
+    {'m', "--mode", 0, 1, NULL, "Mode", VALUE_STRING, false},
+    {'z', "--sizes", 0, 1, NULL, "Sizes", VALUE_INT_LIST, false},
+    {'j', "--jobs", 0, 1, NULL, "Jobs", VALUE_INT, false},
+    {'u', "--untouched", 0, 1, NULL, "Never given", VALUE_STRING, false},
+};
+
+static void test_bind(void)
+{
+    ArgumentParser_t parser;
+
+    TEST_PARSER(&parser, bind_arguments);
+    argparser_set_choices(&parser, "mode", modes, 2);
+    CHECK(ARGPARSER_BIND(&parser, "port", TestConfig_t, port) == ARGPARSER_SUCCESS);
+    CHECK(ARGPARSER_BIND(&parser, "level", TestConfig_t, level) == ARGPARSER_SUCCESS);
+    CHECK(ARGPARSER_BIND(&parser, "verbose", TestConfig_t, verbose) == ARGPARSER_SUCCESS);
+    CHECK(ARGPARSER_BIND(&parser, "count", TestConfig_t, count) == ARGPARSER_SUCCESS);
+    CHECK(ARGPARSER_BIND(&parser, "name", TestConfig_t, name) == ARGPARSER_SUCCESS);
+    CHECK(ARGPARSER_BIND(&parser, "ratio", TestConfig_t, ratio) == ARGPARSER_SUCCESS);
+    CHECK(ARGPARSER_BIND(&parser, "scale", TestConfig_t, scale) == ARGPARSER_SUCCESS);
+    CHECK(ARGPARSER_BIND(&parser, "color", TestConfig_t, color) == ARGPARSER_SUCCESS);
+    CHECK(ARGPARSER_BIND(&parser, "mode", TestConfig_t, mode) == ARGPARSER_SUCCESS);
+    CHECK(ARGPARSER_BIND(&parser, "sizes", TestConfig_t, sizes) == ARGPARSER_SUCCESS);
+    CHECK(ARGPARSER_BIND(&parser, "untouched", TestConfig_t, untouched) == ARGPARSER_SUCCESS);
+    CHECK(argparser_store_into(&parser, "jobs", &jobs, sizeof(jobs)) == ARGPARSER_SUCCESS);
+
+    /* A destination too small for the value type, or an unknown name. */
+    CHECK(ARGPARSER_BIND(&parser, "ratio", TestConfig_t, level) == ARGPARSER_FAILURE);
+    CHECK(ARGPARSER_BIND(&parser, "nope", TestConfig_t, port) == ARGPARSER_FAILURE);
+
+    argparser_delete(&parser);
+}
+
+static void test_target(void)
+{
+    ArgumentParser_t parser;
+    TestConfig_t config = {0};
+    char *argv[] = {"prog", "-p", "8080", "-l", "-3", "-vcc", "-c", "--ratio=2.5", "--color", "yes",
+                    "--mode", "slow", "-z", "1,2,3", "-j", "4", NULL};
+    char *bad[] = {"prog", "-p", "1", "--bogus", NULL};
+
+    TEST_PARSER(&parser, bind_arguments);
+    argparser_set_choices(&parser, "mode", modes, 2);
+    ARGPARSER_BIND(&parser, "port", TestConfig_t, port);
+    ARGPARSER_BIND(&parser, "level", TestConfig_t, level);
+    ARGPARSER_BIND(&parser, "verbose", TestConfig_t, verbose);
+    ARGPARSER_BIND(&parser, "count", TestConfig_t, count);
+    ARGPARSER_BIND(&parser, "name", TestConfig_t, name);
+    ARGPARSER_BIND(&parser, "ratio", TestConfig_t, ratio);
+    ARGPARSER_BIND(&parser, "scale", TestConfig_t, scale);
+    ARGPARSER_BIND(&parser, "color", TestConfig_t, color);
+    ARGPARSER_BIND(&parser, "mode", TestConfig_t, mode);
+    ARGPARSER_BIND(&parser, "sizes", TestConfig_t, sizes);
+    ARGPARSER_BIND(&parser, "untouched", TestConfig_t, untouched);
+    argparser_store_into(&parser, "jobs", &jobs, sizeof(jobs));
+
+    config.untouched = "keep";
+    argparser_set_target(&parser, &config);
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(config.port == 8080 && config.level == -3 && config.verbose && config.count == 3);
+    CHECK_STR(config.name, "anon");
+    CHECK(config.ratio == 2.5 && config.scale == 0.5f && config.color && config.mode == 1);
+    CHECK(config.sizes.count == 3 && config.sizes.ints[2] == 3);
+    CHECK_STR(config.untouched, "keep");
+    CHECK(jobs == 4);
+
+    /* A rejected command line writes nothing. */
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(bad), bad) == ARGPARSER_FAILURE);
+    CHECK(config.port == 8080);
+
+    argparser_delete(&parser);
+}
+
+static void test_result_target(void)
+{
+    ArgumentParser_t parser;
+    ArgumentResult_t result;
+    TestConfig_t config = {0};
+    char *argv[] = {"prog", "-n", "bob", NULL};
+
+    TEST_PARSER(&parser, bind_arguments);
+    argparser_set_choices(&parser, "mode", modes, 2);
+    ARGPARSER_BIND(&parser, "port", TestConfig_t, port);
+    ARGPARSER_BIND(&parser, "name", TestConfig_t, name);
+    ARGPARSER_BIND(&parser, "verbose", TestConfig_t, verbose);
+    ARGPARSER_BIND(&parser, "scale", TestConfig_t, scale);
+    ARGPARSER_BIND(&parser, "ratio", TestConfig_t, ratio);
+    argparser_freeze(&parser);
+
+    /* A frozen parser fills whichever struct each result names. */
+    argparser_result_initialize(&result, NULL, 0);
+    result.target = &config;
+    CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(argv), argv, NULL) == NONE);
+    CHECK(config.port == 80 && !config.verbose && config.scale == 0.5f && config.ratio == 0);
+    CHECK_STR(config.name, "bob");
+
+    argparser_result_delete(&result);
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_bind();
+    test_target();
+    test_result_target();
+    return TEST_RESULT();
+}
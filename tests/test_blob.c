@@ -0,0 +1,279 @@
+/**
+ * @file test_blob.c
+ * @brief Serialized parsers loaded back, in memory and embedded at build time.
+ *
+ * Built twice: with TEST_BLOB_GENERATOR it only writes the blob given on
+ * the command line, which argparser_embed_blob() compiles into the test,
+ * once as C and once as C++.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#ifndef TEST_BLOB_GENERATOR
+#include "test.h"
+#include "test_blob_embedded.h"
+#include "test_blob_embedded_cxx.h"
+#endif
+
+typedef struct TestOptions_t
+{
+    int64_t level;
+    int mode;
+} TestOptions_t;
+
+static const char *modes[] = {"fast", "slow", "auto"};
+static const char *loudness[] = {"quiet", "verbose"};
+
+static void test_parser_blob(ArgumentParser_t *parser)
+{
+    argparser_initialize(parser, "tool", NULL, "A tool.", "Bye.");
+    parser->exit_on_error = false;
+    argparser_add_argument(parser, 'q', "--quiet", 0, 0, NULL, "be quiet");
+    argparser_add_argument(parser, 'v', "--verbose", 0, 0, NULL, "be loud");
+    argparser_add_argument(parser, 'l', "--level", 0, 1, "3", "level");
+    argparser_add_argument(parser, 'm', "--mode", 0, 1, "auto", "mode");
+    argparser_add_argument(parser, 'n', "--nums", 0, 1, "1,2,3", "numbers");
+    argparser_add_argument(parser, '\0', "input", 1, 1, NULL, "input file");
+    argparser_set_type(parser, "level", VALUE_INT);
+    argparser_set_type(parser, "mode", VALUE_ENUM);
+    argparser_set_choices(parser, "mode", modes, 3);
+    argparser_set_type(parser, "nums", VALUE_INT_LIST);
+    argparser_add_group(parser, GROUP_EXCLUSIVE, false, loudness, 2);
+    ARGPARSER_BIND(parser, "level", TestOptions_t, level);
+    ARGPARSER_BIND(parser, "mode", TestOptions_t, mode);
+}
+
+#ifdef TEST_BLOB_GENERATOR
+
+int main(int argc, char **argv)
+{
+    ArgumentParser_t parser;
+    size_t size;
+    void *blob;
+    FILE *file;
+
+    if (argc != 2)
+        return 1;
+    test_parser_blob(&parser);
+    size = argparser_serialize(&parser, NULL, 0);
+    blob = malloc(size);
+    argparser_serialize(&parser, blob, size);
+    file = fopen(argv[1], "wb");
+    if (file == NULL || fwrite(blob, 1, size, file) != size)
+        return 1;
+    fclose(file);
+    free(blob);
+    argparser_delete(&parser);
+    return 0;
+}
+
+#else
+
+/* The loaded parser behaves like the one it was written from. */
+static void test_loaded(ArgumentParser_t *loaded, const char *help)
+{
+    TestOptions_t options = {0, 0};
+    ArgumentResult_t result;
+    char buffer[4096];
+    const int64_t *nums;
+    size_t count;
+    char *argv[] = {"tool", "--lev", "7", "-m", "slow", "in.txt", NULL};
+    char *both[] = {"tool", "-q", "-v", "x", NULL};
+    char *missing[] = {"tool", "-q", NULL};
+    char *choice[] = {"tool", "-m", "nope", "x", NULL};
+
+    argparser_format_help(loaded, buffer, sizeof(buffer));
+    CHECK_STR(buffer, help);
+    CHECK_STR(loaded->program, "tool");
+
+    argparser_set_target(loaded, &options);
+    CHECK(argparser_parse_args(loaded, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_int(loaded, "level") == 7 && options.level == 7);
+    CHECK(argparser_get_enum(loaded, "mode") == 1 && options.mode == 1);
+    CHECK_STR(argparser_get_arg(loaded, "input"), "in.txt");
+    nums = argparser_get_int_list(loaded, "nums", &count);
+    CHECK(count == 3 && nums[2] == 3);
+
+    CHECK(argparser_parse_args(loaded, TEST_ARGC(both), both) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(loaded->error) == VALIDATION);
+    CHECK(argparser_parse_args(loaded, TEST_ARGC(missing), missing) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(loaded->error) == REQUIRED);
+    CHECK(argparser_parse_args(loaded, TEST_ARGC(choice), choice) == ARGPARSER_FAILURE);
+    argparser_set_target(loaded, NULL);
+
+    /* Freezing keeps the borrowed help. */
+    argparser_freeze(loaded);
+    CHECK(loaded->help != NULL);
+    CHECK_STR(loaded->help, help);
+    argparser_result_initialize(&result, NULL, 0);
+    CHECK(argparser_try_parse(loaded, &result, TEST_ARGC(argv), argv, NULL) == NONE);
+    argparser_result_delete(&result);
+}
+
+static void test_round_trip(void)
+{
+    ArgumentParser_t original, loaded, extended;
+    char help[4096];
+    char buffer[4096];
+    uint64_t *blob;
+    size_t size;
+    char *argv[] = {"tool", "--ext", "1", "--verb", "i", NULL};
+
+    test_parser_blob(&original);
+    argparser_format_help(&original, help, sizeof(help));
+
+    /* Sized like snprintf, in whole 8-byte words. */
+    size = argparser_serialize(&original, NULL, 0);
+    CHECK(size > 0 && size % 8 == 0);
+    blob = (uint64_t *)malloc(size);
+    CHECK(argparser_serialize(&original, blob, size - 8) == size);
+    CHECK(argparser_serialize(&original, blob, size) == size);
+
+    test_parser(&loaded);
+    CHECK(argparser_load_blob(&loaded, blob, size) == ARGPARSER_SUCCESS);
+    test_loaded(&loaded, help);
+
+    /* Arguments added after loading land next to the borrowed ones. */
+    test_parser(&extended);
+    CHECK(argparser_load_blob(&extended, blob, size) == ARGPARSER_SUCCESS);
+    argparser_add_argument(&extended, 'x', "--extra", 0, 1, NULL, "extra");
+    argparser_format_help(&extended, buffer, sizeof(buffer));
+    CHECK(strstr(buffer, "--extra") != NULL);
+    CHECK(argparser_parse_args(&extended, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&extended, "extra"), "1");
+    argparser_delete(&extended);
+
+    /* A wrong version or a misaligned blob is refused. */
+    test_parser(&extended);
+    CHECK(argparser_load_blob(&extended, (char *)blob + 1, size - 1) == ARGPARSER_FAILURE);
+    CHECK(argparser_load_blob(&extended, blob, size / 2) == ARGPARSER_FAILURE);
+    ((uint32_t *)blob)[1] = 99;
+    CHECK(argparser_load_blob(&extended, blob, size) == ARGPARSER_FAILURE);
+    argparser_delete(&extended);
+
+    argparser_delete(&loaded);
+    argparser_delete(&original);
+    free(blob);
+}
+
+/* Loads a copy of the blob with one 32-bit word at offset replaced. */
+static int test_load_patched(const uint64_t *blob, size_t size, size_t offset, uint32_t value)
+{
+    ArgumentParser_t parser;
+    uint64_t *copy = (uint64_t *)malloc(size);
+    int status;
+
+    memcpy(copy, blob, size);
+    memcpy((char *)copy + offset, &value, sizeof(value));
+    test_parser(&parser);
+    status = argparser_load_blob(&parser, copy, size);
+    argparser_delete(&parser);
+    free(copy);
+    return status;
+}
+
+static void test_corrupted(void)
+{
+    ArgumentParser_t original, parser;
+    const ArgumentBlobHeader_t *header;
+    const ArgumentTrieNode_t *trie;
+    uint64_t *blob;
+    uint64_t *copy;
+    size_t size;
+    size_t entry;
+    char buffer[4096];
+    char *argv[] = {"tool", "--lev", "7", "-m", "slow", "-n", "4,5", "in.txt", NULL};
+
+    test_parser_blob(&original);
+    size = argparser_serialize(&original, NULL, 0);
+    blob = (uint64_t *)malloc(size);
+    argparser_serialize(&original, blob, size);
+    header = (const ArgumentBlobHeader_t *)blob;
+    entry = header->arguments + 3 * sizeof(ArgumentBlobArgument_t);
+    trie = (const ArgumentTrieNode_t *)((const char *)blob + header->trie);
+    CHECK(test_load_patched(blob, size, 0, ARGPARSER_BLOB_MAGIC) == ARGPARSER_SUCCESS);
+
+    /* Counts reaching past the end of the blob. */
+    CHECK(test_load_patched(blob, size, offsetof(ArgumentBlobHeader_t, count), header->count + 1000) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, offsetof(ArgumentBlobHeader_t, choice_count), UINT32_MAX) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, offsetof(ArgumentBlobHeader_t, group_count), 1u << 20) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, offsetof(ArgumentBlobHeader_t, mask_words), 1u << 28) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, offsetof(ArgumentBlobHeader_t, trie_count), header->trie_count * 100) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, offsetof(ArgumentBlobHeader_t, help_size), (uint32_t)size) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, offsetof(ArgumentBlobHeader_t, symbols), (uint32_t)size - 8) == ARGPARSER_FAILURE);
+
+    /* An index that is not a power of two, or whose count is wrong. */
+    CHECK(test_load_patched(blob, size, offsetof(ArgumentBlobHeader_t, index_capacity), header->index_capacity - 1) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, offsetof(ArgumentBlobHeader_t, index_count), header->index_count + 1) == ARGPARSER_FAILURE);
+
+    /* Strings outside the blob, or not ending in it. */
+    CHECK(test_load_patched(blob, size, offsetof(ArgumentBlobHeader_t, program), (uint32_t)size) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, entry + offsetof(ArgumentBlobArgument_t, name), (uint32_t)size + 8) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, entry + offsetof(ArgumentBlobArgument_t, name), ARGPARSER_BLOB_NULL) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, header->choices, (uint32_t)size) == ARGPARSER_FAILURE);
+
+    /* Entries naming slots, choices or bound sizes that do not exist. */
+    CHECK(test_load_patched(blob, size, entry + offsetof(ArgumentBlobArgument_t, choice_count), 1000) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, entry + offsetof(ArgumentBlobArgument_t, store_size), 3) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, header->symbols + 'q' * sizeof(int), header->count + 1) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, header->groups + offsetof(ArgumentBlobGroup_t, words), 2) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, header->masks, 1u << 31) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, header->masks + 4, 1) == ARGPARSER_FAILURE);
+
+    /* A trie whose links loop. */
+    CHECK(header->trie_count > 2 && trie[1].child != 0);
+    CHECK(test_load_patched(blob, size, header->trie + sizeof(ArgumentTrieNode_t) + offsetof(ArgumentTrieNode_t, sibling), 1) == ARGPARSER_FAILURE);
+    CHECK(test_load_patched(blob, size, header->trie + offsetof(ArgumentTrieNode_t, child), header->trie_count) == ARGPARSER_FAILURE);
+
+    /* Whatever a flipped byte does, a blob that loads still parses within bounds. */
+    copy = (uint64_t *)malloc(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        memcpy(copy, blob, size);
+        ((unsigned char *)copy)[i] ^= 0xff;
+        test_parser(&parser);
+        if (argparser_load_blob(&parser, copy, size) == ARGPARSER_SUCCESS)
+        {
+            argparser_parse_args(&parser, TEST_ARGC(argv), argv);
+            argparser_format_help(&parser, buffer, sizeof(buffer));
+        }
+        argparser_delete(&parser);
+    }
+    free(copy);
+
+    argparser_delete(&original);
+    free(blob);
+}
+
+static void test_embedded(void)
+{
+    ArgumentParser_t original, loaded;
+    char help[4096];
+
+    test_parser_blob(&original);
+    argparser_format_help(&original, help, sizeof(help));
+
+    test_parser(&loaded);
+    CHECK(argparser_load_blob(&loaded, test_blob_embedded, test_blob_embedded_size) == ARGPARSER_SUCCESS);
+    test_loaded(&loaded, help);
+
+    argparser_delete(&loaded);
+
+    /* The same blob compiled as C++. */
+    test_parser(&loaded);
+    CHECK(argparser_load_blob(&loaded, test_blob_embedded_cxx, test_blob_embedded_cxx_size) == ARGPARSER_SUCCESS);
+    test_loaded(&loaded, help);
+
+    argparser_delete(&loaded);
+    argparser_delete(&original);
+}
+
+int main(void)
+{
+    test_round_trip();
+    test_corrupted();
+    test_embedded();
+    return TEST_RESULT();
+}
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * @file test_builder.cpp
+ * @brief argparser_reserve() and the in-place C++ argument builder.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+#include <cstring>
+#include <string>
+
+static void test_reserve()
+{
+    ArgumentParser_t parser;
+    char names[300][16];
+
+    test_parser(&parser);
+    CHECK(argparser_reserve(&parser, 400) == ARGPARSER_SUCCESS);
+    CHECK(parser.capacity >= 400);
+
+    /* Nothing reserved is moved by the registrations it was reserved for. */
+    Argument_t *arguments = parser.arguments;
+    for (int i = 0; i < 300; i++)
+    {
+        snprintf(names[i], sizeof(names[i]), "--opt-%d", i);
+        argparser_add_argument(&parser, '\0', names[i], 0, 1, nullptr, "An option");
+    }
+    CHECK(parser.arguments == arguments);
+    CHECK(parser.count == 301);
+
+    /* Past the reservation the array keeps growing. */
+    for (int i = 0; i < 200; i++)
+    {
+        snprintf(names[i], sizeof(names[i]), "--more-%d", i);
+        argparser_add_argument(&parser, '\0', names[i], 0, 1, nullptr, "Another option");
+    }
+    CHECK(parser.count == 501);
+    CHECK(argparser_get_arg(&parser, "opt-299") == nullptr);
+
+    const char *argv[] = {"prog", "--opt-299", "a", "--more-199=b", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), const_cast<char **>(argv)) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "opt-299"), "a");
+    CHECK_STR(argparser_get_arg(&parser, "more-199"), "b");
+
+    argparser_delete(&parser);
+}
+
+static void test_builder()
+{
+    ArgumentParser_t parser;
+    std::string metavar = "FILE";
+
+    test_parser(&parser);
+    argparser::Argument(&parser, 'v', "verbose").flag().help("Be loud");
+    argparser::Argument(&parser, 'o', "--output").nargs(1).dest("out").metavar(metavar).default_value("a.out").required();
+    argparser::Argument(&parser, 'n', "--num").default_value(42);
+    metavar = "CHANGED";
+
+    const char *argv[] = {"prog", "-vo", "x.bin", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), const_cast<char **>(argv)) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_arg(&parser, "verbose") != nullptr);
+    CHECK_STR(argparser_get_arg(&parser, "out"), "x.bin");
+    CHECK_STR(argparser_get_arg(&parser, "num"), "42");
+    CHECK_STR(parser.arguments[2].metavar, "FILE");
+    CHECK(parser.arguments[2].is_required);
+
+    const char *missing[] = {"prog", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(missing), const_cast<char **>(missing)) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == REQUIRED);
+
+    bool thrown = false;
+    try
+    {
+        argparser::Argument(&parser, 'v', "--other");
+    }
+    catch (const argparser::UsageError &error)
+    {
+        /* The copy thrown owns its own error, so nothing is freed twice. */
+        argparser::UsageError copy = error;
+        thrown = std::strcmp(copy.argument(), "-v") == 0 && std::strcmp(copy.what(), "conflicting option string") == 0;
+    }
+    CHECK(thrown);
+
+    argparser_delete(&parser);
+}
+
+static void test_store_into()
+{
+    ArgumentParser_t parser;
+    int port = 0;
+    bool verbose = false;
+    double ratio = 0;
+    const char *name = nullptr;
+    short level = 0;
+
+    test_parser(&parser);
+    argparser::Argument(&parser, 'p', "--port").nargs(1).store_into(port);
+    argparser::Argument(&parser, 'v', "verbose").flag().store_into(verbose);
+    argparser::Argument(&parser, 'r', "--ratio").nargs(1).default_value(0.25).store_into(ratio);
+    argparser::Argument(&parser, 'n', "--name").nargs(1).store_into(name);
+    argparser::Argument(&parser, 'l', "--level").nargs(1).store_into(level);
+
+    /* The value type follows the variable. */
+    const char *argv[] = {"prog", "-v", "-p", "99", "-n", "x", "-l", "-7", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), const_cast<char **>(argv)) == ARGPARSER_SUCCESS);
+    CHECK(port == 99 && verbose && ratio == 0.25 && level == -7);
+    CHECK_STR(name, "x");
+
+    const char *bad[] = {"prog", "-p", "many", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(bad), const_cast<char **>(bad)) == ARGPARSER_FAILURE);
+    CHECK(port == 99);
+
+    argparser_delete(&parser);
+}
+
+int main()
+{
+    test_reserve();
+    test_builder();
+    test_store_into();
+    return TEST_RESULT();
+}
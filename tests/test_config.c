@@ -0,0 +1,142 @@
+/**
+ * @file test_config.c
+ * @brief Config files as a layer between the environment and the defaults.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static const TestArgument_t config_arguments[] = {
+    {'n', "--num", 0, 1, "1", "A number", VALUE_INT, false},
+    {'l', "--log-level", 0, 1, "info", "Log level", VALUE_STRING, false},
+    {'i', "--ints", 0, 1, NULL, "Integers", VALUE_INT_LIST, false},
+    {'q', "--quoted", 0, 1, NULL, "Quoted", VALUE_STRING, false},
+    {'r', "--req", 1, 1, NULL, "Required", VALUE_STRING, false},
+    {'v', "--verbose", 0, 0, NULL, "Verbose", VALUE_STRING, false},
+    {'e', "--layered", 0, 1, NULL, "Layered", VALUE_STRING, false},
+};
+
+static void test_layers(void)
+{
+    ArgumentParser_t parser;
+    const int64_t *ints;
+    size_t count;
+    char *none[] = {"prog", NULL};
+    char *argv[] = {"prog", "-n", "7", "--layered", "cli", NULL};
+    char *no_env[] = {NULL};
+    char *env[] = {"TEST_LAYERED=env", NULL};
+
+    test_write_file("test_config_a.conf",
+                    "# comment\n"
+                    "; other\n"
+                    "num = 42\n"
+                    "unknown=5\n"
+                    "quoted = \"a \\\"b\\\" # c\"  # trailing\n"
+                    "ints: [1, 2, 3]\n"
+                    "verbose = yes\n"
+                    "layered = file\n"
+                    "[log]\n"
+                    "level = debug # why\n");
+    test_write_file("test_config_b.conf", "req='from file'\nlog.level=warn");
+
+    TEST_PARSER(&parser, config_arguments);
+    argparser_set_env(&parser, "layered", "TEST_LAYERED");
+    parser.envp = no_env;
+    CHECK(argparser_load_config(&parser, "test_config_missing.conf") == ARGPARSER_FAILURE);
+    CHECK(argparser_load_config(&parser, "test_config_a.conf") == ARGPARSER_SUCCESS);
+    CHECK(argparser_load_config(&parser, "test_config_b.conf") == ARGPARSER_SUCCESS);
+
+    /* Sections, quotes and arrays; a later file overrides an earlier one. */
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(none), none) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_int(&parser, "num") == 42);
+    CHECK_STR(argparser_get_arg(&parser, "log-level"), "warn");
+    CHECK_STR(argparser_get_arg(&parser, "quoted"), "a \"b\" # c");
+    CHECK_STR(argparser_get_arg(&parser, "req"), "from file");
+    CHECK(argparser_get_bool(&parser, "verbose"));
+    ints = argparser_get_int_list(&parser, "ints", &count);
+    CHECK(count == 3 && ints[0] == 1 && ints[2] == 3);
+    CHECK_STR(argparser_get_arg(&parser, "layered"), "file");
+
+    /* The environment beats the file, the command line beats both. */
+    parser.envp = env;
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(none), none) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "layered"), "env");
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_int(&parser, "num") == 7);
+    CHECK_STR(argparser_get_arg(&parser, "layered"), "cli");
+
+    argparser_delete(&parser);
+}
+
+static void test_invalid_and_frozen(void)
+{
+    ArgumentParser_t parser;
+    char *none[] = {"prog", NULL};
+    char *no_env[] = {NULL};
+    const char *levels[] = {"debug", "info"};
+
+    test_write_file("test_config_c.conf", "num = abc\nreq = r\nlog.level = warn\n");
+
+    TEST_PARSER(&parser, config_arguments);
+    argparser_set_env(&parser, "layered", "TEST_LAYERED");
+    parser.envp = no_env;
+
+    /* A value that does not convert is reported once the rest are loaded, and reads as the default. */
+    CHECK(argparser_load_config(&parser, "test_config_c.conf") == ARGPARSER_FAILURE);
+    CHECK(parser.error != NULL && argparser_error_type(parser.error) == PARSE);
+    CHECK_STR(argparser_error_arg(parser.error), "num");
+    CHECK(parser.arguments[0].config.data == NULL);
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(none), none) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_int(&parser, "num") == 1);
+    CHECK_STR(argparser_get_arg(&parser, "req"), "r");
+
+    /* So is one that later choices leave out. */
+    CHECK(argparser_set_choices(&parser, "log-level", levels, 2) == ARGPARSER_FAILURE);
+    CHECK_STR(argparser_error_arg(parser.error), "log-level");
+    CHECK(parser.arguments[1].config.data == NULL);
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(none), none) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "log-level"), "info");
+
+    CHECK(argparser_set_type(&parser, "log-level", VALUE_STRING) == ARGPARSER_SUCCESS);
+    CHECK(argparser_load_config(&parser, "test_config_c.conf") == ARGPARSER_FAILURE);
+    argparser_freeze(&parser);
+    CHECK(argparser_load_config(&parser, "test_config_c.conf") == ARGPARSER_FAILURE);
+    CHECK_STR(argparser_error_what(parser.error), "parser is frozen");
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(none), none) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "log-level"), "warn");
+
+    argparser_delete(&parser);
+}
+
+static void test_page_end(void)
+{
+    ArgumentParser_t parser;
+    char text[4097];
+    char *none[] = {"prog", NULL};
+    char *no_env[] = {NULL};
+
+    /* A value running to the end of a file that fills its page exactly. */
+    for (int i = 0; i < 4096; i++)
+        text[i] = i % 64 == 63 ? '\n' : '#';
+    memcpy(text + 4096 - 8, "\nnum=599", 8);
+    text[4096] = '\0';
+    test_write_file("test_config_d.conf", text);
+
+    test_parser(&parser);
+    parser.envp = no_env;
+    argparser_add_argument(&parser, 'n', "--num", 0, 1, NULL, "A number");
+    CHECK(argparser_load_config(&parser, "test_config_d.conf") == ARGPARSER_SUCCESS);
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(none), none) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "num"), "599");
+
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_layers();
+    test_invalid_and_frozen();
+    test_page_end();
+    return TEST_RESULT();
+}
@@ -0,0 +1,98 @@
+/**
+ * @file test_env.c
+ * @brief Environment variables filling the arguments not given.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static char *environment[] = {"PATH=/bin", "APP_PORT=8080", "APP_DRY_RUN=yes", "TOKEN=s3cret",
+                              "APP_NAME=envname", "APP_HELP=1", "APP_LEVEL=x", "NOEQ", NULL};
+
+static const TestArgument_t env_arguments[] = {
+    {'p', "--port", 1, 1, NULL, "Port", VALUE_INT, false},
+    {'d', "--dry-run", 0, 0, NULL, "Dry run", VALUE_STRING, false},
+    {'n', "--name", 0, 1, "def", "Name", VALUE_STRING, false},
+    {'t', "--token", 0, 1, NULL, "Token", VALUE_STRING, false},
+    {'q', "--quiet", 0, 0, NULL, "Quiet", VALUE_STRING, false},
+};
+
+static void test_fallback(void)
+{
+    ArgumentParser_t parser;
+    char *argv[] = {"prog", "--name", "cli", NULL};
+    char *port[] = {"prog", "-p", "1", NULL};
+    char *bad_flag[] = {"APP_DRY_RUN=maybe", NULL};
+    char *empty[] = {NULL};
+
+    TEST_PARSER(&parser, env_arguments);
+    parser.envp = environment;
+    CHECK(argparser_set_env(&parser, "token", "TOKEN") == ARGPARSER_SUCCESS);
+    CHECK(argparser_set_env_prefix(&parser, "APP_") == ARGPARSER_SUCCESS);
+    CHECK(argparser_set_env(&parser, "nope", "NOPE") == ARGPARSER_FAILURE);
+
+    /* The command line wins, the environment fills the rest, help is never read. */
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_int(&parser, "port") == 8080);
+    CHECK(argparser_get_bool(&parser, "dry_run"));
+    CHECK(!argparser_get_bool(&parser, "quiet"));
+    CHECK_STR(argparser_get_arg(&parser, "name"), "cli");
+
+    /* Values are views into the environment. */
+    CHECK(argparser_get_arg(&parser, "token") == environment[3] + 6);
+
+    parser.envp = bad_flag;
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(port), port) == ARGPARSER_FAILURE);
+    CHECK_STR(argparser_error_arg(parser.error), "APP_DRY_RUN");
+
+    parser.envp = empty;
+    CHECK(argparser_parse_args(&parser, 1, argv) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == REQUIRED);
+
+    argparser_delete(&parser);
+}
+
+static void test_frozen(void)
+{
+    ArgumentParser_t parser, loaded;
+    ArgumentResult_t result;
+    char *argv[] = {"prog", NULL};
+    uint64_t *blob;
+    size_t size;
+
+    TEST_PARSER(&parser, env_arguments);
+    parser.envp = environment;
+    CHECK(argparser_set_env(&parser, "token", "TOKEN") == ARGPARSER_SUCCESS);
+    CHECK(argparser_set_env_prefix(&parser, "APP_") == ARGPARSER_SUCCESS);
+    argparser_freeze(&parser);
+    CHECK(parser.env != NULL);
+
+    argparser_result_initialize(&result, NULL, 0);
+    CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(argv), argv, NULL) == NONE);
+    CHECK(argparser_result_get_int(&parser, &result, "port") == 8080);
+    CHECK_STR(argparser_result_get_arg(&parser, &result, "name"), "envname");
+    argparser_result_delete(&result);
+
+    /* Blobs carry the bindings. */
+    size = argparser_serialize(&parser, NULL, 0);
+    blob = (uint64_t *)malloc(size);
+    argparser_serialize(&parser, blob, size);
+    test_parser(&loaded);
+    loaded.envp = environment;
+    CHECK(argparser_load_blob(&loaded, blob, size) == ARGPARSER_SUCCESS);
+    CHECK(argparser_parse_args(&loaded, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_int(&loaded, "port") == 8080);
+    CHECK_STR(argparser_get_arg(&loaded, "token"), "s3cret");
+
+    argparser_delete(&loaded);
+    free(blob);
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_fallback();
+    test_frozen();
+    return TEST_RESULT();
+}
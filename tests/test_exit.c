@@ -0,0 +1,83 @@
+/**
+ * @file test_exit.c
+ * @brief Help and version ending the parse as soon as they are matched.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static int streamed;
+
+static int test_on_value(const struct Argument_t *argument, const ArgumentSlot_t *value, void *user_data)
+{
+    (void)argument;
+    (void)value;
+    (void)user_data;
+    streamed++;
+    return ARGPARSER_SUCCESS;
+}
+
+static const TestArgument_t exit_arguments[] = {
+    {'o', "--out", 1, 1, NULL, "Output", VALUE_STRING, false},
+    {'n', "--num", 0, 1, NULL, "A number", VALUE_INT, false},
+    {'s', "--stream", 0, 1, NULL, "Streamed", VALUE_STRING, false},
+};
+
+static void test_early_exit(void)
+{
+    ArgumentParser_t parser;
+    ArgumentResult_t result;
+    char *version[] = {"prog", "-s", "a", "--version", "--num", "bad", "--zzz", NULL};
+    char *help[] = {"prog", "-h", "--num", "x", NULL};
+    char *late_help[] = {"prog", "--num=bad", "-s", "a", "--help", NULL};
+    char *cluster[] = {"prog", "-vV", NULL};
+    char *short_version[] = {"prog", "-V", NULL};
+
+    TEST_PARSER(&parser, exit_arguments);
+    argparser_set_callback(&parser, "stream", test_on_value, NULL);
+    CHECK(argparser_add_version(&parser, 'V', "prog 1.2") == ARGPARSER_SUCCESS);
+    CHECK(argparser_add_version(&parser, '\0', "again") == ARGPARSER_FAILURE);
+
+    /* Nothing is stored, so no value is converted nor callback run, nor is anything required checked. */
+    streamed = 0;
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(version), version) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == VERSION);
+    CHECK(streamed == 0);
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(late_help), late_help) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == HELP);
+    CHECK(streamed == 0);
+    CHECK(parser.help != NULL);
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(help), help) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == HELP);
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(cluster), cluster) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == PARSE);
+
+    argparser_freeze(&parser);
+    argparser_result_initialize(&result, NULL, 0);
+    CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(short_version), short_version, NULL) == VERSION);
+    CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(help), help, NULL) == HELP);
+    argparser_result_delete(&result);
+
+    argparser_delete(&parser);
+}
+
+static void test_without_help(void)
+{
+    ArgumentParser_t parser;
+    char *argv[] = {"prog", "-h", NULL};
+
+    /* With add_help off, -h is an ordinary flag. */
+    test_parser(&parser);
+    parser.add_help = false;
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_bool(&parser, "help"));
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_early_exit();
+    test_without_help();
+    return TEST_RESULT();
+}
@@ -0,0 +1,123 @@
+/**
+ * @file test_freeze.cpp
+ * @brief A frozen parser shared by threads parsing into their own results.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static ArgumentParser_t parser;
+
+static const TestArgument_t frozen_arguments[] = {
+    {'n', "--num", 0, 1, nullptr, "A number", VALUE_INT, false},
+    {'v', "--verbose", 0, 0, nullptr, "Verbose", VALUE_STRING, false},
+    {'\0', "files", 0, ARGPARSER_NARGS(ZERO_OR_MORE), nullptr, "Files", VALUE_STRING, false},
+};
+
+static void test_read_only()
+{
+    /* Nothing can be added or changed once frozen. */
+    argparser_add_argument(&parser, 'x', "--late", 0, 1, nullptr, "Too late");
+    CHECK(parser.error != nullptr && argparser_error_type(parser.error) == USAGE);
+    CHECK(parser.count == 4);
+    CHECK(argparser_set_type(&parser, "num", VALUE_DOUBLE) == ARGPARSER_FAILURE);
+}
+
+static void test_frozen_builder()
+{
+    ArgumentParser_t frozen;
+    bool thrown = false;
+
+    test_parser(&frozen);
+    argparser::Argument level(&frozen, 'l', "--level");
+    argparser_freeze(&frozen);
+    const char *help = frozen.help;
+
+    /* A builder kept past the freeze throws instead of dropping the shared tables. */
+    try
+    {
+        level.help("changed").choices({"low", "high"});
+    }
+    catch (const argparser::UsageError &error)
+    {
+        thrown = std::strcmp(error.argument(), "level") == 0;
+    }
+    CHECK(thrown);
+    CHECK(frozen.help == help && frozen.trie != nullptr && frozen.error == nullptr);
+    CHECK(frozen.arguments[1].help == nullptr);
+
+    argparser_delete(&frozen);
+}
+
+static void test_threads()
+{
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+
+    for (int id = 0; id < 8; id++)
+    {
+        threads.emplace_back([id, &failures]() {
+            char buffer[1024];
+            std::string num = std::to_string(id);
+            const char *argv[] = {"prog", "-n", num.c_str(), "-v", "a", "b", "c", nullptr};
+            const char *bad[] = {"prog", "--nope", nullptr};
+            ArgumentResult_t result;
+            int count = 0;
+
+            argparser_result_initialize(&result, buffer, sizeof(buffer));
+            for (int i = 0; i < 2000; i++)
+            {
+                if (argparser_parse_into(&parser, &result, TEST_ARGC(argv), const_cast<char **>(argv)) != ARGPARSER_SUCCESS ||
+                    argparser_result_get_int(&parser, &result, "num") != id ||
+                    !argparser_result_get_bool(&parser, &result, "verbose") ||
+                    argparser_result_get_values(&parser, &result, "files", &count) == nullptr || count != 3)
+                    failures++;
+
+                if (i % 100 == 0 &&
+                    (argparser_parse_into(&parser, &result, TEST_ARGC(bad), const_cast<char **>(bad)) != ARGPARSER_FAILURE ||
+                     result.error == nullptr || argparser_error_type(result.error) != PARSE))
+                    failures++;
+            }
+            argparser_result_delete(&result);
+        });
+    }
+    for (std::thread &thread : threads)
+        thread.join();
+
+    CHECK(failures == 0);
+    CHECK(argparser_get_arg(&parser, "num") == nullptr);
+}
+
+static void test_small_buffer()
+{
+    char tiny[64];
+    ArgumentResult_t result;
+    const char *argv[] = {"prog", "a", "b", "c", "d", "e", "f", nullptr};
+    int count = 0;
+
+    /* Past its buffer the result arena falls back to the heap. */
+    argparser_result_initialize(&result, tiny, sizeof(tiny));
+    for (int i = 0; i < 3; i++)
+        CHECK(argparser_parse_into(&parser, &result, TEST_ARGC(argv), const_cast<char **>(argv)) == ARGPARSER_SUCCESS);
+    CHECK(argparser_result_get_values(&parser, &result, "files", &count) != nullptr && count == 6);
+    argparser_result_delete(&result);
+}
+
+int main()
+{
+    TEST_PARSER(&parser, frozen_arguments);
+    argparser_freeze(&parser);
+    test_read_only();
+    test_frozen_builder();
+    test_threads();
+    test_small_buffer();
+    argparser_delete(&parser);
+    return TEST_RESULT();
+}
@@ -0,0 +1,108 @@
+/**
+ * @file test_groups.c
+ * @brief Required, positional and group checks through the seen bitset.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static const char *exclusive[] = {"o3", "o140"};
+static const char *inclusive[] = {"o70", "o5", "o149"};
+static const char *one_of[] = {"o10", "o11"};
+
+/* More than 64 options, so the bitset spans several words. */
+static void test_parser_groups(ArgumentParser_t *parser)
+{
+    char name[16];
+
+    test_parser(parser);
+    for (int i = 0; i < 150; i++)
+    {
+        snprintf(name, sizeof(name), "--o%d", i);
+        argparser_add_argument(parser, '\0', name, 0, 0, NULL, "An option");
+    }
+    argparser_add_argument(parser, '\0', "--req", 1, 1, NULL, "Required");
+    argparser_add_argument(parser, '\0', "pos", 0, 2, NULL, "Two values");
+}
+
+static void test_add_group(void)
+{
+    ArgumentParser_t parser;
+    const char *unknown[] = {"nope"};
+
+    test_parser_groups(&parser);
+    CHECK(argparser_add_group(&parser, GROUP_EXCLUSIVE, false, exclusive, 2) == ARGPARSER_SUCCESS);
+    CHECK(argparser_add_group(&parser, GROUP_INCLUSIVE, false, inclusive, 3) == ARGPARSER_SUCCESS);
+    CHECK(argparser_add_group(&parser, GROUP_EXCLUSIVE, true, one_of, 2) == ARGPARSER_SUCCESS);
+    CHECK(argparser_add_group(&parser, GROUP_EXCLUSIVE, false, unknown, 1) == ARGPARSER_FAILURE);
+    argparser_delete(&parser);
+}
+
+static void test_validation(bool frozen)
+{
+    ArgumentParser_t parser;
+    ArgumentResult_t result;
+    char *good[] = {"prog", "--req", "x", "a", "b", "--o149", "--o5", "--o70", "--o11", NULL};
+    char *no_req[] = {"prog", "a", "b", "--o10", NULL};
+    char *one_pos[] = {"prog", "--req", "x", "a", "--o10", NULL};
+    char *both[] = {"prog", "--req", "x", "a", "b", "--o140", "--o3", "--o10", NULL};
+    char *partial[] = {"prog", "--req", "x", "a", "b", "--o149", "--o10", NULL};
+    char *none[] = {"prog", "--req", "x", "a", "b", NULL};
+    ArgumentError_t *error;
+
+    test_parser_groups(&parser);
+    argparser_add_group(&parser, GROUP_EXCLUSIVE, false, exclusive, 2);
+    argparser_add_group(&parser, GROUP_INCLUSIVE, false, inclusive, 3);
+    argparser_add_group(&parser, GROUP_EXCLUSIVE, true, one_of, 2);
+    argparser_result_initialize(&result, NULL, 0);
+    if (frozen)
+        argparser_freeze(&parser);
+
+#define TEST_PARSE(argv) \
+    (frozen ? argparser_parse_into(&parser, &result, TEST_ARGC(argv), argv) : argparser_parse_args(&parser, TEST_ARGC(argv), argv))
+#define TEST_ERROR() (frozen ? result.error : parser.error)
+
+    CHECK(TEST_PARSE(good) == ARGPARSER_SUCCESS);
+    CHECK(argparser_result_get_bool(&parser, frozen ? &result : &parser.result, "o70"));
+    CHECK(!argparser_result_get_bool(&parser, frozen ? &result : &parser.result, "o71"));
+
+    CHECK(TEST_PARSE(no_req) == ARGPARSER_FAILURE);
+    error = TEST_ERROR();
+    CHECK(argparser_error_type(error) == REQUIRED);
+    CHECK_STR(argparser_error_arg(error), "req");
+
+    CHECK(TEST_PARSE(one_pos) == ARGPARSER_FAILURE);
+    CHECK_STR(argparser_error_arg(TEST_ERROR()), "pos");
+
+    CHECK(TEST_PARSE(both) == ARGPARSER_FAILURE);
+    error = TEST_ERROR();
+    CHECK(argparser_error_type(error) == VALIDATION);
+    CHECK_STR(argparser_error_arg(error), "o140");
+    CHECK_STR(argparser_error_what(error), "not allowed with argument o3");
+
+    CHECK(TEST_PARSE(partial) == ARGPARSER_FAILURE);
+    error = TEST_ERROR();
+    CHECK(argparser_error_type(error) == VALIDATION);
+    CHECK_STR(argparser_error_arg(error), "o5");
+    CHECK_STR(argparser_error_what(error), "required together with argument o149");
+
+    CHECK(TEST_PARSE(none) == ARGPARSER_FAILURE);
+    error = TEST_ERROR();
+    CHECK_STR(argparser_error_arg(error), "o10");
+    CHECK_STR(argparser_error_what(error), "one of the arguments is required: o10 o11");
+
+#undef TEST_PARSE
+#undef TEST_ERROR
+
+    argparser_result_delete(&result);
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_add_group();
+    test_validation(false);
+    test_validation(true);
+    return TEST_RESULT();
+}
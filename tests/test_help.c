@@ -0,0 +1,91 @@
+/**
+ * @file test_help.c
+ * @brief Help rendered once into a cached buffer.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static const char *colors[] = {"red", "blue"};
+
+static const char *expected =
+    "A test program.\n"
+    "Usage: prog [-h] -n num [-v] [--color color] [files...]\n"
+    "         files : inputs\n"
+    "\n"
+    "Options:\n"
+    "     -h,--help : show this help message and exit\n"
+    "      -n,--num : a number [default: 7, required]\n"
+    "  -v,--verbose : be loud\n"
+    "       --color : color [allowed: <red, blue>, default: red]\n"
+    "\n"
+    "See docs.\n";
+
+static void test_parser_help(ArgumentParser_t *parser)
+{
+    argparser_initialize(parser, "prog", NULL, "A test program.", "See docs.");
+    parser->exit_on_error = false;
+    argparser_add_argument(parser, 'n', "--num", 1, 1, "7", "a number");
+    argparser_add_argument(parser, 'v', "--verbose", 0, 0, NULL, "be loud");
+    argparser_add_argument(parser, '\0', "--color", 0, 1, "red", "color");
+    argparser_set_choices(parser, "color", colors, 2);
+    argparser_add_argument(parser, '\0', "files", 0, ARGPARSER_NARGS(ZERO_OR_MORE), NULL, "inputs");
+}
+
+static void test_format(void)
+{
+    ArgumentParser_t parser;
+    char small[16];
+    char buffer[1024];
+    size_t size;
+
+    test_parser_help(&parser);
+
+    size = argparser_format_help(&parser, buffer, sizeof(buffer));
+    CHECK_STR(buffer, expected);
+    CHECK(size == strlen(expected));
+
+    /* Truncated like snprintf, still returning the full length. */
+    CHECK(argparser_format_help(&parser, small, sizeof(small)) == size);
+    CHECK(strlen(small) == sizeof(small) - 1 && strncmp(small, expected, sizeof(small) - 1) == 0);
+    CHECK(argparser_format_help(&parser, NULL, 0) == size);
+
+    argparser_delete(&parser);
+}
+
+static void test_cache(void)
+{
+    ArgumentParser_t parser;
+    char buffer[1024];
+    size_t size;
+
+    test_parser_help(&parser);
+    size = argparser_format_help(&parser, NULL, 0);
+    CHECK(parser.help != NULL);
+
+    /* Every change through the API drops the cached help. */
+    argparser_add_argument(&parser, 'q', "--quiet", 0, 0, NULL, "hush");
+    CHECK(parser.help == NULL);
+    argparser_format_help(&parser, buffer, sizeof(buffer));
+    CHECK(strlen(buffer) > size && strstr(buffer, "-q,--quiet : hush\n") != NULL);
+
+    size = strlen(buffer);
+    CHECK(argparser_set_type(&parser, "num", VALUE_INT) == ARGPARSER_SUCCESS);
+    CHECK(parser.help == NULL);
+    CHECK(argparser_format_help(&parser, NULL, 0) == size);
+
+    /* A frozen parser renders its help up front. */
+    argparser_invalidate(&parser);
+    argparser_freeze(&parser);
+    CHECK(parser.help != NULL && parser.help_size == size);
+
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_format();
+    test_cache();
+    return TEST_RESULT();
+}
@@ -0,0 +1,99 @@
+/**
+ * @file test_hot.c
+ * @brief Parsing through the packed table derived from Argument_t.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static void test_layout(void)
+{
+    /* Name pointer plus five words on 64-bit targets, two entries per cache line. */
+    CHECK(sizeof(ArgumentHot_t) <= sizeof(const char *) + 24);
+}
+
+static const TestArgument_t hot_arguments[] = {
+    {'\0', "--out", 0, 1, NULL, "Output", VALUE_STRING, false},
+    {'\0', "--outer", 0, 1, NULL, "Outer", VALUE_STRING, false},
+    {'v', "--verbose", 0, 0, NULL, "Verbose", VALUE_STRING, false},
+    {'\0', "pair", 0, 2, NULL, "Two values", VALUE_STRING, false},
+};
+
+static void test_lengths(void)
+{
+    ArgumentParser_t parser;
+    char *argv[] = {"prog", "--outer", "a", "--out=b", "x", "y", NULL};
+    char *few[] = {"prog", "x", NULL};
+    int count = 0;
+
+    TEST_PARSER(&parser, hot_arguments);
+    parser.allow_abbrev = false;
+
+    /* Names sharing a prefix only match their own length. */
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "outer"), "a");
+    CHECK_STR(argparser_get_arg(&parser, "out"), "b");
+    CHECK(argparser_get_values(&parser, "pair", &count) != NULL && count == 2);
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(few), few) == ARGPARSER_FAILURE);
+    CHECK_STR(argparser_error_arg(parser.error), "pair");
+
+    argparser_delete(&parser);
+}
+
+static void test_direct_writes(void)
+{
+    ArgumentParser_t parser;
+    char *twice[] = {"prog", "-v", "-v", "x", "y", NULL};
+    char *missing[] = {"prog", "x", "y", NULL};
+    const ArgumentHot_t *kept;
+
+    TEST_PARSER(&parser, hot_arguments);
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(twice), twice) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == EXTRA);
+    kept = parser.hot;
+
+    /* The table is kept between parses, so field writes wait for the next change through the API. */
+    parser.arguments[3].is_repeatable = true;
+    parser.arguments[1].is_required = true;
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(twice), twice) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == EXTRA);
+    CHECK(kept != NULL && parser.hot == kept);
+
+    CHECK(argparser_set_type(&parser, "pair", VALUE_STRING) == ARGPARSER_SUCCESS);
+    CHECK(parser.hot == NULL);
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(twice), twice) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == REQUIRED);
+    CHECK_STR(argparser_error_arg(parser.error), "out");
+
+    parser.arguments[1].is_required = false;
+    CHECK(argparser_set_type(&parser, "pair", VALUE_STRING) == ARGPARSER_SUCCESS);
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(twice), twice) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_int(&parser, "verbose") == 2);
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(missing), missing) == ARGPARSER_SUCCESS);
+
+    /* A frozen parser builds it once. Five arguments take one word per flag. */
+    argparser_freeze(&parser);
+    CHECK(parser.hot != NULL && parser.flags == (uint64_t *)(parser.hot + parser.count));
+    CHECK(parser.hot[3].sym == 'v' && parser.hot[3].length == 7);
+    CHECK(parser.hot[3].hash == argparser_hash("verbose", 7));
+    CHECK(parser.flags[ARGPARSER_HOT_REPEATABLE] == (uint64_t)1 << 3);
+    CHECK(parser.flags[ARGPARSER_HOT_REQUIRED] == (uint64_t)1 << 4);
+    CHECK(parser.flags[ARGPARSER_HOT_SEVERAL] == (uint64_t)1 << 4);
+    CHECK(parser.flags[ARGPARSER_HOT_EXIT] == 1);
+    CHECK(parser.hot[4].narg_min == 2 && parser.hot[4].narg_max == 2);
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(twice), twice) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_int(&parser, "verbose") == 2);
+
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_layout();
+    test_lengths();
+    test_direct_writes();
+    return TEST_RESULT();
+}
@@ -0,0 +1,85 @@
+/**
+ * @file test_index.c
+ * @brief Name and dest lookup through the hash index.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static void test_names_and_dests(void)
+{
+    ArgumentParser_t parser;
+    char *argv[] = {"prog", "--dry-run", "--input=file.txt", "-o", "out", NULL};
+
+    test_parser(&parser);
+    argparser_add_argument(&parser, '\0', "--dry-run", 0, 0, NULL, "Do nothing");
+    argparser_add_argument(&parser, 'i', "input", 0, 1, "in.txt", "Input file");
+    argparser_add_argument(&parser, 'o', "output", 0, 1, NULL, "Output file");
+    argparser_add_argument(&parser, 'q', "quiet", 0, 0, NULL, "Say nothing");
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_arg(&parser, "dry-run") != NULL);
+    CHECK(argparser_get_arg(&parser, "dry_run") != NULL);
+    CHECK_STR(argparser_get_arg(&parser, "input"), "file.txt");
+    CHECK_STR(argparser_get_arg(&parser, "output"), "out");
+    CHECK(argparser_get_arg(&parser, "quiet") == NULL);
+    CHECK(argparser_get_arg(&parser, "missing") == NULL);
+
+    argparser_delete(&parser);
+}
+
+static void test_many_arguments(void)
+{
+    ArgumentParser_t parser;
+    char names[300][16];
+    char *argv[] = {"prog", "--opt-0", "a", "--opt-150", "b", "--opt-299=c", NULL};
+
+    /* Enough arguments to grow the index several times. */
+    test_parser(&parser);
+    for (int i = 0; i < 300; i++)
+    {
+        snprintf(names[i], sizeof(names[i]), "--opt-%d", i);
+        argparser_add_argument(&parser, '\0', names[i], 0, 1, NULL, "An option");
+    }
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "opt-0"), "a");
+    CHECK_STR(argparser_get_arg(&parser, "opt_150"), "b");
+    CHECK_STR(argparser_get_arg(&parser, "opt-299"), "c");
+    CHECK(argparser_get_arg(&parser, "opt-1") == NULL);
+    CHECK(argparser_get_arg(&parser, "opt-300") == NULL);
+
+    argparser_delete(&parser);
+}
+
+static void test_errors(void)
+{
+    ArgumentParser_t parser;
+    char *unknown[] = {"prog", "--bogus", NULL};
+    char *twice[] = {"prog", "-v", "--verbose", NULL};
+
+    test_parser(&parser);
+    argparser_add_argument(&parser, 'v', "verbose", 0, 0, NULL, "Verbose");
+
+    argparser_add_argument(&parser, 'v', "verbose", 0, 0, NULL, "Again");
+    CHECK(parser.error != NULL && argparser_error_type(parser.error) == USAGE);
+    CHECK(parser.count == 2);
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(unknown), unknown) == ARGPARSER_FAILURE);
+    CHECK(parser.error != NULL);
+    CHECK_STR(argparser_error_arg(parser.error), "--bogus");
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(twice), twice) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == EXTRA);
+
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_names_and_dests();
+    test_many_arguments();
+    test_errors();
+    return TEST_RESULT();
+}
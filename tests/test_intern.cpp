@@ -0,0 +1,118 @@
+/**
+ * @file test_intern.cpp
+ * @brief Names, dests and help texts shared through the parser's string pool.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+#include <cstring>
+#include <string>
+#include <string_view>
+
+static void test_pool()
+{
+    ArgumentParser_t parser;
+    char buffer[16] = "transient";
+    uint32_t hash = 0;
+
+    test_parser(&parser);
+
+    /* Copied on first sight, the same pointer afterwards. */
+    char *first = argparser_intern(&parser, buffer, 9, false, &hash);
+    std::strcpy(buffer, "changed!!");
+    CHECK_STR(first, "transient");
+    CHECK(argparser_intern(&parser, "transient", 9, false, nullptr) == first);
+    CHECK(hash != 0);
+
+    /* Lengths are part of the key. */
+    CHECK(argparser_intern(&parser, "transient", 5, false, nullptr) != first);
+
+    /* Borrowed strings join the pool as they are. */
+    static const char borrowed[] = "borrowed";
+    CHECK(argparser_intern(&parser, borrowed, 8, true, nullptr) == borrowed);
+    CHECK(argparser_intern(&parser, "borrowed", 8, false, nullptr) == borrowed);
+
+    /* Growing the pool keeps every entry. */
+    char name[32];
+    for (int i = 0; i < 500; i++)
+    {
+        snprintf(name, sizeof(name), "key-%d", i);
+        argparser_intern(&parser, name, std::strlen(name), false, nullptr);
+    }
+    CHECK(argparser_intern(&parser, "transient", 9, false, nullptr) == first);
+    CHECK_STR(argparser_intern(&parser, "key-499", 7, false, nullptr), "key-499");
+
+    argparser_delete(&parser);
+}
+
+static void test_arguments()
+{
+    ArgumentParser_t parser;
+    char name[32];
+
+    test_parser(&parser);
+    argparser_add_argument(&parser, 'a', "--alpha", 0, 1, nullptr, "Same help");
+    argparser_add_argument(&parser, 'b', "--dry-run", 0, 1, nullptr, "Same help");
+    for (int i = 0; i < 200; i++)
+    {
+        snprintf(name, sizeof(name), "--opt-%d", i);
+        argparser_add_argument(&parser, '\0', name, 0, 1, nullptr, "Same help");
+    }
+
+    Argument_t *alpha = argparser_index_find(&parser, "alpha", 5, false);
+    Argument_t *dry_run = argparser_index_find(&parser, "dry_run", 7, false);
+    Argument_t *last = argparser_index_find(&parser, "opt_150", 7, false);
+    CHECK(alpha != nullptr && dry_run != nullptr && last != nullptr);
+    CHECK(alpha->dest == alpha->name);
+    CHECK_STR(dry_run->dest, "dry_run");
+    CHECK(alpha->help == dry_run->help && last->help == alpha->help);
+
+    /* The builder interns views, not temporaries. */
+    std::string help = "built help";
+    argparser::Argument(&parser, 'c', "--gamma").help(std::string_view(help).substr(0, 5)).dest("gam").metavar("G");
+    help[0] = 'X';
+    Argument_t *gamma = argparser_index_find(&parser, "gam", 3, false);
+    CHECK(gamma != nullptr);
+    CHECK_STR(gamma->help, "built");
+    CHECK_STR(gamma->metavar, "G");
+
+    /* A dest taken by another name still conflicts. */
+    argparser::Argument(&parser, 'd', "--delta").dest("alpha");
+    CHECK(parser.error != nullptr && argparser_error_type(parser.error) == USAGE);
+
+    const char *argv[] = {"prog", "--gamma", "1", "--dry-run=2", "--opt-199", "3", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), const_cast<char **>(argv)) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "gam"), "1");
+    CHECK_STR(argparser_get_arg(&parser, "dry_run"), "2");
+    CHECK_STR(argparser_get_arg(&parser, "opt-199"), "3");
+
+    argparser_delete(&parser);
+}
+
+static void test_parent()
+{
+    ArgumentParser_t parent, child;
+
+    test_parser(&parent);
+    argparser_add_argument(&parent, 'z', "--zeta-x", 0, 1, nullptr, "Zeta");
+
+    /* A parent's names are borrowed by the child's pool. */
+    test_parser(&child);
+    CHECK(argparser_add_parent(&child, &parent) == ARGPARSER_SUCCESS);
+    Argument_t *zeta = argparser_index_find(&child, "zeta_x", 6, false);
+    CHECK(zeta != nullptr && zeta->name == parent.arguments[1].name);
+    CHECK(argparser_intern(&child, "zeta-x", 6, false, nullptr) == parent.arguments[1].name);
+
+    argparser_delete(&child);
+    argparser_delete(&parent);
+}
+
+int main()
+{
+    test_pool();
+    test_arguments();
+    test_parent();
+    return TEST_RESULT();
+}
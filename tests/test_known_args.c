@@ -0,0 +1,112 @@
+/**
+ * @file test_known_args.c
+ * @brief Unknown tokens compacted in place for forwarding.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+#define TEST_BIG 200000
+
+static char *big[TEST_BIG + 3];
+
+static int test_build_run(ArgumentParser_t *subparser, void *user_data)
+{
+    (void)user_data;
+    argparser_add_argument(subparser, 'f', "--fast", 0, 0, NULL, "Fast");
+    return ARGPARSER_SUCCESS;
+}
+
+static const TestArgument_t wrap_arguments[] = {
+    {'v', "--verbose", 0, 0, NULL, "Verbose", VALUE_STRING, false},
+    {'o', "--out", 0, 1, NULL, "Output", VALUE_STRING, false},
+    {'\0', "cmd", 1, 1, NULL, "Command", VALUE_STRING, false},
+};
+
+static void test_compaction(void)
+{
+    ArgumentParser_t parser;
+    char *argv[] = {"prog", "--x", "gcc", "-c", "-v", "--out=o", "foo.c", "-Wall", "--", "-v", "bar", NULL};
+    char *strict[] = {"prog", "gcc", "--x", NULL};
+    char *known_first[] = {"prog", "-vz", "gcc", NULL};
+    char *unknown_first[] = {"prog", "-zv", "gcc", NULL};
+
+    TEST_PARSER(&parser, wrap_arguments);
+
+    /* Leftovers keep their order right after argv[0], "--" included. */
+    CHECK(argparser_parse_known_args(&parser, TEST_ARGC(argv), argv) == 8);
+    CHECK_STR(argv[0], "prog");
+    CHECK_STR(argv[1], "--x");
+    CHECK_STR(argv[2], "-c");
+    CHECK_STR(argv[3], "foo.c");
+    CHECK_STR(argv[4], "-Wall");
+    CHECK_STR(argv[5], "--");
+    CHECK_STR(argv[6], "-v");
+    CHECK_STR(argv[7], "bar");
+    CHECK(argv[8] == NULL);
+    CHECK_STR(argparser_get_arg(&parser, "cmd"), "gcc");
+    CHECK(argparser_get_bool(&parser, "verbose"));
+    CHECK_STR(argparser_get_arg(&parser, "out"), "o");
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(strict), strict) == ARGPARSER_FAILURE);
+
+    /* A cluster is kept whole only when it starts with an unknown symbol. */
+    CHECK(argparser_parse_known_args(&parser, TEST_ARGC(known_first), known_first) == -1);
+    CHECK(argparser_parse_known_args(&parser, TEST_ARGC(unknown_first), unknown_first) == 2);
+    CHECK_STR(unknown_first[1], "-zv");
+    CHECK(unknown_first[2] == NULL);
+
+    argparser_delete(&parser);
+}
+
+static void test_large(void)
+{
+    ArgumentParser_t parser;
+
+    TEST_PARSER(&parser, wrap_arguments);
+    big[0] = "prog";
+    big[1] = "tool";
+    for (int i = 2; i < TEST_BIG + 2; i++)
+        big[i] = i % 3 ? "--passthru" : "arg";
+    big[TEST_BIG + 2] = NULL;
+
+    CHECK(argparser_parse_known_args(&parser, TEST_BIG + 2, big) == TEST_BIG + 1);
+    CHECK(big[TEST_BIG + 1] == NULL);
+    CHECK_STR(big[1], "--passthru");
+    CHECK_STR(big[2], "arg");
+
+    argparser_delete(&parser);
+}
+
+static void test_subcommand(void)
+{
+    ArgumentParser_t parser;
+    char *argv[] = {"prog", "--a", "-v", "run", "--b", "-f", "c", NULL};
+    char *unknown[] = {"prog", "nope", NULL};
+
+    test_parser(&parser);
+    argparser_add_argument(&parser, 'v', "--verbose", 0, 0, NULL, "Verbose");
+    argparser_add_subcommand(&parser, "run", "Run it", test_build_run, NULL);
+
+    /* The subcommand's leftovers follow the parent's. */
+    CHECK(argparser_parse_known_args(&parser, TEST_ARGC(argv), argv) == 4);
+    CHECK_STR(argv[1], "--a");
+    CHECK_STR(argv[2], "--b");
+    CHECK_STR(argv[3], "c");
+    CHECK(argv[4] == NULL);
+    CHECK(argparser_get_bool(argparser_get_subparser(&parser, "run"), "fast"));
+
+    CHECK(argparser_parse_known_args(&parser, TEST_ARGC(unknown), unknown) == -1);
+    CHECK_STR(argparser_error_what(parser.error), "invalid subcommand");
+
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_compaction();
+    test_large();
+    test_subcommand();
+    return TEST_RESULT();
+}
@@ -0,0 +1,111 @@
+/**
+ * @file test_lazy.c
+ * @brief Typed values converted on first read with lazy_conversion.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static const char *colors[] = {"red", "green"};
+
+static const TestArgument_t lazy_arguments[] = {
+    {'n', "--num", 0, 1, "3", "A number", VALUE_INT, false},
+    {'c', "--color", 0, 1, NULL, "A color", VALUE_STRING, false},
+    {'d', "--dbl", 0, 1, NULL, "A double", VALUE_DOUBLE, false},
+    {'i', "--ints", 0, 1, "7,8", "Integers", VALUE_INT_LIST, true},
+};
+
+static void test_first_read(void)
+{
+    ArgumentParser_t parser;
+    int64_t num = 0;
+    char *argv[] = {"prog", "-n", "12", "-c", "green", "-d", "oops", NULL};
+    char *bound[] = {"prog", "-n", "x", NULL};
+
+    TEST_PARSER(&parser, lazy_arguments);
+    parser.lazy_conversion = true;
+    argparser_set_choices(&parser, "color", colors, 2);
+    argparser_store_into(&parser, "num", &num, sizeof(num));
+
+    /* Bound values convert for their store, the rest wait for a getter. */
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(num == 12);
+    CHECK(!parser.result.values[1].is_pending);
+    CHECK(parser.result.values[2].is_pending && parser.result.values[3].is_pending);
+    CHECK(argparser_get_enum(&parser, "color") == 1);
+    CHECK(!parser.result.values[2].is_pending);
+
+    /* A rejected value reads as the default and is reported, its text is kept. */
+    CHECK(parser.error == NULL);
+    CHECK(argparser_get_double(&parser, "dbl") == 0.0);
+    CHECK(parser.result.values[3].is_invalid);
+    CHECK(parser.error != NULL && argparser_error_type(parser.error) == PARSE);
+    CHECK_STR(argparser_error_arg(parser.error), "dbl");
+    CHECK_STR(argparser_get_arg(&parser, "dbl"), "oops");
+    CHECK(!parser.result.values[1].is_invalid);
+
+    /* A bound value is converted before the parse returns, so it fails the parse. */
+    num = 5;
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(bound), bound) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == PARSE);
+    CHECK_STR(argparser_error_arg(parser.error), "num");
+    CHECK(num == 5);
+
+    parser.lazy_conversion = false;
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == PARSE);
+
+    argparser_delete(&parser);
+}
+
+static void test_lists(void)
+{
+    ArgumentParser_t parser;
+    ArgumentResult_t result;
+    const int64_t *ints;
+    size_t count;
+    char *argv[] = {"prog", "-i", "5,6", "-i", "7", NULL};
+    char *bad[] = {"prog", "-i", "1,x", NULL};
+
+    TEST_PARSER(&parser, lazy_arguments);
+    parser.lazy_conversion = true;
+    argparser_set_choices(&parser, "color", colors, 2);
+
+    /* Repeated options still extend one list. */
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    ints = argparser_get_int_list(&parser, "ints", &count);
+    CHECK(count == 3 && ints[0] == 5 && ints[2] == 7);
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(bad), bad) == ARGPARSER_SUCCESS);
+    ints = argparser_get_int_list(&parser, "ints", &count);
+    CHECK(count == 2 && ints[0] == 7 && ints[1] == 8);
+
+    /* Frozen parsers convert into each result. */
+    argparser_freeze(&parser);
+    argparser_result_initialize(&result, NULL, 0);
+    CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(argv), argv, NULL) == NONE);
+    CHECK(result.values[4].is_pending);
+    ints = argparser_result_get_int_list(&parser, &result, "ints", &count);
+    CHECK(count == 3 && ints[1] == 6);
+    CHECK(argparser_result_get_int(&parser, &result, "num") == 3);
+    CHECK(result.error == NULL);
+
+    /* Their rejected values are reported in the result. */
+    CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(bad), bad, NULL) == NONE);
+    ints = argparser_result_get_int_list(&parser, &result, "ints", &count);
+    CHECK(count == 2 && ints[0] == 7);
+    CHECK(result.values[4].is_invalid);
+    CHECK(result.error != NULL && argparser_error_type(result.error) == PARSE);
+    CHECK_STR(argparser_error_arg(result.error), "ints");
+    argparser_result_delete(&result);
+
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_first_read();
+    test_lists();
+    return TEST_RESULT();
+}
@@ -0,0 +1,172 @@
+/**
+ * @file test_lists.c
+ * @brief Separated int and double lists converted into contiguous arrays.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static char test_buffer[40000];
+
+static const TestArgument_t list_arguments[] = {
+    {'i', "--ints", 0, 1, "7,8", "Integers", VALUE_INT_LIST, true},
+    {'d', "--dbl", 0, 1, NULL, "Doubles", VALUE_DOUBLE_LIST, true},
+    {'s', "--sep", 0, 1, NULL, "Colon separated", VALUE_INT_LIST, true},
+};
+
+static void test_values(void)
+{
+    ArgumentParser_t parser;
+    const int64_t *ints;
+    const double *doubles;
+    size_t count;
+    char *none[] = {"prog", NULL};
+    char *argv[] = {"prog",
+                    "--ints", "1,-2,+3,12345678,123456789,-9223372036854775808,0",
+                    "--dbl=1.5,-0.25,3,1e10,.5,2.,123456789.12345678,0.1",
+                    "-s", "4:5",
+                    "--ints", "99",
+                    NULL};
+
+    TEST_PARSER(&parser, list_arguments);
+
+    /* Separators strtod could read as part of a number are refused. */
+    CHECK(argparser_set_separator(&parser, "sep", '.') == ARGPARSER_FAILURE);
+    CHECK(argparser_set_separator(&parser, "sep", ':') == ARGPARSER_SUCCESS);
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(none), none) == ARGPARSER_SUCCESS);
+    ints = argparser_get_int_list(&parser, "ints", &count);
+    CHECK(count == 2 && ints[0] == 7 && ints[1] == 8);
+    CHECK(argparser_get_double_list(&parser, "dbl", &count) == NULL && count == 0);
+
+    /* Repeated occurrences append. */
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    ints = argparser_get_int_list(&parser, "ints", &count);
+    CHECK(count == 8);
+    CHECK(ints[0] == 1 && ints[1] == -2 && ints[2] == 3 && ints[3] == 12345678);
+    CHECK(ints[4] == 123456789 && ints[5] == INT64_MIN && ints[6] == 0 && ints[7] == 99);
+    doubles = argparser_get_double_list(&parser, "dbl", &count);
+    CHECK(count == 8);
+    CHECK(doubles[0] == 1.5 && doubles[1] == -0.25 && doubles[2] == 3 && doubles[3] == 1e10);
+    CHECK(doubles[4] == 0.5 && doubles[5] == 2.0 && doubles[6] == 123456789.12345678 && doubles[7] == 0.1);
+    ints = argparser_get_int_list(&parser, "sep", &count);
+    CHECK(count == 2 && ints[0] == 4 && ints[1] == 5);
+
+    argparser_delete(&parser);
+}
+
+static void test_invalid(void)
+{
+    ArgumentParser_t parser;
+    const char *ints[] = {"1,,2", "1,", "", "1,x", "1,2a", "12345678901234567890", "1.5", "1, 2"};
+    const char *doubles[] = {"1.5,abc", "1,1e400", "1,inf", ",1"};
+
+    TEST_PARSER(&parser, list_arguments);
+    for (size_t i = 0; i < sizeof(ints) / sizeof(ints[0]); i++)
+    {
+        char *argv[] = {"prog", "--ints", (char *)ints[i], NULL};
+        CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_FAILURE);
+        CHECK(argparser_error_type(parser.error) == PARSE);
+    }
+    for (size_t i = 0; i < sizeof(doubles) / sizeof(doubles[0]); i++)
+    {
+        char *argv[] = {"prog", "--dbl", (char *)doubles[i], NULL};
+        CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_FAILURE);
+    }
+    CHECK_STR(argparser_error_arg(parser.error), "dbl");
+    argparser_delete(&parser);
+}
+
+/* Long lists over every digit count the fast paths take, against strtoll and strtod. */
+static void test_random(void)
+{
+    static int64_t ints[3000];
+    static double doubles[3000];
+    ArgumentParser_t parser;
+    const int64_t *got_ints;
+    const double *got_doubles;
+    char *int_argv[] = {"prog", "--ints", test_buffer, NULL};
+    char *double_argv[] = {"prog", "--dbl", test_buffer, NULL};
+    size_t count;
+
+    TEST_PARSER(&parser, list_arguments);
+    srand(3);
+    for (int round = 0; round < 30; round++)
+    {
+        int size = 1 + rand() % 2000;
+        int64_t limit = round % 3 == 0 ? 100 : round % 3 == 1 ? 100000000 : INT64_MAX;
+        size_t length = 0;
+
+        for (int i = 0; i < size; i++)
+        {
+            int64_t value = (((int64_t)rand() << 20) ^ rand()) % limit;
+            ints[i] = rand() & 1 ? -value : value;
+            length += (size_t)sprintf(test_buffer + length, "%s%lld", i ? "," : "", (long long)ints[i]);
+        }
+        CHECK(argparser_parse_args(&parser, TEST_ARGC(int_argv), int_argv) == ARGPARSER_SUCCESS);
+        got_ints = argparser_get_int_list(&parser, "ints", &count);
+        CHECK(count == (size_t)size && memcmp(got_ints, ints, count * sizeof(int64_t)) == 0);
+
+        length = 0;
+        for (int i = 0; i < size; i++)
+        {
+            char text[64];
+
+            switch (rand() % 4)
+            {
+            case 0:
+                snprintf(text, sizeof(text), "%d.%d", rand() % 1000, rand() % 1000);
+                break;
+            case 1:
+                snprintf(text, sizeof(text), "%.17g", (double)rand() / 7.0);
+                break;
+            case 2:
+                snprintf(text, sizeof(text), "-%d.%08d", rand() % 100000000, rand() % 100000000);
+                break;
+            default:
+                snprintf(text, sizeof(text), "%d", rand());
+                break;
+            }
+            doubles[i] = strtod(text, NULL);
+            length += (size_t)sprintf(test_buffer + length, "%s%s", i ? "," : "", text);
+        }
+        CHECK(argparser_parse_args(&parser, TEST_ARGC(double_argv), double_argv) == ARGPARSER_SUCCESS);
+        got_doubles = argparser_get_double_list(&parser, "dbl", &count);
+        CHECK(count == (size_t)size);
+        for (size_t i = 0; i < count && i < (size_t)size; i++)
+            CHECK(got_doubles[i] == doubles[i]);
+    }
+    argparser_delete(&parser);
+}
+
+static void test_result(void)
+{
+    ArgumentParser_t parser;
+    ArgumentResult_t result;
+    char stack[256];
+    const int64_t *ints;
+    size_t count;
+    char *argv[] = {"prog", "-i", "5,6", "-i", "7", NULL};
+
+    TEST_PARSER(&parser, list_arguments);
+    parser.zero_copy = true;
+    argparser_freeze(&parser);
+    argparser_result_initialize(&result, stack, sizeof(stack));
+
+    CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(argv), argv, NULL) == NONE);
+    ints = argparser_result_get_int_list(&parser, &result, "ints", &count);
+    CHECK(count == 3 && ints[0] == 5 && ints[1] == 6 && ints[2] == 7);
+
+    argparser_result_delete(&result);
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_values();
+    test_invalid();
+    test_random();
+    test_result();
+    return TEST_RESULT();
+}
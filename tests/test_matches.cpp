@@ -0,0 +1,83 @@
+/**
+ * @file test_matches.cpp
+ * @brief The C++20 argparser::matches() generator over argparser_next().
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+#include <cstring>
+#include <string>
+
+#if ARGPARSER_HAS_COROUTINES
+
+static void test_matches()
+{
+    ArgumentParser_t parser;
+    const char *argv[] = {"prog", "--mode", "fast", "-n", "5", nullptr};
+    const char *bogus[] = {"prog", "--bogus", nullptr};
+    char **args = const_cast<char **>(argv);
+    std::string seen;
+    int count = 0;
+    bool thrown = false;
+
+    test_parser(&parser);
+    argparser::Argument(&parser, 'm', "--mode");
+    argparser::Argument(&parser, 'n', "--num").type(VALUE_INT).required();
+
+    for (const ArgumentMatch_t &match : argparser::matches(&parser, TEST_ARGC(argv), args))
+        seen += std::string(match.argument->name) + "=" + (match.value.data ? match.value.data : "") + ";";
+    CHECK(seen == "mode=fast;num=5;");
+
+    /* Leaving the loop stops the parse. */
+    for (const ArgumentMatch_t &match : argparser::matches(&parser, TEST_ARGC(argv), args))
+    {
+        count++;
+        if (std::strcmp(match.argument->name, "mode") == 0)
+            break;
+    }
+    CHECK(count == 1);
+
+    try
+    {
+        for (const ArgumentMatch_t &match : argparser::matches(&parser, 3, args))
+            (void)match;
+    }
+    catch (const argparser::RequiredError &)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    thrown = false;
+    try
+    {
+        for (const ArgumentMatch_t &match : argparser::matches(&parser, TEST_ARGC(bogus), const_cast<char **>(bogus)))
+            (void)match;
+    }
+    catch (const argparser::ParseError &error)
+    {
+        thrown = std::strcmp(error.argument(), "--bogus") == 0;
+    }
+    CHECK(thrown);
+
+    auto range = argparser::matches(&parser, TEST_ARGC(argv), args);
+    auto it = range.begin();
+    CHECK(it != range.end() && it->value.size == 4);
+    ++it;
+    ++it;
+    CHECK(it == range.end());
+
+    argparser_delete(&parser);
+}
+
+#endif
+
+int main()
+{
+#if ARGPARSER_HAS_COROUTINES
+    test_matches();
+#endif
+    return TEST_RESULT();
+}
@@ -0,0 +1,168 @@
+/**
+ * @file test_next.c
+ * @brief Matches yielded one at a time by argparser_next().
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static const char *stream[8] = {"-v", "--num", "4", "pos", "--list", "a", "b", NULL};
+static int stream_at;
+
+/* Hands out every token through the same buffer. */
+static const char *test_source(void *user_data)
+{
+    char *buffer = (char *)user_data;
+
+    if (stream[stream_at] == NULL)
+        return NULL;
+    strcpy(buffer, stream[stream_at++]);
+    return buffer;
+}
+
+static int test_build_run(ArgumentParser_t *subparser, void *user_data)
+{
+    (void)user_data;
+    argparser_add_argument(subparser, 's', "--speed", 0, 1, NULL, "Speed");
+    argparser_set_type(subparser, "speed", VALUE_INT);
+    return ARGPARSER_SUCCESS;
+}
+
+static const TestArgument_t next_arguments[] = {
+    {'v', "--verbose", 0, 0, NULL, "Verbose", VALUE_STRING, false},
+    {'n', "--num", 0, 1, NULL, "A number", VALUE_INT, false},
+    {'l', "--list", 0, ARGPARSER_NARGS(ONE_OR_MORE), NULL, "A list", VALUE_STRING, false},
+    {'o', "--opt", 0, ARGPARSER_NARGS(OPTIONAL), NULL, "Optional value", VALUE_STRING, true},
+    {'\0', "file", 1, 1, NULL, "A file", VALUE_STRING, false},
+};
+
+static void test_matches(void)
+{
+    ArgumentParser_t parser;
+    ArgumentMatch_t match;
+    char *argv[] = {"prog", "-vn7", "f.txt", "--list", "x", "y", "z", "-o", "--opt=q", NULL};
+    const char *expected[][2] = {{"verbose", NULL}, {"num", "7"}, {"file", "f.txt"}, {"list", "x"},
+                                 {"list", "y"}, {"list", "z"}, {"opt", NULL}, {"opt", "q"}};
+
+    TEST_PARSER(&parser, next_arguments);
+
+    /* One match per stored value or flag, in command line order. */
+    CHECK(argparser_begin(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    for (int i = 0; i < 8; i++)
+    {
+        CHECK(argparser_next(&parser, &match) == 1);
+        CHECK_STR(match.argument->name, expected[i][0]);
+        CHECK_STR(match.value.data, expected[i][1]);
+    }
+    CHECK(argparser_next(&parser, &match) == 0);
+    CHECK(argparser_next(&parser, &match) == 0);
+    CHECK(argparser_get_int(&parser, "num") == 7);
+
+    argparser_delete(&parser);
+}
+
+static void test_stop_and_fail(void)
+{
+    ArgumentParser_t parser;
+    ArgumentMatch_t match;
+    char *argv[] = {"prog", "-v", "f.txt", NULL};
+    char *missing[] = {"prog", "-v", NULL};
+    char *unknown[] = {"prog", "--nope", NULL};
+
+    TEST_PARSER(&parser, next_arguments);
+
+    /* Beginning again drops an iteration stopped early. */
+    CHECK(argparser_begin(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(argparser_next(&parser, &match) == 1);
+
+    /* Required arguments are checked once the end is reached. */
+    CHECK(argparser_begin(&parser, TEST_ARGC(missing), missing) == ARGPARSER_SUCCESS);
+    CHECK(argparser_next(&parser, &match) == 1);
+    CHECK(argparser_next(&parser, &match) == -1);
+    CHECK(argparser_error_type(parser.error) == REQUIRED);
+
+    CHECK(argparser_begin(&parser, TEST_ARGC(unknown), unknown) == ARGPARSER_SUCCESS);
+    CHECK(argparser_next(&parser, &match) == -1);
+    CHECK(argparser_error_type(parser.error) == PARSE);
+
+    /* A successful parse leaves no error behind from the failed one. */
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(parser.error == NULL);
+
+    argparser_delete(&parser);
+}
+
+static void test_source_tokens(void)
+{
+    ArgumentParser_t parser;
+    ArgumentMatch_t match;
+    const ArgumentView_t *values;
+    char buffer[64];
+    int matched = 0;
+    int count;
+
+    TEST_PARSER(&parser, next_arguments);
+    stream_at = 0;
+    CHECK(argparser_begin_source(&parser, test_source, buffer) == ARGPARSER_SUCCESS);
+    while (argparser_next(&parser, &match) > 0)
+        matched++;
+
+    /* Values outlive the buffer they were read from. */
+    CHECK(matched == 5);
+    CHECK(argparser_get_int(&parser, "num") == 4);
+    CHECK_STR(argparser_get_arg(&parser, "file"), "pos");
+    values = argparser_get_values(&parser, "list", &count);
+    CHECK(count == 2);
+    CHECK_STR(values[0].data, "a");
+    CHECK_STR(values[1].data, "b");
+
+    argparser_delete(&parser);
+}
+
+static void test_subcommand(void)
+{
+    static const char *run[] = {"run", "--speed", "9", NULL};
+    ArgumentParser_t parser;
+    ArgumentMatch_t match;
+    char buffer[64];
+    char *argv[] = {"prog", "-v", "run", "--speed", "3", NULL};
+    char *bad[] = {"prog", "run", "--bad", NULL};
+
+    test_parser(&parser);
+    argparser_add_argument(&parser, 'v', "--verbose", 0, 0, NULL, "Verbose");
+    argparser_add_subcommand(&parser, "run", "Run", test_build_run, NULL);
+
+    /* The iteration carries on in the subparser. */
+    CHECK(argparser_begin(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(argparser_next(&parser, &match) == 1);
+    CHECK_STR(match.argument->name, "verbose");
+    CHECK(argparser_next(&parser, &match) == 1);
+    CHECK_STR(match.argument->name, "speed");
+    CHECK_STR(match.value.data, "3");
+    CHECK(argparser_next(&parser, &match) == 0);
+    CHECK_STR(argparser_get_subcommand(&parser), "run");
+    CHECK(argparser_get_int(argparser_get_subparser(&parser, "run"), "speed") == 3);
+
+    CHECK(argparser_begin(&parser, TEST_ARGC(bad), bad) == ARGPARSER_SUCCESS);
+    CHECK(argparser_next(&parser, &match) == -1);
+    CHECK(argparser_error_type(parser.error) == PARSE);
+
+    memcpy(stream, run, sizeof(run));
+    stream_at = 0;
+    CHECK(argparser_begin_source(&parser, test_source, buffer) == ARGPARSER_SUCCESS);
+    CHECK(argparser_next(&parser, &match) == 1);
+    CHECK_STR(match.value.data, "9");
+    CHECK(argparser_next(&parser, &match) == 0);
+
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_matches();
+    test_stop_and_fail();
+    test_source_tokens();
+    test_subcommand();
+    return TEST_RESULT();
+}
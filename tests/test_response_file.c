@@ -0,0 +1,100 @@
+/**
+ * @file test_response_file.c
+ * @brief @file tokens expanded from response files.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static const TestArgument_t file_arguments[] = {
+    {'n', "--name", 0, 1, NULL, "A name", VALUE_STRING, false},
+    {'v', "--verbose", 0, 0, NULL, "Verbose", VALUE_STRING, false},
+    {'c', "--count", 0, 1, NULL, "A count", VALUE_STRING, false},
+    {'\0', "items", 0, ARGPARSER_NARGS(ONE_OR_MORE), NULL, "Items", VALUE_STRING, false},
+};
+
+static void test_expansion(bool zero_copy)
+{
+    ArgumentParser_t parser;
+    char *argv[] = {"prog", "first", "@test_response_file.txt", "tail", NULL};
+    const ArgumentView_t *items;
+    int count;
+
+    test_write_file("test_response_file.txt",
+                    "  --name \"John \\\"Q\\\" Doe\"\n-v 'single quoted'\t--count=3\n@literal last");
+    TEST_PARSER(&parser, file_arguments);
+    parser.zero_copy = zero_copy;
+    parser.fromfile_prefix_char = '@';
+
+    /* The mapping is released and mapped again by every parse. */
+    for (int run = 0; run < 3; run++)
+    {
+        CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+        CHECK_STR(argparser_get_arg(&parser, "name"), "John \"Q\" Doe");
+        CHECK(argparser_get_bool(&parser, "verbose"));
+        CHECK_STR(argparser_get_arg(&parser, "count"), "3");
+
+        items = argparser_get_values(&parser, "items", &count);
+        CHECK(count == 5);
+        if (count == 5)
+        {
+            CHECK(items[0].size == 5 && memcmp(items[0].data, "first", 5) == 0);
+            CHECK(items[1].size == 13 && memcmp(items[1].data, "single quoted", 13) == 0);
+            CHECK(items[2].size == 8 && memcmp(items[2].data, "@literal", 8) == 0);
+            CHECK(items[3].size == 4 && memcmp(items[3].data, "last", 4) == 0);
+            CHECK(items[4].size == 4 && memcmp(items[4].data, "tail", 4) == 0);
+        }
+    }
+
+    argparser_delete(&parser);
+}
+
+static void test_file_end(void)
+{
+    ArgumentParser_t parser;
+    char text[4097];
+    char *argv[] = {"prog", "@test_response_page.txt", NULL};
+
+    /* A page-sized file ending in a token leaves no byte for its NUL. */
+    memset(text, ' ', sizeof(text) - 1);
+    memcpy(text + sizeof(text) - 5, "abcd", 4);
+    text[sizeof(text) - 1] = '\0';
+    test_write_file("test_response_page.txt", text);
+
+    TEST_PARSER(&parser, file_arguments);
+    parser.zero_copy = true;
+    parser.fromfile_prefix_char = '@';
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "items"), "abcd");
+    argparser_delete(&parser);
+}
+
+static void test_errors(void)
+{
+    ArgumentParser_t parser;
+    char *missing[] = {"prog", "@test_response_missing.txt", NULL};
+    char *plain[] = {"prog", "@test_response_file.txt", NULL};
+
+    TEST_PARSER(&parser, file_arguments);
+    parser.fromfile_prefix_char = '@';
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(missing), missing) == ARGPARSER_FAILURE);
+    CHECK(parser.error != NULL);
+
+    /* Without a prefix character the token is an ordinary value. */
+    parser.fromfile_prefix_char = '\0';
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(plain), plain) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "items"), "@test_response_file.txt");
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_expansion(false);
+    test_expansion(true);
+    test_file_end();
+    test_errors();
+    remove("test_response_file.txt");
+    remove("test_response_page.txt");
+    return TEST_RESULT();
+}
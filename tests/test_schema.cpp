@@ -0,0 +1,125 @@
+/**
+ * @file test_schema.cpp
+ * @brief Compile-time schemas installed into a parser.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static constexpr argparser::Option options[] = {
+    {'o', "--output", 1, false, "a.out", "Output file"},
+    {'v', "--verbose", 0, false, nullptr, "Verbose output"},
+    {'\0', "--dry-run", 0, false, nullptr, "Do nothing", "dry_run"},
+    {'\0', "files", ARGPARSER_NARGS(ZERO_OR_MORE), false, nullptr, "Input files"},
+    {'r', "--required", 1, true, nullptr, "A required option"},
+};
+using Cli = argparser::Schema<options>;
+
+static constexpr argparser::Option positional[] = {
+    {'\0', "input", 1, false, nullptr, "Input file"},
+};
+using Positional = argparser::Schema<positional>;
+
+static_assert(Cli::count == 6, "the help flag comes first");
+static_assert(Cli::index_of("help") == 0, "help is at slot 0");
+static_assert(Cli::index_of("output") == 1, "names resolve at compile time");
+static_assert(Cli::index_of("dry-run") == 3 && Cli::index_of("dry_run") == 3, "dests resolve too");
+static_assert(Cli::index_of("missing") == -1, "unknown names are -1");
+static_assert(Cli::is_required(5) && !Cli::is_required(1), "the required bitmask is static");
+
+static void test_install()
+{
+    ArgumentParser_t parser;
+
+    test_parser(&parser);
+    Cli::install(&parser);
+    CHECK(parser.count == Cli::count);
+
+    const char *argv[] = {"prog", "-vo", "x.bin", "--dry-run", "f1", "f2", "-r", "1", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), const_cast<char **>(argv)) == ARGPARSER_SUCCESS);
+    CHECK_STR(Cli::get(&parser, Cli::index_of("output")), "x.bin");
+    CHECK(Cli::get(&parser, Cli::index_of("verbose")) != nullptr);
+    CHECK(argparser_get_arg(&parser, "dry_run") != nullptr);
+    CHECK_STR(argparser_get_arg(&parser, "required"), "1");
+
+    int count = 0;
+    const ArgumentView_t *files = argparser_get_values(&parser, "files", &count);
+    CHECK(count == 2 && files[1].size == 2);
+
+#if ARGPARSER_CPP_VERSION >= 202002L
+    CHECK_STR(Cli::get<"output">(&parser), "x.bin");
+#endif
+
+    const char *defaults[] = {"prog", "-r", "1", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(defaults), const_cast<char **>(defaults)) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "output"), "a.out");
+    CHECK(argparser_get_arg(&parser, "verbose") == nullptr);
+
+    const char *missing[] = {"prog", "-v", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(missing), const_cast<char **>(missing)) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == REQUIRED);
+
+    argparser_delete(&parser);
+}
+
+static void test_later_registrations()
+{
+    ArgumentParser_t parser;
+
+    test_parser(&parser);
+    Cli::install(&parser);
+
+    /* Registering after install grows a private copy of the borrowed index. */
+    argparser_add_argument(&parser, 'z', "--zed", 0, 1, nullptr, "Added later");
+    CHECK(parser.count == Cli::count + 1);
+
+    argparser_add_argument(&parser, 'o', "--other", 0, 1, nullptr, "Conflicts with -o");
+    CHECK(parser.error != nullptr && argparser_error_type(parser.error) == USAGE);
+    CHECK(parser.count == Cli::count + 1);
+
+    const char *argv[] = {"prog", "-z", "q", "-r1", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), const_cast<char **>(argv)) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "zed"), "q");
+    CHECK_STR(argparser_get_arg(&parser, "output"), "a.out");
+    CHECK_STR(argparser_get_arg(&parser, "required"), "1");
+
+    argparser_delete(&parser);
+}
+
+static void test_help()
+{
+    ArgumentParser_t parser;
+
+    test_parser(&parser);
+    Positional::install(&parser);
+
+    /* The schema's help flag ends the parse before the required positional is checked. */
+    const char *long_help[] = {"prog", "--help", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(long_help), const_cast<char **>(long_help)) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == HELP);
+
+    const char *short_help[] = {"prog", "-h", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(short_help), const_cast<char **>(short_help)) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == HELP);
+
+    const char *missing[] = {"prog", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(missing), const_cast<char **>(missing)) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == REQUIRED);
+
+    argparser_freeze(&parser);
+    ArgumentResult_t result;
+    argparser_result_initialize(&result, nullptr, 0);
+    CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(long_help), const_cast<char **>(long_help), nullptr) == HELP);
+    argparser_result_delete(&result);
+
+    argparser_delete(&parser);
+}
+
+int main()
+{
+    test_install();
+    test_later_registrations();
+    test_help();
+    return TEST_RESULT();
+}
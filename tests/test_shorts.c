@@ -0,0 +1,78 @@
+/**
+ * @file test_shorts.c
+ * @brief Short options and bundles through the symbol table.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static const TestArgument_t short_arguments[] = {
+    {'v', "verbose", 0, 0, NULL, "Verbose", VALUE_STRING, false},
+    {'x', "extra", 0, 0, NULL, "Extra", VALUE_STRING, false},
+    {'i', "input", 0, 1, NULL, "Input file", VALUE_STRING, false},
+};
+
+static void test_bundles(void)
+{
+    ArgumentParser_t parser;
+    char *equals[] = {"prog", "-vxi=file.txt", NULL};
+    char *attached[] = {"prog", "-xifile.txt", NULL};
+    char *separate[] = {"prog", "-vi", "file.txt", NULL};
+    char *flags[] = {"prog", "-xv", NULL};
+
+    TEST_PARSER(&parser, short_arguments);
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(equals), equals) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_arg(&parser, "verbose") != NULL);
+    CHECK(argparser_get_arg(&parser, "extra") != NULL);
+    CHECK_STR(argparser_get_arg(&parser, "input"), "file.txt");
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(attached), attached) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_arg(&parser, "verbose") == NULL);
+    CHECK_STR(argparser_get_arg(&parser, "input"), "file.txt");
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(separate), separate) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_arg(&parser, "extra") == NULL);
+    CHECK_STR(argparser_get_arg(&parser, "input"), "file.txt");
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(flags), flags) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_arg(&parser, "verbose") != NULL);
+    CHECK(argparser_get_arg(&parser, "input") == NULL);
+
+    argparser_delete(&parser);
+}
+
+static void test_errors(void)
+{
+    ArgumentParser_t parser;
+    char *unknown[] = {"prog", "-vz", NULL};
+    char *missing[] = {"prog", "-vi", NULL};
+
+    TEST_PARSER(&parser, short_arguments);
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(unknown), unknown) == ARGPARSER_FAILURE);
+    CHECK(parser.error != NULL);
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(missing), missing) == ARGPARSER_FAILURE);
+    CHECK_STR(argparser_error_arg(parser.error), "input");
+
+    /* A taken symbol or the prefix character cannot be registered. */
+    argparser_add_argument(&parser, 'v', "version", 0, 0, NULL, "Taken");
+    CHECK(parser.error != NULL && argparser_error_type(parser.error) == USAGE);
+    CHECK(argparser_get_arg(&parser, "version") == NULL);
+    CHECK(parser.count == 4);
+
+    argparser_add_argument(&parser, '-', "dash", 0, 0, NULL, "Prefix");
+    CHECK(argparser_error_type(parser.error) == USAGE);
+    CHECK(parser.count == 4);
+
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_bundles();
+    test_errors();
+    return TEST_RESULT();
+}
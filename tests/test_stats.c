@@ -0,0 +1,81 @@
+/**
+ * @file test_stats.c
+ * @brief Parse counters and timings behind ARGPARSER_ENABLE_STATS.
+ */
+
+#define ARGPARSER_ENABLE_STATS
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+typedef struct TestStats_t
+{
+    int calls;
+    ArgumentStats_t last;
+} TestStats_t;
+
+static void test_on_stats(const ArgumentParser_t *parser, const ArgumentStats_t *stats, void *user_data)
+{
+    TestStats_t *seen = (TestStats_t *)user_data;
+
+    (void)parser;
+    seen->calls++;
+    seen->last = *stats;
+}
+
+static void test_counters(void)
+{
+    ArgumentParser_t parser;
+    TestStats_t seen = {0};
+    ArgumentResult_t result;
+    char *argv[] = {"prog", "--count", "3", "-v", "--count=4", "file", NULL};
+    char *bad[] = {"prog", "--count", "x", NULL};
+    char *abbrev[] = {"prog", "--cou=5", "file", NULL};
+
+    test_parser(&parser);
+    parser.on_stats = test_on_stats;
+    parser.on_stats_data = &seen;
+    argparser_add_argument(&parser, 'c', "--count", 0, 1, NULL, "A count");
+    argparser_add_argument(&parser, 'v', "--verbose", 0, 0, NULL, "Verbose");
+    argparser_add_argument(&parser, '\0', "file", 0, 1, NULL, "A file");
+    CHECK(argparser_set_type(&parser, "count", VALUE_INT) == ARGPARSER_SUCCESS);
+    parser.arguments[1].is_repeatable = true;
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(seen.calls == 1);
+    CHECK(seen.last.tokens == 5);
+    /* The long options are looked up once more by the scan for --help. */
+    CHECK(seen.last.lookups == 4);
+    CHECK(seen.last.probes >= 2);
+    CHECK(seen.last.conversions >= 2);
+    CHECK(seen.last.trie_builds == 0);
+    CHECK(seen.last.total_ns >= seen.last.validate_ns);
+    CHECK(memcmp(&seen.last, &parser.result.stats, sizeof(ArgumentStats_t)) == 0);
+
+    /* Failed parses report too. */
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(bad), bad) == ARGPARSER_FAILURE);
+    CHECK(seen.calls == 2);
+    CHECK(seen.last.tokens == 2);
+
+    /*
+     * A fresh result counts its own arena. Changing an argument drops the
+     * trie, so parse_into builds one in the result for the abbreviation.
+     */
+    CHECK(argparser_set_type(&parser, "count", VALUE_INT) == ARGPARSER_SUCCESS);
+    argparser_result_initialize(&result, NULL, 0);
+    CHECK(argparser_parse_into(&parser, &result, TEST_ARGC(abbrev), abbrev) == ARGPARSER_SUCCESS);
+    CHECK(seen.calls == 3);
+    CHECK(result.stats.allocations == 1);
+    CHECK(result.stats.bytes > 0);
+    CHECK(result.stats.trie_builds == 1);
+    CHECK(argparser_result_get_int(&parser, &result, "count") == 5);
+    argparser_result_delete(&result);
+
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_counters();
+    return TEST_RESULT();
+}
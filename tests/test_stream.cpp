@@ -0,0 +1,89 @@
+/**
+ * @file test_stream.cpp
+ * @brief Values streamed to callbacks instead of being collected.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+static int add_number(const Argument_t *argument, const ArgumentSlot_t *value, void *user_data)
+{
+    (void)argument;
+    *(int64_t *)user_data += value->i;
+    return value->i < 1000 ? ARGPARSER_SUCCESS : ARGPARSER_FAILURE;
+}
+
+static void test_callback(bool zero_copy)
+{
+    ArgumentParser_t parser;
+    int64_t sum = 0;
+    int count = 0;
+
+    test_parser(&parser);
+    parser.zero_copy = zero_copy;
+    argparser_add_argument(&parser, '\0', "nums", 1, ARGPARSER_NARGS(ONE_OR_MORE), nullptr, "Numbers");
+    CHECK(argparser_set_type(&parser, "nums", VALUE_INT) == ARGPARSER_SUCCESS);
+    CHECK(argparser_set_callback(&parser, "nums", add_number, &sum) == ARGPARSER_SUCCESS);
+    CHECK(argparser_set_callback(&parser, "missing", add_number, &sum) == ARGPARSER_FAILURE);
+
+    const char *argv[] = {"prog", "1", "2", "3", "4", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), const_cast<char **>(argv)) == ARGPARSER_SUCCESS);
+    CHECK(sum == 10);
+
+    /* Only the first value is kept. */
+    const ArgumentView_t *values = argparser_get_values(&parser, "nums", &count);
+    CHECK(count == 1 && values[0].size == 1 && values[0].data[0] == '1');
+    CHECK(argparser_get_int(&parser, "nums") == 1);
+
+    sum = 0;
+    const char *stop[] = {"prog", "1", "5000", "7", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(stop), const_cast<char **>(stop)) == ARGPARSER_FAILURE);
+    CHECK(argparser_error_type(parser.error) == PARSE);
+    CHECK(sum == 5001);
+
+    /* Values are converted before they are streamed. */
+    sum = 0;
+    const char *invalid[] = {"prog", "1", "x", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(invalid), const_cast<char **>(invalid)) == ARGPARSER_FAILURE);
+    CHECK(sum == 1);
+
+    argparser_delete(&parser);
+}
+
+static void test_on_value()
+{
+    ArgumentParser_t parser;
+    std::vector<std::string> seen;
+    auto alive = std::make_shared<int>(0);
+
+    test_parser(&parser);
+    argparser::Argument(&parser, '\0', "files").nargs(ZERO_OR_MORE).on_value(
+        [&seen, alive](const ArgumentSlot_t &value) { seen.emplace_back(value.str.data, value.str.size); });
+    argparser::Argument(&parser, 'l', "--limit").type(VALUE_INT).on_value(
+        [alive](const ArgumentSlot_t &value) { return value.i >= 0; });
+    CHECK(alive.use_count() == 3);
+
+    const char *argv[] = {"prog", "-l", "5", "a", "bb", "ccc", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), const_cast<char **>(argv)) == ARGPARSER_SUCCESS);
+    CHECK(seen.size() == 3 && seen[0] == "a" && seen[1] == "bb" && seen[2] == "ccc");
+
+    const char *negative[] = {"prog", "-l", "-1", nullptr};
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(negative), const_cast<char **>(negative)) == ARGPARSER_FAILURE);
+
+    /* The parser owns the callables and destroys them with itself. */
+    argparser_delete(&parser);
+    CHECK(alive.use_count() == 1);
+}
+
+int main()
+{
+    test_callback(false);
+    test_callback(true);
+    test_on_value();
+    return TEST_RESULT();
+}
@@ -0,0 +1,209 @@
+/**
+ * @file test_subcommands.c
+ * @brief Subcommands built on first use or at freeze, and arguments shared from a parent.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static int built;
+
+static int test_build(ArgumentParser_t *subparser, void *user_data)
+{
+    built++;
+    if (argparser_add_parent(subparser, (const ArgumentParser_t *)user_data) != ARGPARSER_SUCCESS)
+        return ARGPARSER_FAILURE;
+    argparser_add_argument(subparser, 'j', "--jobs", 0, 1, "1", "Jobs");
+    argparser_add_argument(subparser, '\0', "target", 0, 1, NULL, "Target");
+    return ARGPARSER_SUCCESS;
+}
+
+static int test_build_failing(ArgumentParser_t *subparser, void *user_data)
+{
+    (void)subparser;
+    (void)user_data;
+    return ARGPARSER_FAILURE;
+}
+
+static void test_parser_tool(ArgumentParser_t *root, ArgumentParser_t *common)
+{
+    char name[16];
+
+    argparser_initialize(common, "common", NULL, NULL, NULL);
+    argparser_add_argument(common, 'v', "--verbose", 0, 0, NULL, "Verbose");
+    argparser_add_argument(common, 'c', "--config", 0, 1, "cfg.toml", "Config file");
+
+    argparser_initialize(root, "tool", NULL, "A tool.", NULL);
+    root->exit_on_error = false;
+    argparser_add_argument(root, 'q', "--quiet", 0, 0, NULL, "Quiet");
+    for (int i = 0; i < 150; i++)
+    {
+        snprintf(name, sizeof(name), "cmd%d", i);
+        CHECK(argparser_add_subcommand(root, name, "A command", test_build, common) == ARGPARSER_SUCCESS);
+    }
+    CHECK(argparser_add_subcommand(root, "cmd3", NULL, test_build, common) == ARGPARSER_FAILURE);
+    CHECK(argparser_add_subcommand(root, "broken", NULL, test_build_failing, NULL) == ARGPARSER_SUCCESS);
+}
+
+static void test_lazy(void)
+{
+    ArgumentParser_t root, common;
+    ArgumentParser_t *subparser;
+    char *argv[] = {"tool", "-q", "cmd77", "-v", "--jobs", "4", "--config=x", "all", NULL};
+    char *unknown[] = {"tool", "nope", NULL};
+    char *bad_option[] = {"tool", "cmd5", "--bogus", NULL};
+    char *no_command[] = {"tool", "-q", NULL};
+    char *broken[] = {"tool", "broken", NULL};
+
+    built = 0;
+    test_parser_tool(&root, &common);
+    CHECK(built == 0);
+
+    /* Only the chosen subparser is built. */
+    CHECK(argparser_parse_args(&root, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(built == 1);
+    CHECK_STR(argparser_get_subcommand(&root), "cmd77");
+    CHECK(argparser_get_bool(&root, "quiet"));
+    subparser = argparser_get_subparser(&root, "cmd77");
+    CHECK(subparser != NULL && built == 1);
+    CHECK_STR(subparser->program, "tool cmd77");
+    CHECK(argparser_get_bool(subparser, "verbose"));
+    CHECK_STR(argparser_get_arg(subparser, "jobs"), "4");
+    CHECK_STR(argparser_get_arg(subparser, "config"), "x");
+    CHECK_STR(argparser_get_arg(subparser, "target"), "all");
+
+    /* Parent arguments are shared, not copied. */
+    CHECK(subparser->arguments[1].name == common.arguments[1].name);
+
+    CHECK(argparser_parse_args(&root, TEST_ARGC(unknown), unknown) == ARGPARSER_FAILURE);
+    CHECK_STR(argparser_error_what(root.error), "invalid subcommand");
+
+    /* Subparser errors are moved to the root. */
+    CHECK(argparser_parse_args(&root, TEST_ARGC(bad_option), bad_option) == ARGPARSER_FAILURE);
+    CHECK(built == 2);
+    CHECK_STR(argparser_error_arg(root.error), "--bogus");
+
+    CHECK(argparser_parse_args(&root, TEST_ARGC(no_command), no_command) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_subcommand(&root) == NULL);
+    CHECK(argparser_parse_args(&root, TEST_ARGC(broken), broken) == ARGPARSER_FAILURE);
+
+    argparser_delete(&root);
+    argparser_delete(&common);
+}
+
+static void test_frozen(void)
+{
+    ArgumentParser_t root, common;
+    ArgumentResult_t result;
+    char buffer[8192];
+    char *argv[] = {"tool", "-q", "cmd77", "-v", "all", NULL};
+    char *broken[] = {"tool", "broken", NULL};
+    ArgumentParser_t *subparser;
+
+    built = 0;
+    test_parser_tool(&root, &common);
+
+    /* Freezing builds and freezes the whole tree, so sharing it writes nothing. */
+    argparser_freeze(&root);
+    CHECK(built == 150);
+    CHECK(root.error != NULL);
+    CHECK_STR(argparser_error_arg(root.error), "broken");
+    subparser = argparser_get_subparser(&root, "cmd77");
+    CHECK(subparser != NULL && subparser->is_frozen && subparser->hot != NULL);
+    CHECK(argparser_get_subparser(&root, "broken") == NULL);
+    CHECK(built == 150);
+
+    /* try_parse stops at the subcommand. */
+    argparser_result_initialize(&result, NULL, 0);
+    CHECK(argparser_try_parse(&root, &result, TEST_ARGC(argv), argv, NULL) == NONE);
+    CHECK(result.subcommand_index == 2);
+    CHECK_STR(argparser_result_get_subcommand(&root, &result), "cmd77");
+    argparser_result_delete(&result);
+
+    CHECK(argparser_parse_args(&root, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_bool(subparser, "verbose"));
+    CHECK(argparser_parse_args(&root, TEST_ARGC(broken), broken) == ARGPARSER_FAILURE);
+    CHECK(built == 150);
+
+    argparser_format_help(&root, buffer, sizeof(buffer));
+    CHECK(strstr(buffer, "Commands:") != NULL);
+    CHECK(strstr(buffer, "cmd149 : A command") != NULL);
+    CHECK(strstr(buffer, "<command> ...") != NULL);
+
+    argparser_delete(&root);
+    argparser_delete(&common);
+}
+
+static void test_parent_config(void)
+{
+    ArgumentParser_t root, common;
+    ArgumentParser_t *subparser;
+    char *parent[] = {"common", NULL};
+    char *argv[] = {"tool", "cmd1", "all", NULL};
+
+    test_parser_tool(&root, &common);
+    common.exit_on_error = false;
+    test_write_file("test_subcommands.conf", "config = from-parent\n");
+    CHECK(argparser_load_config(&common, "test_subcommands.conf") == ARGPARSER_SUCCESS);
+    CHECK(argparser_parse_args(&common, TEST_ARGC(parent), parent) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&common, "config"), "from-parent");
+
+    /* The descriptors are copied without the config value of the parent. */
+    CHECK(argparser_parse_args(&root, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    subparser = argparser_get_subparser(&root, "cmd1");
+    CHECK(subparser != NULL);
+    CHECK(subparser->arguments[2].config.data == NULL && !subparser->arguments[2].is_config_converted);
+    CHECK_STR(argparser_get_arg(subparser, "config"), "cfg.toml");
+
+    argparser_delete(&root);
+    argparser_delete(&common);
+    remove("test_subcommands.conf");
+}
+
+static void test_complete(void)
+{
+    ArgumentParser_t root, common;
+    const char *names[8];
+    char *command[] = {"tool", "cmd1", NULL};
+    char *option[] = {"tool", "cmd12", "--j", NULL};
+    char *after_options[] = {"tool", "-q", "cmd12", "-v", "", NULL};
+
+    built = 0;
+    test_parser_tool(&root, &common);
+
+    /* Subcommands follow the options, in the order added. */
+    CHECK(argparser_complete(&root, "cmd1", names, 8) == 61);
+    CHECK_STR(names[0], "cmd1");
+    CHECK_STR(names[1], "cmd10");
+    CHECK(argparser_complete(&root, "b", names, 8) == 1);
+    CHECK_STR(names[0], "broken");
+    CHECK(argparser_complete(&root, "--b", names, 8) == 0);
+    CHECK(argparser_complete(&root, "", names, 8) == 153);
+    CHECK_STR(names[0], "help");
+    CHECK_STR(names[1], "quiet");
+    CHECK_STR(names[2], "cmd0");
+    CHECK(built == 0);
+
+    /* The last word completes in the subcommand the earlier ones reach. */
+    CHECK(argparser_complete_args(&root, TEST_ARGC(command), command, names, 8) == 61);
+    CHECK(built == 0);
+    CHECK(argparser_complete_args(&root, TEST_ARGC(option), option, names, 8) == 1);
+    CHECK_STR(names[0], "jobs");
+    CHECK(built == 1);
+    CHECK(argparser_complete_args(&root, TEST_ARGC(after_options), after_options, names, 8) == 4);
+    CHECK_STR(names[0], "config");
+    CHECK(built == 1);
+
+    argparser_delete(&root);
+    argparser_delete(&common);
+}
+
+int main(void)
+{
+    test_lazy();
+    test_frozen();
+    test_parent_config();
+    test_complete();
+    return TEST_RESULT();
+}
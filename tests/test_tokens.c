@@ -0,0 +1,104 @@
+/**
+ * @file test_tokens.c
+ * @brief Token scanning and classification ahead of the resolver.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static void test_scan(void)
+{
+    char *buffer = (char *)malloc(256);
+    size_t length, equals;
+
+    /* Random lengths at every alignment, checked against strlen and strchr. */
+    srand(1);
+    for (int i = 0; i < 20000; i++)
+    {
+        int size = rand() % 100;
+        char *text = buffer + rand() % 64;
+        const char *eq;
+
+        for (int j = 0; j < size; j++)
+            text[j] = rand() % 8 == 0 ? '=' : (char)('a' + rand() % 26);
+        text[size] = '\0';
+
+        argparser_scan_token(text, &length, &equals);
+        eq = strchr(text, '=');
+        CHECK(length == (size_t)size);
+        CHECK(equals == (eq != NULL ? (size_t)(eq - text) : (size_t)size));
+    }
+
+    /* A token that ends with the allocation. */
+    memset(buffer, 'x', 255);
+    buffer[255] = '\0';
+    argparser_scan_token(buffer, &length, &equals);
+    CHECK(length == 255 && equals == 255);
+
+    free(buffer);
+}
+
+static void test_classify(void)
+{
+    ArgumentParser_t parser;
+    ArgumentToken_t token;
+
+    test_parser(&parser);
+
+    argparser_classify(&parser, "--name=value=x", &token);
+    CHECK(token.kind == ARGPARSER_TOKEN_LONG && token.is_option);
+    CHECK(token.length == 14 && token.equals == 6);
+
+    argparser_classify(&parser, "-abc", &token);
+    CHECK(token.kind == ARGPARSER_TOKEN_SHORT && token.equals == 4);
+
+    argparser_classify(&parser, "--", &token);
+    CHECK(token.kind == ARGPARSER_TOKEN_SEPARATOR);
+
+    /* Negative numbers and a lone '-' are values. */
+    argparser_classify(&parser, "-5", &token);
+    CHECK(token.kind == ARGPARSER_TOKEN_POSITIONAL && !token.is_option);
+    argparser_classify(&parser, "-.5", &token);
+    CHECK(token.kind == ARGPARSER_TOKEN_POSITIONAL);
+    argparser_classify(&parser, "-", &token);
+    CHECK(token.kind == ARGPARSER_TOKEN_POSITIONAL);
+
+    argparser_delete(&parser);
+}
+
+static void test_parse(void)
+{
+    ArgumentParser_t parser;
+    char long_value[300];
+    char long_option[320];
+    char *argv[] = {"prog", "--name=a=b", "-n", "-5", "--", "--name", NULL};
+    char *long_argv[] = {"prog", long_option, "x", NULL};
+
+    test_parser(&parser);
+    argparser_add_argument(&parser, '\0', "--name", 0, 1, NULL, "A name");
+    argparser_add_argument(&parser, 'n', "--num", 0, 1, NULL, "A number");
+    argparser_add_argument(&parser, '\0', "rest", 0, 1, NULL, "The rest");
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "name"), "a=b");
+    CHECK_STR(argparser_get_arg(&parser, "num"), "-5");
+    CHECK_STR(argparser_get_arg(&parser, "rest"), "--name");
+
+    /* Tokens longer than any block. */
+    memset(long_value, 'v', sizeof(long_value) - 1);
+    long_value[sizeof(long_value) - 1] = '\0';
+    snprintf(long_option, sizeof(long_option), "--name=%s", long_value);
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(long_argv), long_argv) == ARGPARSER_SUCCESS);
+    CHECK_STR(argparser_get_arg(&parser, "name"), long_value);
+
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_scan();
+    test_classify();
+    test_parse();
+    return TEST_RESULT();
+}
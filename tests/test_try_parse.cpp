@@ -0,0 +1,108 @@
+/**
+ * @file test_try_parse.cpp
+ * @brief The allocation-free, non-throwing error path.
+ */
+
+#include <cstdlib>
+
+static std::size_t test_allocs;
+
+static void *test_malloc(std::size_t size)
+{
+    test_allocs++;
+    return std::malloc(size);
+}
+
+#define ARGPARSER_MALLOC(size) test_malloc(size)
+#define ARGPARSER_FREE(ptr) std::free(ptr)
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+#include <cstring>
+#include <string>
+#include <utility>
+
+static const TestArgument_t try_arguments[] = {
+    {'n', "--num", 1, 1, nullptr, "A number", VALUE_INT, false},
+    {'v', "--verbose", 0, 0, nullptr, "Verbose", VALUE_STRING, false},
+};
+
+static void test_error_buffer()
+{
+    ArgumentParser_t parser;
+    char buffer[2048];
+    ArgumentResult_t result;
+    ArgumentErrorBuffer_t error;
+    const char *good[] = {"prog", "-n", "42", "-v", nullptr};
+    const char *bad[] = {"prog", "-n", "x", nullptr};
+    const char *missing[] = {"prog", nullptr};
+    const char *help[] = {"prog", "-h", nullptr};
+    std::string long_name = "--" + std::string(4 * ARGPARSER_ERROR_BUFFER_SIZE, 'x');
+    const char *unknown[] = {"prog", long_name.c_str(), nullptr};
+
+    TEST_PARSER(&parser, try_arguments);
+    argparser_freeze(&parser);
+    argparser_result_initialize(&result, buffer, sizeof(buffer));
+
+    CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(good), const_cast<char **>(good), &error) == NONE);
+    CHECK(argparser_result_get_int(&parser, &result, "num") == 42);
+
+    /* Once the result arena is warm, rejected command lines allocate nothing. */
+    std::size_t allocs = test_allocs;
+    for (int i = 0; i < 100; i++)
+    {
+        CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(bad), const_cast<char **>(bad), &error) == PARSE);
+        CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(missing), const_cast<char **>(missing), &error) == REQUIRED);
+        CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(help), const_cast<char **>(help), nullptr) == HELP);
+    }
+    CHECK(test_allocs == allocs);
+    CHECK(result.error == nullptr);
+    CHECK_STR(error.error.argument, "num");
+
+    /* A long argument is truncated to fit the buffer. */
+    CHECK(argparser_try_parse(&parser, &result, TEST_ARGC(unknown), const_cast<char **>(unknown), &error) == PARSE);
+    CHECK(std::strlen(error.error.argument) < ARGPARSER_ERROR_BUFFER_SIZE);
+    CHECK(std::strncmp(error.error.argument, "--xxxx", 6) == 0);
+    CHECK(test_allocs == allocs);
+
+    argparser_result_delete(&result);
+    argparser_delete(&parser);
+}
+
+static void test_parse_result()
+{
+    ArgumentParser_t parser;
+    const char *good[] = {"prog", "-n", "42", "-v", nullptr};
+    const char *bad[] = {"prog", "-n", "x", nullptr};
+
+    TEST_PARSER(&parser, try_arguments);
+    argparser_freeze(&parser);
+
+    argparser::ParseResult parsed = argparser::try_parse(&parser, TEST_ARGC(good), const_cast<char **>(good));
+    CHECK(parsed.has_value() && parsed);
+    CHECK(parsed.error() == NONE);
+    CHECK(parsed.get<int>("num") == 42);
+    CHECK(parsed.get<bool>("verbose"));
+    CHECK(parsed.get<std::string>("num") == "42");
+
+    argparser::ParseResult moved = std::move(parsed);
+    CHECK(moved.get<long>("num") == 42);
+
+    argparser::ParseResult failed = argparser::try_parse(&parser, TEST_ARGC(bad), const_cast<char **>(bad));
+    CHECK(!failed && failed.error() == PARSE);
+    CHECK_STR(failed.argument(), "num");
+    CHECK_STR(failed.what(), "invalid int value 'x'");
+
+    argparser::ParseResult failed_moved = std::move(failed);
+    CHECK(failed_moved.error() == PARSE);
+
+    argparser_delete(&parser);
+}
+
+int main()
+{
+    test_error_buffer();
+    test_parse_result();
+    return TEST_RESULT();
+}
@@ -0,0 +1,106 @@
+/**
+ * @file test_typed.c
+ * @brief Values converted to ints, doubles, bools and enums while parsing.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static const char *colors[] = {"red", "blue", "green"};
+
+static const TestArgument_t typed_arguments[] = {
+    {'n', "--num", 0, 1, "7", "A number", VALUE_INT, false},
+    {'a', "--alpha", 0, 1, "0.5", "A ratio", VALUE_DOUBLE, false},
+    {'b', "--bool", 0, 1, NULL, "A switch", VALUE_BOOL, false},
+    {'c', "--color", 0, 1, "blue", "A color", VALUE_STRING, false},
+    {'v', "--verbose", 0, 0, NULL, "Verbose", VALUE_STRING, false},
+};
+
+static void test_conversions(void)
+{
+    ArgumentParser_t parser;
+    char *values[] = {"prog", "-n", "-42", "--alpha=1.25e2", "-b", "yes", "--color", "green", "-v", NULL};
+    char *defaults[] = {"prog", NULL};
+    char *limits[] = {"prog", "-n", "-9223372036854775808", "-a", "-.5", "-b", "0", NULL};
+    char *subnormal[] = {"prog", "-a", "4.9e-324", NULL};
+    char *small[] = {"prog", "-a", "-1e-310", NULL};
+
+    TEST_PARSER(&parser, typed_arguments);
+    CHECK(argparser_set_choices(&parser, "color", colors, 3) == ARGPARSER_SUCCESS);
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(values), values) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_int(&parser, "num") == -42);
+    CHECK(argparser_get_double(&parser, "alpha") == 125.0);
+    CHECK(argparser_get_bool(&parser, "bool"));
+    CHECK(argparser_get_enum(&parser, "color") == 2);
+    CHECK(argparser_get_bool(&parser, "verbose"));
+    CHECK_STR(argparser_get_arg(&parser, "num"), "-42");
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(defaults), defaults) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_int(&parser, "num") == 7);
+    CHECK(argparser_get_double(&parser, "alpha") == 0.5);
+    CHECK(!argparser_get_bool(&parser, "bool"));
+    CHECK(argparser_get_enum(&parser, "color") == 1);
+    CHECK(!argparser_get_bool(&parser, "verbose"));
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(limits), limits) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_int(&parser, "num") == INT64_MIN);
+    CHECK(argparser_get_double(&parser, "alpha") == -0.5);
+    CHECK(!argparser_get_bool(&parser, "bool"));
+
+    /* Subnormals only lose precision, they are not out of range. */
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(subnormal), subnormal) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_double(&parser, "alpha") > 0.0 && argparser_get_double(&parser, "alpha") < 1e-323);
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(small), small) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_double(&parser, "alpha") < -9e-311 && argparser_get_double(&parser, "alpha") > -2e-310);
+
+    argparser_delete(&parser);
+}
+
+static void test_invalid(void)
+{
+    static const char *const ints[] = {"", "abc", "1.5", " 3", "3 ", "+", "9223372036854775808", "-9223372036854775809"};
+    static const char *const doubles[] = {"", "abc", " 3", "3 ", "1e", "1e400", "-1e400", "inf", "-inf", "nan", "1.5x",
+                                          "0x10", "0x1p3", "-0X1"};
+    static const char *const bools[] = {"", "maybe", "True", "2"};
+    ArgumentParser_t parser;
+    char *bad_color[] = {"prog", "-c", "pink", NULL};
+
+    TEST_PARSER(&parser, typed_arguments);
+    CHECK(argparser_set_choices(&parser, "color", colors, 3) == ARGPARSER_SUCCESS);
+
+    for (size_t i = 0; i < sizeof(ints) / sizeof(ints[0]); i++)
+    {
+        char *argv[] = {"prog", "--num", (char *)ints[i], NULL};
+        CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_FAILURE);
+        CHECK(argparser_error_type(parser.error) == PARSE);
+    }
+    for (size_t i = 0; i < sizeof(doubles) / sizeof(doubles[0]); i++)
+    {
+        char *argv[] = {"prog", "--alpha", (char *)doubles[i], NULL};
+        CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_FAILURE);
+    }
+    for (size_t i = 0; i < sizeof(bools) / sizeof(bools[0]); i++)
+    {
+        char *argv[] = {"prog", "--bool", (char *)bools[i], NULL};
+        CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_FAILURE);
+    }
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(bad_color), bad_color) == ARGPARSER_FAILURE);
+    CHECK_STR(argparser_error_what(parser.error), "invalid choice value 'pink'");
+
+    /* A default that does not convert is refused with the type. */
+    argparser_add_argument(&parser, 'w', "--width", 0, 1, "wide", "A width");
+    CHECK(argparser_set_type(&parser, "width", VALUE_INT) == ARGPARSER_FAILURE);
+    CHECK(argparser_set_type(&parser, "missing", VALUE_INT) == ARGPARSER_FAILURE);
+
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_conversions();
+    test_invalid();
+    return TEST_RESULT();
+}
@@ -0,0 +1,75 @@
+/**
+ * @file test_zero_copy.c
+ * @brief Values stored as views into argv or as copies.
+ */
+
+#define ARGPARSER_IMPLEMENTATION
+#include "argparser.h"
+#include "test.h"
+
+static const TestArgument_t file_arguments[] = {
+    {'i', "input", 0, 1, NULL, "Input file", VALUE_STRING, false},
+    {'\0', "files", 0, ARGPARSER_NARGS(ZERO_OR_MORE), NULL, "Files", VALUE_STRING, false},
+};
+
+static void test_views(void)
+{
+    ArgumentParser_t parser;
+    char input[] = "--input=file.txt";
+    char attached[] = "-ifile.txt";
+    char a[] = "a", bb[] = "bb";
+    char *argv[] = {"prog", input, a, bb, NULL};
+    char *short_argv[] = {"prog", attached, NULL};
+    const ArgumentView_t *values;
+    int count;
+
+    TEST_PARSER(&parser, file_arguments);
+    parser.zero_copy = true;
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_arg(&parser, "input") == input + 8);
+    values = argparser_get_values(&parser, "files", &count);
+    CHECK(count == 2);
+    CHECK(values[0].data == a && values[0].size == 1);
+    CHECK(values[1].data == bb && values[1].size == 2);
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(short_argv), short_argv) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_arg(&parser, "input") == attached + 2);
+    values = argparser_get_values(&parser, "files", &count);
+    CHECK(count == 0);
+
+    argparser_delete(&parser);
+}
+
+static void test_copies(void)
+{
+    ArgumentParser_t parser;
+    char input[] = "--input=file.txt";
+    char a[] = "a";
+    char *argv[] = {"prog", input, a, NULL};
+    const ArgumentView_t *values;
+    int count;
+
+    TEST_PARSER(&parser, file_arguments);
+
+    CHECK(argparser_parse_args(&parser, TEST_ARGC(argv), argv) == ARGPARSER_SUCCESS);
+    CHECK(argparser_get_arg(&parser, "input") != input + 8);
+
+    /* Copies outlive changes to argv. */
+    memset(input, 'x', sizeof(input) - 1);
+    a[0] = 'z';
+    CHECK_STR(argparser_get_arg(&parser, "input"), "file.txt");
+    values = argparser_get_values(&parser, "files", &count);
+    CHECK(count == 1 && values[0].size == 1 && values[0].data[0] == 'a');
+
+    CHECK(argparser_get_values(&parser, "missing", &count) == NULL);
+
+    argparser_delete(&parser);
+}
+
+int main(void)
+{
+    test_views();
+    test_copies();
+    return TEST_RESULT();
+}